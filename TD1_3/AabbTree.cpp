@@ -0,0 +1,308 @@
+﻿#include "AabbTree.h"
+
+DynamicAabbTree::DynamicAabbTree() {
+    nodes_.reserve(64);
+}
+
+int DynamicAabbTree::AllocateNode() {
+    // フリーリストが空ならノードを追加
+    if (freeList_ == kNullNode) {
+        nodes_.emplace_back();
+        nodes_.back().height = 0;
+        return static_cast<int>(nodes_.size()) - 1;
+    }
+
+    const int nodeId = freeList_;
+    Node& node = nodes_[nodeId];
+    freeList_ = node.next;
+    node.parent = kNullNode;
+    node.next = kNullNode;
+    node.child1 = kNullNode;
+    node.child2 = kNullNode;
+    node.userData = nullptr;
+    node.height = 0;
+    return nodeId;
+}
+
+void DynamicAabbTree::FreeNode(int nodeId) {
+    Node& node = nodes_[nodeId];
+    node.next = freeList_;
+    node.height = -1;
+    node.userData = nullptr;
+    freeList_ = nodeId;
+}
+
+int DynamicAabbTree::CreateProxy(const Aabb2D& aabb, void* userData) {
+    const int proxyId = AllocateNode();
+
+    // 余白を付けて登録（少し動いただけでは再挿入しない）
+    Node& node = nodes_[proxyId];
+    node.aabb.min = { aabb.min.x - kAabbMargin, aabb.min.y - kAabbMargin };
+    node.aabb.max = { aabb.max.x + kAabbMargin, aabb.max.y + kAabbMargin };
+    node.userData = userData;
+    node.height = 0;
+
+    InsertLeaf(proxyId);
+    ++proxyCount_;
+    return proxyId;
+}
+
+void DynamicAabbTree::DestroyProxy(int proxyId) {
+    assert(0 <= proxyId && proxyId < static_cast<int>(nodes_.size()));
+    assert(nodes_[proxyId].IsLeaf());
+
+    RemoveLeaf(proxyId);
+    FreeNode(proxyId);
+    --proxyCount_;
+}
+
+bool DynamicAabbTree::MoveProxy(int proxyId, const Aabb2D& aabb, const Vector2& displacement) {
+    assert(0 <= proxyId && proxyId < static_cast<int>(nodes_.size()));
+    assert(nodes_[proxyId].IsLeaf());
+
+    if (nodes_[proxyId].aabb.Contains(aabb)) {
+        return false;
+    }
+
+    RemoveLeaf(proxyId);
+
+    // 余白 + 移動方向への先読み分だけ広げる
+    Aabb2D fat;
+    fat.min = { aabb.min.x - kAabbMargin, aabb.min.y - kAabbMargin };
+    fat.max = { aabb.max.x + kAabbMargin, aabb.max.y + kAabbMargin };
+
+    const Vector2 d = displacement * kDisplacementMultiplier;
+    if (d.x < 0.0f) { fat.min.x += d.x; } else { fat.max.x += d.x; }
+    if (d.y < 0.0f) { fat.min.y += d.y; } else { fat.max.y += d.y; }
+
+    nodes_[proxyId].aabb = fat;
+    InsertLeaf(proxyId);
+    return true;
+}
+
+void DynamicAabbTree::Clear() {
+    nodes_.clear();
+    root_ = kNullNode;
+    freeList_ = kNullNode;
+    proxyCount_ = 0;
+}
+
+void DynamicAabbTree::InsertLeaf(int leaf) {
+    if (root_ == kNullNode) {
+        root_ = leaf;
+        nodes_[root_].parent = kNullNode;
+        return;
+    }
+
+    // 1. 挿入先（兄弟ノード）を探す：周長の増加が最小になる方へ降りる
+    const Aabb2D leafAabb = nodes_[leaf].aabb;
+    int index = root_;
+    while (!nodes_[index].IsLeaf()) {
+        const int child1 = nodes_[index].child1;
+        const int child2 = nodes_[index].child2;
+
+        const float area = nodes_[index].aabb.GetPerimeter();
+        const float combinedArea = Aabb2D::Combine(nodes_[index].aabb, leafAabb).GetPerimeter();
+
+        // このノードの兄弟として新しい親を作るコスト
+        const float cost = 2.0f * combinedArea;
+
+        // さらに下へ降りる場合、祖先が広がる分の最低コスト
+        const float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto descendCost = [&](int child) {
+            const Aabb2D combined = Aabb2D::Combine(leafAabb, nodes_[child].aabb);
+            if (nodes_[child].IsLeaf()) {
+                return combined.GetPerimeter() + inheritanceCost;
+            }
+            return (combined.GetPerimeter() - nodes_[child].aabb.GetPerimeter()) + inheritanceCost;
+        };
+        const float cost1 = descendCost(child1);
+        const float cost2 = descendCost(child2);
+
+        if (cost < cost1 && cost < cost2) break;
+
+        index = (cost1 < cost2) ? child1 : child2;
+    }
+
+    // 2. 新しい親を作って兄弟と葉をぶら下げる
+    const int sibling = index;
+    const int oldParent = nodes_[sibling].parent;
+    const int newParent = AllocateNode();
+    nodes_[newParent].parent = oldParent;
+    nodes_[newParent].aabb = Aabb2D::Combine(leafAabb, nodes_[sibling].aabb);
+    nodes_[newParent].height = nodes_[sibling].height + 1;
+    nodes_[newParent].child1 = sibling;
+    nodes_[newParent].child2 = leaf;
+    nodes_[sibling].parent = newParent;
+    nodes_[leaf].parent = newParent;
+
+    if (oldParent != kNullNode) {
+        if (nodes_[oldParent].child1 == sibling) {
+            nodes_[oldParent].child1 = newParent;
+        }
+        else {
+            nodes_[oldParent].child2 = newParent;
+        }
+    }
+    else {
+        root_ = newParent;
+    }
+
+    // 3. 根に向かって高さとAABBを直しつつバランスを取る
+    index = nodes_[leaf].parent;
+    while (index != kNullNode) {
+        index = Balance(index);
+
+        const int child1 = nodes_[index].child1;
+        const int child2 = nodes_[index].child2;
+        nodes_[index].height = 1 + std::max(nodes_[child1].height, nodes_[child2].height);
+        nodes_[index].aabb = Aabb2D::Combine(nodes_[child1].aabb, nodes_[child2].aabb);
+
+        index = nodes_[index].parent;
+    }
+}
+
+void DynamicAabbTree::RemoveLeaf(int leaf) {
+    if (leaf == root_) {
+        root_ = kNullNode;
+        return;
+    }
+
+    const int parent = nodes_[leaf].parent;
+    const int grandParent = nodes_[parent].parent;
+    const int sibling = (nodes_[parent].child1 == leaf) ? nodes_[parent].child2 : nodes_[parent].child1;
+
+    if (grandParent == kNullNode) {
+        root_ = sibling;
+        nodes_[sibling].parent = kNullNode;
+        FreeNode(parent);
+        return;
+    }
+
+    // 親を消して兄弟を祖父に直接つなぐ
+    if (nodes_[grandParent].child1 == parent) {
+        nodes_[grandParent].child1 = sibling;
+    }
+    else {
+        nodes_[grandParent].child2 = sibling;
+    }
+    nodes_[sibling].parent = grandParent;
+    FreeNode(parent);
+
+    int index = grandParent;
+    while (index != kNullNode) {
+        index = Balance(index);
+
+        const int child1 = nodes_[index].child1;
+        const int child2 = nodes_[index].child2;
+        nodes_[index].aabb = Aabb2D::Combine(nodes_[child1].aabb, nodes_[child2].aabb);
+        nodes_[index].height = 1 + std::max(nodes_[child1].height, nodes_[child2].height);
+
+        index = nodes_[index].parent;
+    }
+}
+
+int DynamicAabbTree::Balance(int iA) {
+    Node& a = nodes_[iA];
+    if (a.IsLeaf() || a.height < 2) {
+        return iA;
+    }
+
+    const int iB = a.child1;
+    const int iC = a.child2;
+    Node& b = nodes_[iB];
+    Node& c = nodes_[iC];
+
+    const int balance = c.height - b.height;
+
+    // Cを持ち上げる
+    if (balance > 1) {
+        const int iF = c.child1;
+        const int iG = c.child2;
+        Node& f = nodes_[iF];
+        Node& g = nodes_[iG];
+
+        c.child1 = iA;
+        c.parent = a.parent;
+        a.parent = iC;
+
+        if (c.parent != kNullNode) {
+            if (nodes_[c.parent].child1 == iA) {
+                nodes_[c.parent].child1 = iC;
+            }
+            else {
+                nodes_[c.parent].child2 = iC;
+            }
+        }
+        else {
+            root_ = iC;
+        }
+
+        if (f.height > g.height) {
+            c.child2 = iF;
+            a.child2 = iG;
+            g.parent = iA;
+            a.aabb = Aabb2D::Combine(b.aabb, g.aabb);
+            c.aabb = Aabb2D::Combine(a.aabb, f.aabb);
+            a.height = 1 + std::max(b.height, g.height);
+            c.height = 1 + std::max(a.height, f.height);
+        }
+        else {
+            c.child2 = iG;
+            a.child2 = iF;
+            f.parent = iA;
+            a.aabb = Aabb2D::Combine(b.aabb, f.aabb);
+            c.aabb = Aabb2D::Combine(a.aabb, g.aabb);
+            a.height = 1 + std::max(b.height, f.height);
+            c.height = 1 + std::max(a.height, g.height);
+        }
+        return iC;
+    }
+
+    // Bを持ち上げる
+    if (balance < -1) {
+        const int iD = b.child1;
+        const int iE = b.child2;
+        Node& d = nodes_[iD];
+        Node& e = nodes_[iE];
+
+        b.child1 = iA;
+        b.parent = a.parent;
+        a.parent = iB;
+
+        if (b.parent != kNullNode) {
+            if (nodes_[b.parent].child1 == iA) {
+                nodes_[b.parent].child1 = iB;
+            }
+            else {
+                nodes_[b.parent].child2 = iB;
+            }
+        }
+        else {
+            root_ = iB;
+        }
+
+        if (d.height > e.height) {
+            b.child2 = iD;
+            a.child1 = iE;
+            e.parent = iA;
+            a.aabb = Aabb2D::Combine(c.aabb, e.aabb);
+            b.aabb = Aabb2D::Combine(a.aabb, d.aabb);
+            a.height = 1 + std::max(c.height, e.height);
+            b.height = 1 + std::max(a.height, d.height);
+        }
+        else {
+            b.child2 = iE;
+            a.child1 = iD;
+            d.parent = iA;
+            a.aabb = Aabb2D::Combine(c.aabb, d.aabb);
+            b.aabb = Aabb2D::Combine(a.aabb, e.aabb);
+            a.height = 1 + std::max(c.height, d.height);
+            b.height = 1 + std::max(a.height, e.height);
+        }
+        return iB;
+    }
+
+    return iA;
+}
@@ -0,0 +1,212 @@
+﻿#pragma once
+#include <vector>
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+#include "Vector2.h"
+
+/// <summary>
+/// 軸平行境界ボックス（min = 左下/左上どちらでもよい、座標の小さい側）
+/// </summary>
+struct Aabb2D {
+    Vector2 min = { 0.0f, 0.0f };
+    Vector2 max = { 0.0f, 0.0f };
+
+    bool Overlaps(const Aabb2D& other) const {
+        return min.x <= other.max.x && max.x >= other.min.x &&
+            min.y <= other.max.y && max.y >= other.min.y;
+    }
+
+    bool Contains(const Aabb2D& other) const {
+        return min.x <= other.min.x && min.y <= other.min.y &&
+            other.max.x <= max.x && other.max.y <= max.y;
+    }
+
+    // 挿入コスト計算用（2Dでは面積より周長の方が安定する）
+    float GetPerimeter() const {
+        return 2.0f * ((max.x - min.x) + (max.y - min.y));
+    }
+
+    static Aabb2D Combine(const Aabb2D& a, const Aabb2D& b) {
+        return {
+            { std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y) },
+            { std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y) }
+        };
+    }
+};
+
+/// <summary>
+/// 動的AABBツリー（ブロードフェーズ用）
+/// 葉には少し広げた(fat)AABBを持たせ、はみ出した時だけ再挿入する。
+/// 挿入時は周長が最小になる位置を選び、回転で高さを揃えるため
+/// 検索は O(log n) に収まる
+/// </summary>
+class DynamicAabbTree {
+public:
+    static constexpr int kNullNode = -1;
+
+    // fat AABBの余白と、移動量を先読みする倍率
+    static constexpr float kAabbMargin = 8.0f;
+    static constexpr float kDisplacementMultiplier = 2.0f;
+
+    DynamicAabbTree();
+
+    /// <summary>
+    /// プロキシ（葉）を作成する
+    /// </summary>
+    /// <param name="aabb">実際のAABB</param>
+    /// <param name="userData">任意のデータ（GameObject2D*など）</param>
+    /// <returns>プロキシID</returns>
+    int CreateProxy(const Aabb2D& aabb, void* userData);
+
+    /// <summary>
+    /// プロキシを削除する
+    /// </summary>
+    void DestroyProxy(int proxyId);
+
+    /// <summary>
+    /// プロキシを移動する
+    /// fat AABBに収まっている間は何もしない
+    /// </summary>
+    /// <param name="displacement">このフレームの移動量（先読み用）</param>
+    /// <returns>再挿入した場合true</returns>
+    bool MoveProxy(int proxyId, const Aabb2D& aabb, const Vector2& displacement);
+
+    /// <summary>
+    /// 全ノードを破棄する
+    /// </summary>
+    void Clear();
+
+    void* GetUserData(int proxyId) const {
+        assert(0 <= proxyId && proxyId < static_cast<int>(nodes_.size()));
+        return nodes_[proxyId].userData;
+    }
+
+    const Aabb2D& GetFatAabb(int proxyId) const {
+        assert(0 <= proxyId && proxyId < static_cast<int>(nodes_.size()));
+        return nodes_[proxyId].aabb;
+    }
+
+    // ノード配列の大きさ（プロキシIDの上限、フラグ配列の確保用）
+    int GetCapacity() const { return static_cast<int>(nodes_.size()); }
+
+    int GetProxyCount() const { return proxyCount_; }
+    int GetHeight() const { return root_ == kNullNode ? 0 : nodes_[root_].height; }
+
+    /// <summary>
+    /// AABBと重なる葉を列挙する
+    /// callback(int proxyId) が false を返すと打ち切る
+    /// </summary>
+    template <typename Callback>
+    void Query(const Aabb2D& aabb, Callback&& callback) const;
+
+    /// <summary>
+    /// 線分 p1→p2 と交差しうる葉を列挙する
+    /// callback(int proxyId, const Vector2& p1, const Vector2& p2, float maxFraction) は
+    /// 新しい maxFraction を返す（0で打ち切り、それ以外は線分を短くする）
+    /// </summary>
+    template <typename Callback>
+    void RayCast(const Vector2& p1, const Vector2& p2, float maxFraction, Callback&& callback) const;
+
+private:
+    struct Node {
+        Aabb2D aabb;
+        void* userData = nullptr;
+        int parent = kNullNode;
+        int next = kNullNode;    // フリーリスト用
+        int child1 = kNullNode;
+        int child2 = kNullNode;
+        int height = -1;         // 葉 = 0、未使用 = -1
+
+        bool IsLeaf() const { return child1 == kNullNode; }
+    };
+
+    // 探索用スタックの大きさ（バランスが取れていれば高さは 2log2(n) 程度）
+    static constexpr int kStackSize = 256;
+
+    std::vector<Node> nodes_;
+    int root_ = kNullNode;
+    int freeList_ = kNullNode;
+    int proxyCount_ = 0;
+
+    int AllocateNode();
+    void FreeNode(int nodeId);
+    void InsertLeaf(int leaf);
+    void RemoveLeaf(int leaf);
+    int Balance(int nodeId);
+};
+
+template <typename Callback>
+void DynamicAabbTree::Query(const Aabb2D& aabb, Callback&& callback) const {
+    int stack[kStackSize];
+    int count = 0;
+    if (root_ != kNullNode) {
+        stack[count++] = root_;
+    }
+
+    while (count > 0) {
+        const int nodeId = stack[--count];
+        const Node& node = nodes_[nodeId];
+        if (!node.aabb.Overlaps(aabb)) continue;
+
+        if (node.IsLeaf()) {
+            if (!callback(nodeId)) return;
+        }
+        else {
+            assert(count + 2 <= kStackSize);
+            stack[count++] = node.child1;
+            stack[count++] = node.child2;
+        }
+    }
+}
+
+template <typename Callback>
+void DynamicAabbTree::RayCast(const Vector2& p1, const Vector2& p2, float maxFraction, Callback&& callback) const {
+    const Vector2 d = p2 - p1;
+    if (d.x * d.x + d.y * d.y <= 0.0f) return;
+
+    // 線分の法線（分離軸判定に使う）
+    const float length = std::sqrt(d.x * d.x + d.y * d.y);
+    const Vector2 v = { -d.y / length, d.x / length };
+    const Vector2 absV = { std::abs(v.x), std::abs(v.y) };
+
+    // 現在の線分を囲むAABB
+    auto segmentAabb = [&p1, &d](float fraction) {
+        const Vector2 t = { p1.x + d.x * fraction, p1.y + d.y * fraction };
+        return Aabb2D{ { std::min(p1.x, t.x), std::min(p1.y, t.y) },
+            { std::max(p1.x, t.x), std::max(p1.y, t.y) } };
+    };
+    Aabb2D segment = segmentAabb(maxFraction);
+
+    int stack[kStackSize];
+    int count = 0;
+    if (root_ != kNullNode) {
+        stack[count++] = root_;
+    }
+
+    while (count > 0) {
+        const int nodeId = stack[--count];
+        const Node& node = nodes_[nodeId];
+        if (!node.aabb.Overlaps(segment)) continue;
+
+        // 線分の法線方向で分離していれば交差しない |dot(v, p1 - c)| > dot(|v|, h)
+        const Vector2 c = { (node.aabb.min.x + node.aabb.max.x) * 0.5f, (node.aabb.min.y + node.aabb.max.y) * 0.5f };
+        const Vector2 h = { (node.aabb.max.x - node.aabb.min.x) * 0.5f, (node.aabb.max.y - node.aabb.min.y) * 0.5f };
+        const float separation = std::abs(v.x * (p1.x - c.x) + v.y * (p1.y - c.y)) - (absV.x * h.x + absV.y * h.y);
+        if (separation > 0.0f) continue;
+
+        if (node.IsLeaf()) {
+            const float value = callback(nodeId, p1, p2, maxFraction);
+            if (value == 0.0f) return;
+            if (value > 0.0f && value < maxFraction) {
+                maxFraction = value;
+                segment = segmentAabb(maxFraction);
+            }
+        }
+        else {
+            assert(count + 2 <= kStackSize);
+            stack[count++] = node.child1;
+            stack[count++] = node.child2;
+        }
+    }
+}
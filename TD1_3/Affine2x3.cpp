@@ -0,0 +1,49 @@
+﻿#include "Affine2x3.h"
+#include <cassert>
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#include <emmintrin.h>
+#define AFFINE2X3_USE_SSE
+#endif
+
+// Vector2 の配列を float の x, y の並びとして読み書きする
+static_assert(sizeof(Vector2) == sizeof(float) * 2, "Affine2x3: Vector2 must be two packed floats");
+
+void Affine2x3::TransformPoints(std::span<const Vector2> in, std::span<Vector2> out) const {
+    assert(out.size() >= in.size() && "Affine2x3::TransformPoints: out is smaller than in");
+
+    const size_t count = in.size();
+    size_t i = 0;
+
+#ifdef AFFINE2X3_USE_SSE
+    // 1レジスタに2点 (x0, y0, x1, y1) を入れ、
+    // (x0, x0, x1, x1) * (m00, m01, m00, m01) + (y0, y0, y1, y1) * (m10, m11, m10, m11) + (tx, ty, tx, ty) で2点ずつ変換する
+    const __m128 axisX = _mm_setr_ps(m00, m01, m00, m01);
+    const __m128 axisY = _mm_setr_ps(m10, m11, m10, m11);
+    const __m128 translate = _mm_setr_ps(tx, ty, tx, ty);
+
+    const float* src = &in.data()->x;
+    float* dst = &out.data()->x;
+
+    auto transformPair = [&](__m128 points) {
+        const __m128 xs = _mm_shuffle_ps(points, points, _MM_SHUFFLE(2, 2, 0, 0));
+        const __m128 ys = _mm_shuffle_ps(points, points, _MM_SHUFFLE(3, 3, 1, 1));
+        return _mm_add_ps(_mm_add_ps(_mm_mul_ps(xs, axisX), _mm_mul_ps(ys, axisY)), translate);
+    };
+
+    // 4点ずつ（読み終えてから書くので in と out が同じでもよい）
+    for (; i + 4 <= count; i += 4) {
+        const __m128 first = _mm_loadu_ps(src + i * 2);
+        const __m128 second = _mm_loadu_ps(src + i * 2 + 4);
+        _mm_storeu_ps(dst + i * 2, transformPair(first));
+        _mm_storeu_ps(dst + i * 2 + 4, transformPair(second));
+    }
+    for (; i + 2 <= count; i += 2) {
+        _mm_storeu_ps(dst + i * 2, transformPair(_mm_loadu_ps(src + i * 2)));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        out[i] = Transform(in[i]);
+    }
+}
@@ -0,0 +1,103 @@
+﻿#pragma once
+#include <span>
+#include "Vector2.h"
+#include "Matrix3x3.h"
+
+/// <summary>
+/// 2Dのアフィン変換（3x3行列のうち3列目が (0, 0, 1) のものだけを扱う）
+/// 並びは Matrix3x3 と同じ「行ベクトル × 行列」で、 x' = x * m00 + y * m10 + tx, y' = x * m01 + y * m11 + ty
+/// w の除算が無いので1点や四角形の変換はインラインの掛け算と足し算だけで済み、マップチップやパーティクルのように多数の点は TransformPoints でまとめて変換する
+/// カメラ・ワールド行列はどれもアフィンなので、描画の頂点変換は Matrix3x3::Transform の代わりにこちらを使う
+/// </summary>
+struct Affine2x3 {
+    float m00 = 1.0f, m01 = 0.0f; // X軸
+    float m10 = 0.0f, m11 = 1.0f; // Y軸
+    float tx = 0.0f, ty = 0.0f;   // 平行移動
+
+    static Affine2x3 Identity() { return {}; }
+
+    // 3列目は (0, 0, 1) とみなして捨てる
+    static Affine2x3 FromMatrix(const Matrix3x3& matrix) {
+        return {
+            matrix.m[0][0], matrix.m[0][1],
+            matrix.m[1][0], matrix.m[1][1],
+            matrix.m[2][0], matrix.m[2][1]
+        };
+    }
+
+    Matrix3x3 ToMatrix() const {
+        Matrix3x3 result = {};
+        result.m[0][0] = m00; result.m[0][1] = m01;
+        result.m[1][0] = m10; result.m[1][1] = m11;
+        result.m[2][0] = tx;  result.m[2][1] = ty;
+        result.m[2][2] = 1.0f;
+        return result;
+    }
+
+    // 拡大縮小 → 回転 → 平行移動（AffineMatrix2D::MakeAffine と同じ並び）
+    static Affine2x3 MakeAffine(const Vector2& scale, float cosTheta, float sinTheta, const Vector2& translate) {
+        return {
+            scale.x * cosTheta, scale.x * sinTheta,
+            -scale.y * sinTheta, scale.y * cosTheta,
+            translate.x, translate.y
+        };
+    }
+
+    // first を掛けてから second を掛けるのと同じ変換（Matrix3x3::Multiply(first, second) と同じ並び）
+    static Affine2x3 Multiply(const Affine2x3& first, const Affine2x3& second) {
+        return {
+            first.m00 * second.m00 + first.m01 * second.m10,
+            first.m00 * second.m01 + first.m01 * second.m11,
+            first.m10 * second.m00 + first.m11 * second.m10,
+            first.m10 * second.m01 + first.m11 * second.m11,
+            first.tx * second.m00 + first.ty * second.m10 + second.tx,
+            first.tx * second.m01 + first.ty * second.m11 + second.ty
+        };
+    }
+
+    // 点の変換（平行移動あり）
+    Vector2 Transform(const Vector2& point) const {
+        return {
+            point.x * m00 + point.y * m10 + tx,
+            point.x * m01 + point.y * m11 + ty
+        };
+    }
+
+    // 向き・長さの変換（平行移動なし）
+    Vector2 TransformVector(const Vector2& vector) const {
+        return {
+            vector.x * m00 + vector.y * m10,
+            vector.x * m01 + vector.y * m11
+        };
+    }
+
+    /// <summary>
+    /// 多数の点をまとめて変換する（4点ずつSIMD。in と out は同じ配列でもよい）
+    /// </summary>
+    /// <param name="in">変換前の点</param>
+    /// <param name="out">変換後の点（in 以上の数が必要）</param>
+    void TransformPoints(std::span<const Vector2> in, std::span<Vector2> out) const;
+
+    /// <summary>
+    /// 四角形の4頂点を変換する（4点だけなのでSIMDにせずインラインで変換する）
+    /// </summary>
+    /// <param name="local">ローカル座標の4頂点</param>
+    /// <param name="out">変換後の4頂点（local と同じ並び）</param>
+    void TransformQuad(const Vector2 (&local)[4], Vector2 (&out)[4]) const {
+        for (int i = 0; i < 4; ++i) {
+            out[i] = Transform(local[i]);
+        }
+    }
+
+    /// <summary>
+    /// ワールド行列とビュープロジェクション行列を1つにまとめてから、四角形の4頂点をスクリーンへ変換する
+    /// </summary>
+    /// <param name="world">ローカル → ワールド</param>
+    /// <param name="viewProjection">ワールド → スクリーン</param>
+    /// <param name="local">ローカル座標の4頂点</param>
+    /// <param name="out">スクリーン座標の4頂点（local と同じ並び）</param>
+    static void TransformQuad(const Affine2x3& world, const Affine2x3& viewProjection,
+        const Vector2 (&local)[4], Vector2 (&out)[4]) {
+        Multiply(world, viewProjection).TransformQuad(local, out);
+    }
+};
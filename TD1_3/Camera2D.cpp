@@ -1,6 +1,7 @@
 ﻿#include "Camera2D.h"
 #include "Affine2D.h"
-#include <random>
+#include "Random.h"
+#include "WorldSnapshot.h"
 #include <algorithm>
 #include <cmath>
 #include <Novice.h>
@@ -8,6 +9,7 @@
 // ========== コンストラクタ ==========
 Camera2D::Camera2D(const Vector2& position, const Vector2& size, bool invertY)
 	: position_(position)
+	, previousPosition_(position)
 	, size_(size)
 	, zoom_(1.0f)
 	, rotation_(0.0f)
@@ -18,6 +20,8 @@ Camera2D::Camera2D(const Vector2& position, const Vector2& size, bool invertY)
 
 // ========== 更新 ==========
 void Camera2D::Update(float deltaTime) {
+	previousPosition_ = position_;
+
 	// デバッグモード中は通常の更新処理をスキップ
 	if (isDebugCamera_) {
 		// デバッグモード中でもシェイク・ズーム・移動エフェクトは動作させる
@@ -42,6 +46,7 @@ void Camera2D::Update(float deltaTime) {
 // ========== 基本操作 ==========
 void Camera2D::SetPosition(const Vector2& pos) {
 	position_ = pos;
+	previousPosition_ = pos; // ワープ扱い（補間しない）
 }
 
 Vector2 Camera2D::GetPosition() const {
@@ -145,12 +150,9 @@ void Camera2D::UpdateShakeEffect(float deltaTime) {
 	if (!shakeEffect_.isActive) return;
 
 	// ランダムなオフセットを生成
-	static std::random_device rd;
-	static std::mt19937 gen(rd());
-	std::uniform_real_distribution<float> dist(-shakeEffect_.intensity, shakeEffect_.intensity);
-
-	shakeEffect_.offset.x = dist(gen);
-	shakeEffect_.offset.y = dist(gen);
+	Random& rng = Rng(RandomStreamId::Visual);
+	shakeEffect_.offset.x = rng.RandomFloat(-shakeEffect_.intensity, shakeEffect_.intensity);
+	shakeEffect_.offset.y = rng.RandomFloat(-shakeEffect_.intensity, shakeEffect_.intensity);
 
 	// 時間制限のあるシェイクの場合
 	if (!shakeEffect_.continuous) {
@@ -241,9 +243,66 @@ void Camera2D::ApplyBounds() {
 }
 
 // ========== 行列計算 ==========
+void Camera2D::ApplyInterpolation(float alpha) {
+	UpdateMatrices(previousPosition_ + (position_ - previousPosition_) * alpha);
+}
+
+// ========== スナップショット ==========
+void Camera2D::SaveState(SnapshotWriter& writer) const {
+	writer.Write(position_);
+	writer.Write(previousPosition_);
+	writer.Write(zoom_);
+	writer.Write(rotation_);
+
+	writer.Write(moveEffect_.isActive);
+	writer.Write(moveEffect_.startPos);
+	writer.Write(moveEffect_.targetPos);
+	writer.Write(moveEffect_.elapsed);
+	writer.Write(moveEffect_.duration);
+
+	writer.Write(zoomEffect_.isActive);
+	writer.Write(zoomEffect_.startZoom);
+	writer.Write(zoomEffect_.targetZoom);
+	writer.Write(zoomEffect_.elapsed);
+	writer.Write(zoomEffect_.duration);
+
+	writer.Write(shakeEffect_);
+}
+
+void Camera2D::LoadState(SnapshotReader& reader) {
+	reader.Read(position_);
+	reader.Read(previousPosition_);
+	reader.Read(zoom_);
+	reader.Read(rotation_);
+
+	reader.Read(moveEffect_.isActive);
+	reader.Read(moveEffect_.startPos);
+	reader.Read(moveEffect_.targetPos);
+	reader.Read(moveEffect_.elapsed);
+	reader.Read(moveEffect_.duration);
+
+	reader.Read(zoomEffect_.isActive);
+	reader.Read(zoomEffect_.startZoom);
+	reader.Read(zoomEffect_.targetZoom);
+	reader.Read(zoomEffect_.elapsed);
+	reader.Read(zoomEffect_.duration);
+
+	reader.Read(shakeEffect_);
+
+	// イージング関数が無い演出は続けられないので止める
+	if (!moveEffect_.easingFunc) moveEffect_.isActive = false;
+	if (!zoomEffect_.easingFunc) zoomEffect_.isActive = false;
+
+	UpdateMatrices();
+}
+
 void Camera2D::UpdateMatrices() {
+	UpdateMatrices(position_);
+}
+
+void Camera2D::UpdateMatrices(const Vector2& basePosition) {
 	// シェイクオフセットを適用した位置
-	Vector2 finalPosition = position_;
+	Vector2 finalPosition = basePosition;
 	if (shakeEffect_.isActive) {
 		finalPosition.x += shakeEffect_.offset.x;
 		finalPosition.y += shakeEffect_.offset.y;
@@ -287,12 +346,31 @@ void Camera2D::UpdateMatrices() {
 	// View * Projection * Viewport 行列を合成
 	Matrix3x3 vp = Matrix3x3::Multiply(viewMatrix_, projectionMatrix_);
 	vpVpMatrix_ = Matrix3x3::Multiply(vp, viewportMatrix_);
+	vpVpAffine_ = Affine2x3::FromMatrix(vpVpMatrix_);
 }
 
 Matrix3x3 Camera2D::GetVpVpMatrix() const {
 	return vpVpMatrix_;
 }
 
+void Camera2D::GetVisibleWorldRect(Vector2& outMin, Vector2& outMax) const {
+	// 画面の四隅をワールド座標へ戻し、その外接矩形を表示範囲とする
+	const Matrix3x3 invVpVp = Matrix3x3::Inverse(vpVpMatrix_);
+	const Vector2 corners[4] = {
+		{ 0.0f, 0.0f }, { size_.x, 0.0f }, { 0.0f, size_.y }, { size_.x, size_.y }
+	};
+
+	outMin = Matrix3x3::Transform(corners[0], invVpVp);
+	outMax = outMin;
+	for (int i = 1; i < 4; ++i) {
+		const Vector2 p = Matrix3x3::Transform(corners[i], invVpVp);
+		outMin.x = std::min(outMin.x, p.x);
+		outMin.y = std::min(outMin.y, p.y);
+		outMax.x = std::max(outMax.x, p.x);
+		outMax.y = std::max(outMax.y, p.y);
+	}
+}
+
 // ========== デバッグ用カメラ操作 ==========
 void Camera2D::DebugMove(bool isDebug, const char* keys, const char* pre) {
 	if (!isDebug) {
@@ -1,11 +1,14 @@
 ﻿#pragma once
 #include "Vector2.h"
 #include "Matrix3x3.h"
+#include "Affine2x3.h"
 #include "WindowSize.h"
 #include <functional>
 #include "Easing.h"
 
 class DebugWindow; // 前方宣言
+class SnapshotWriter;
+class SnapshotReader;
 
 class Camera2D {
 	friend class DebugWindow;
@@ -66,6 +69,24 @@ public:
 	// === 行列取得 ===
 	Matrix3x3 GetVpVpMatrix() const;
 
+	// 同じ行列のアフィン版（頂点変換用。行列を作り直した時に一緒に作る）
+	const Affine2x3& GetVpVpAffine() const { return vpVpAffine_; }
+
+	/// <summary>
+	/// 画面に映っているワールド座標の範囲を取得（回転・シェイク・描画補間を含む外接矩形）
+	/// </summary>
+	/// <param name="outMin">範囲の最小座標</param>
+	/// <param name="outMax">範囲の最大座標</param>
+	void GetVisibleWorldRect(Vector2& outMin, Vector2& outMax) const;
+
+	// === 描画補間 ===
+	/// <summary>
+	/// 前回のUpdateと今回のUpdateの間の位置で行列を作り直す（描画の直前に呼ぶ）
+	/// 次のUpdateで最新の位置の行列に戻る
+	/// </summary>
+	/// <param name="alpha">補間係数（0 = 前ステップ, 1 = 現ステップ）</param>
+	void ApplyInterpolation(float alpha);
+
 	// === Y軸反転取得 ===
 	bool IsWorldYUp() const { return isWorldYUp_; }
 	void SetIsWorldYUp(bool invert) { isWorldYUp_ = invert; }
@@ -99,7 +120,7 @@ public:
 	/// </summary>
 	/// <param name="pos">ワールド座標</param>
 	Vector2 WorldToScreen(Vector2 pos) {
-		return Matrix3x3::Transform(pos, vpVpMatrix_);
+		return vpVpAffine_.Transform(pos);
 	}
 
 	/// <summary>
@@ -111,10 +132,18 @@ public:
 		return Matrix3x3::Transform(pos, invVpVp);
 	}
 
+	/// <summary>
+	/// 位置・ズーム・演出の進み具合を保存・復元する（リトライ・巻き戻し用）
+	/// 追従対象とイージング関数は保存せず、今の設定のまま使う
+	/// </summary>
+	void SaveState(SnapshotWriter& writer) const;
+	void LoadState(SnapshotReader& reader);
+
 
 private:
 	// 基本パラメータ
 	Vector2 position_;
+	Vector2 previousPosition_; // 前回Update開始時の位置（描画補間用）
 	Vector2 size_;
 	float zoom_;
 	float rotation_;
@@ -184,6 +213,8 @@ private:
 	Matrix3x3 projectionMatrix_;
 	Matrix3x3 viewportMatrix_;
 	Matrix3x3 vpVpMatrix_;
+	Affine2x3 vpVpAffine_;
 
 	void UpdateMatrices();
+	void UpdateMatrices(const Vector2& basePosition);
 };
\ No newline at end of file
@@ -0,0 +1,266 @@
+﻿#include "CollisionWorld.h"
+#include "GameObject2D.h"
+#include <algorithm>
+
+Aabb2D CollisionWorld::ComputeAabb(const GameObject2D& obj) {
+    const Vector2 center = obj.transform_.translate + obj.collider_.offset;
+    const Vector2 half = obj.collider_.size * 0.5f;
+    return { center - half, center + half };
+}
+
+void CollisionWorld::Update(const std::vector<GameObjectPtr>& objects, float deltaTime) {
+    // 1. ツリーの更新（動いたものだけ再挿入）
+    for (const auto& ptr : objects) {
+        GameObject2D* obj = ptr.get();
+        const bool canCollide = obj->info_.isActive && !obj->isDead_ && obj->collider_.canCollide;
+
+        if (!canCollide) {
+            RemoveObject(obj);
+            continue;
+        }
+
+        const Aabb2D aabb = ComputeAabb(*obj);
+        int proxyId = obj->collisionProxy_;
+        bool moved = false;
+
+        if (proxyId < 0) {
+            proxyId = tree_.CreateProxy(aabb, obj);
+            obj->collisionProxy_ = proxyId;
+            moved = true;
+        }
+        else {
+            moved = tree_.MoveProxy(proxyId, aabb, obj->rigidbody_.velocity * deltaTime);
+        }
+
+        if (moved) {
+            if (static_cast<int>(isMoved_.size()) < tree_.GetCapacity()) {
+                isMoved_.resize(tree_.GetCapacity(), 0);
+            }
+            if (!isMoved_[proxyId]) {
+                isMoved_[proxyId] = 1;
+                moveBuffer_.push_back(proxyId);
+            }
+        }
+    }
+
+    // 外れたオブジェクトの接触を先に片付ける（IDの再利用に備える）
+    FlushRemovals();
+
+    // 2. 再挿入されたプロキシの周囲だけ新しいペアを探す
+    FindNewContacts();
+
+    // 3. 接触状態の更新とイベント発行
+    UpdateContacts();
+}
+
+void CollisionWorld::FindNewContacts() {
+    for (int proxyId : moveBuffer_) {
+        const Aabb2D& fat = tree_.GetFatAabb(proxyId);
+        tree_.Query(fat, [this, proxyId](int otherId) {
+            if (otherId == proxyId) return true;
+
+            // 両方動いた組は、IDの大きい側からの検索でのみ追加する（重複防止）
+            if (isMoved_[otherId] && otherId > proxyId) return true;
+
+            const uint64_t key = MakeKey(proxyId, otherId);
+            if (contactKeys_.insert(key).second) {
+                contacts_.push_back({ std::min(proxyId, otherId), std::max(proxyId, otherId), false });
+            }
+            return true;
+        });
+    }
+
+    for (int proxyId : moveBuffer_) {
+        isMoved_[proxyId] = 0;
+    }
+    moveBuffer_.clear();
+}
+
+void CollisionWorld::UpdateContacts() {
+    pairs_.clear();
+
+    size_t i = 0;
+    while (i < contacts_.size()) {
+        Contact& contact = contacts_[i];
+
+        // fat AABBが離れたら接触を破棄
+        if (!tree_.GetFatAabb(contact.proxyA).Overlaps(tree_.GetFatAabb(contact.proxyB))) {
+            if (contact.isTouching) {
+                Dispatch(contact, ContactEvent::Exit);
+            }
+            RemoveContactAt(i);
+            continue;
+        }
+
+        // 実際のAABBで判定
+        auto* a = static_cast<GameObject2D*>(tree_.GetUserData(contact.proxyA));
+        auto* b = static_cast<GameObject2D*>(tree_.GetUserData(contact.proxyB));
+        const bool touching = ComputeAabb(*a).Overlaps(ComputeAabb(*b));
+
+        if (touching) {
+            Dispatch(contact, contact.isTouching ? ContactEvent::Stay : ContactEvent::Enter);
+            pairs_.push_back({ a, b });
+        }
+        else if (contact.isTouching) {
+            Dispatch(contact, ContactEvent::Exit);
+        }
+
+        contacts_[i].isTouching = touching;
+        ++i;
+    }
+}
+
+void CollisionWorld::RemoveObject(GameObject2D* obj) {
+    if (!obj || obj->collisionProxy_ < 0) return;
+
+    const int proxyId = obj->collisionProxy_;
+    obj->collisionProxy_ = -1;
+
+    if (static_cast<int>(isRemoved_.size()) < tree_.GetCapacity()) {
+        isRemoved_.resize(tree_.GetCapacity(), 0);
+    }
+    isRemoved_[proxyId] = 1;
+    removedProxies_.push_back(proxyId);
+}
+
+void CollisionWorld::FlushRemovals() {
+    if (removedProxies_.empty()) return;
+
+    // 削除対象を含む接触を一度の走査で取り除く
+    size_t i = 0;
+    while (i < contacts_.size()) {
+        const Contact& contact = contacts_[i];
+        if (isRemoved_[contact.proxyA] || isRemoved_[contact.proxyB]) {
+            if (contact.isTouching) {
+                Dispatch(contact, ContactEvent::Exit);
+            }
+            RemoveContactAt(i);
+            continue;
+        }
+        ++i;
+    }
+
+    for (int proxyId : removedProxies_) {
+        tree_.DestroyProxy(proxyId);
+        isRemoved_[proxyId] = 0;
+        if (static_cast<size_t>(proxyId) < isMoved_.size()) {
+            isMoved_[proxyId] = 0;
+        }
+    }
+
+    // 移動バッファから削除済みのIDを外す
+    moveBuffer_.erase(
+        std::remove_if(moveBuffer_.begin(), moveBuffer_.end(),
+            [this](int proxyId) { return !isMoved_[proxyId]; }),
+        moveBuffer_.end());
+
+    removedProxies_.clear();
+}
+
+void CollisionWorld::Clear() {
+    // オブジェクト側のプロキシIDを戻す
+    for (int proxyId = 0; proxyId < tree_.GetCapacity(); ++proxyId) {
+        if (auto* obj = static_cast<GameObject2D*>(tree_.GetUserData(proxyId))) {
+            obj->collisionProxy_ = -1;
+        }
+    }
+
+    tree_.Clear();
+    moveBuffer_.clear();
+    isMoved_.clear();
+    contacts_.clear();
+    contactKeys_.clear();
+    pairs_.clear();
+    removedProxies_.clear();
+    isRemoved_.clear();
+}
+
+void CollisionWorld::RemoveContactAt(size_t index) {
+    contactKeys_.erase(MakeKey(contacts_[index].proxyA, contacts_[index].proxyB));
+    contacts_[index] = contacts_.back();
+    contacts_.pop_back();
+}
+
+void CollisionWorld::Dispatch(const Contact& contact, ContactEvent ev) {
+    auto* a = static_cast<GameObject2D*>(tree_.GetUserData(contact.proxyA));
+    auto* b = static_cast<GameObject2D*>(tree_.GetUserData(contact.proxyB));
+
+    // どちらかがトリガーならTrigger系、それ以外はCollision系
+    const bool isTrigger = a->collider_.isTrigger || b->collider_.isTrigger;
+
+    switch (ev) {
+    case ContactEvent::Enter:
+        // 接触した相手が眠っていれば起こす
+        a->WakeUp();
+        b->WakeUp();
+        if (isTrigger) { a->OnTriggerEnter(b); b->OnTriggerEnter(a); }
+        else { a->OnCollisionEnter(b); b->OnCollisionEnter(a); }
+        break;
+    case ContactEvent::Stay:
+        if (isTrigger) { a->OnTriggerStay(b); b->OnTriggerStay(a); }
+        else { a->OnCollisionStay(b); b->OnCollisionStay(a); }
+        break;
+    case ContactEvent::Exit:
+        if (isTrigger) { a->OnTriggerExit(b); b->OnTriggerExit(a); }
+        else { a->OnCollisionExit(b); b->OnCollisionExit(a); }
+        break;
+    }
+}
+
+void CollisionWorld::QueryRegion(const Vector2& min, const Vector2& max, std::vector<GameObject2D*>& out) const {
+    const Aabb2D region = { min, max };
+    tree_.Query(region, [this, &region, &out](int proxyId) {
+        auto* obj = static_cast<GameObject2D*>(tree_.GetUserData(proxyId));
+        if (ComputeAabb(*obj).Overlaps(region)) {
+            out.push_back(obj);
+        }
+        return true;
+    });
+}
+
+bool CollisionWorld::RayCast(const Vector2& origin, const Vector2& end, RaycastHit& hit) const {
+    const Vector2 d = end - origin;
+    float bestFraction = 1.0f;
+    GameObject2D* bestObject = nullptr;
+
+    tree_.RayCast(origin, end, 1.0f,
+        [this, &d, &bestFraction, &bestObject](int proxyId, const Vector2& p1, const Vector2&, float maxFraction) {
+            auto* obj = static_cast<GameObject2D*>(tree_.GetUserData(proxyId));
+            if (obj->collider_.isTrigger) return maxFraction;
+
+            // スラブ法で実際のAABBとの交差位置を求める
+            const Aabb2D box = ComputeAabb(*obj);
+            float tMin = 0.0f;
+            float tMax = maxFraction;
+            const float from[2] = { p1.x, p1.y };
+            const float dir[2] = { d.x, d.y };
+            const float lo[2] = { box.min.x, box.min.y };
+            const float hi[2] = { box.max.x, box.max.y };
+
+            for (int axis = 0; axis < 2; ++axis) {
+                if (std::abs(dir[axis]) < 1e-8f) {
+                    if (from[axis] < lo[axis] || from[axis] > hi[axis]) return maxFraction;
+                    continue;
+                }
+                const float inv = 1.0f / dir[axis];
+                float t1 = (lo[axis] - from[axis]) * inv;
+                float t2 = (hi[axis] - from[axis]) * inv;
+                if (t1 > t2) std::swap(t1, t2);
+                tMin = std::max(tMin, t1);
+                tMax = std::min(tMax, t2);
+                if (tMin > tMax) return maxFraction;
+            }
+
+            // より近い当たりで線分を縮める
+            bestFraction = tMin;
+            bestObject = obj;
+            return tMin;
+        });
+
+    if (!bestObject) return false;
+
+    hit.object = bestObject;
+    hit.point = origin + d * bestFraction;
+    hit.distance = Vector2::Length(d) * bestFraction;
+    return true;
+}
@@ -0,0 +1,119 @@
+﻿#pragma once
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <unordered_set>
+#include "AabbTree.h"
+#include "GameObjectPool.h"
+
+// 接触中のオブジェクトの組
+struct CollisionPair {
+    GameObject2D* a = nullptr;
+    GameObject2D* b = nullptr;
+};
+
+// レイキャストの結果
+struct RaycastHit {
+    GameObject2D* object = nullptr;
+    Vector2 point = { 0.0f, 0.0f }; // 当たった位置
+    float distance = 0.0f;          // 始点からの距離
+};
+
+/// <summary>
+/// オブジェクト同士の当たり判定を管理するクラス
+/// 動的AABBツリーでブロードフェーズを行い、接触ペアを持ち越して
+/// Enter / Stay / Exit のイベントを発行する
+/// </summary>
+class CollisionWorld {
+public:
+    CollisionWorld() = default;
+    ~CollisionWorld() = default;
+
+    // コピー禁止（プロキシIDをオブジェクト側に持たせているため）
+    CollisionWorld(const CollisionWorld&) = delete;
+    CollisionWorld& operator=(const CollisionWorld&) = delete;
+
+    /// <summary>
+    /// ツリーの更新、ペア検出、イベント発行
+    /// 非アクティブ・死亡・canCollide=false のオブジェクトはツリーから外す
+    /// </summary>
+    void Update(const std::vector<GameObjectPtr>& objects, float deltaTime);
+
+    /// <summary>
+    /// オブジェクトをツリーから外す予約をする（FlushRemovalsで確定）
+    /// </summary>
+    void RemoveObject(GameObject2D* obj);
+
+    /// <summary>
+    /// 予約した削除を確定する（接触中の相手にはExitを送る）
+    /// </summary>
+    void FlushRemovals();
+
+    /// <summary>
+    /// 全て破棄する（イベントは送らない）
+    /// </summary>
+    void Clear();
+
+    /// <summary>
+    /// 現在接触中のペア一覧
+    /// </summary>
+    const std::vector<CollisionPair>& GetOverlappingPairs() const { return pairs_; }
+
+    /// <summary>
+    /// 矩形範囲と重なるオブジェクトを取得
+    /// </summary>
+    void QueryRegion(const Vector2& min, const Vector2& max, std::vector<GameObject2D*>& out) const;
+
+    /// <summary>
+    /// 線分上で最も近いオブジェクトを取得（トリガーは無視）
+    /// </summary>
+    /// <returns>当たった場合true</returns>
+    bool RayCast(const Vector2& origin, const Vector2& end, RaycastHit& hit) const;
+
+    int GetProxyCount() const { return tree_.GetProxyCount(); }
+    size_t GetContactCount() const { return contacts_.size(); }
+
+    /// <summary>
+    /// オブジェクトの当たり判定AABBを計算
+    /// </summary>
+    static Aabb2D ComputeAabb(const GameObject2D& obj);
+
+private:
+    // 持ち越し中の接触（fat AABBが重なっている組）
+    struct Contact {
+        int proxyA;
+        int proxyB;
+        bool isTouching; // 実際のAABBが重なっているか
+    };
+
+    enum class ContactEvent {
+        Enter,
+        Stay,
+        Exit
+    };
+
+    DynamicAabbTree tree_;
+
+    // 今フレーム再挿入されたプロキシ（ペア検出の対象）
+    std::vector<int> moveBuffer_;
+    std::vector<uint8_t> isMoved_;
+
+    std::vector<Contact> contacts_;
+    std::unordered_set<uint64_t> contactKeys_;
+    std::vector<CollisionPair> pairs_;
+
+    // 削除予約
+    std::vector<int> removedProxies_;
+    std::vector<uint8_t> isRemoved_;
+
+    static uint64_t MakeKey(int proxyA, int proxyB) {
+        const uint32_t lo = static_cast<uint32_t>(std::min(proxyA, proxyB));
+        const uint32_t hi = static_cast<uint32_t>(std::max(proxyA, proxyB));
+        return (static_cast<uint64_t>(hi) << 32) | lo;
+    }
+
+    void FindNewContacts();
+    void UpdateContacts();
+    void RemoveContactAt(size_t index);
+    void Dispatch(const Contact& contact, ContactEvent ev);
+};
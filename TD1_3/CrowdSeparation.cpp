@@ -0,0 +1,74 @@
+﻿#include "CrowdSeparation.h"
+#include <algorithm>
+#include <execution>
+#include <cmath>
+
+void CrowdSeparation::Compute(const float* xs, const float* ys, const float* radii, size_t count) {
+    steerX_.assign(count, 0.0f);
+    steerY_.assign(count, 0.0f);
+    if (count == 0) return;
+
+    // セルの一辺は「最大半径 x 2 + 余白」。これより近い組は必ず隣り合うセルに入る
+    float maxRadius = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        maxRadius = std::max(maxRadius, radii[i]);
+    }
+    grid_.Build(xs, ys, count, maxRadius * 2.0f + padding_);
+
+    // 分割範囲を作る（作業領域は前フレームのものを使い回す）
+    const size_t chunkSize = (isParallel_ && count >= kParallelThreshold) ? kChunkSize : count;
+    const size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+    chunks_.resize(chunkCount);
+    for (size_t c = 0; c < chunkCount; ++c) {
+        chunks_[c].begin = c * chunkSize;
+        chunks_[c].end = std::min(count, (c + 1) * chunkSize);
+    }
+
+    auto process = [this, xs, ys, radii](Chunk& chunk) { ComputeRange(chunk, xs, ys, radii); };
+
+    if (chunkCount > 1) {
+        std::for_each(std::execution::par, chunks_.begin(), chunks_.end(), process);
+    }
+    else {
+        process(chunks_[0]);
+    }
+}
+
+void CrowdSeparation::ComputeRange(Chunk& chunk, const float* xs, const float* ys, const float* radii) {
+    for (size_t i = chunk.begin; i < chunk.end; ++i) {
+        chunk.candidates.clear();
+        grid_.QueryNeighbors(xs[i], ys[i], chunk.candidates);
+
+        float steerX = 0.0f;
+        float steerY = 0.0f;
+        int neighborCount = 0;
+
+        for (const uint32_t j : chunk.candidates) {
+            if (j == i) continue;
+
+            const float minDist = radii[i] + radii[j] + padding_;
+            float dx = xs[i] - xs[j];
+            float dy = ys[i] - ys[j];
+            float distSq = dx * dx + dy * dy;
+            if (distSq >= minDist * minDist) continue;
+
+            // 完全に重なっている場合は番号の大小で左右に振り分ける
+            if (distSq < 1e-6f) {
+                dx = (i < j) ? 1.0f : -1.0f;
+                dy = 0.0f;
+                distSq = 1.0f;
+            }
+
+            // 近いほど強く離れる（接していれば0、中心が重なっていれば1）
+            const float dist = std::sqrt(distSq);
+            const float weight = (minDist - dist) / minDist;
+            steerX += dx / dist * weight;
+            steerY += dy / dist * weight;
+
+            if (++neighborCount >= kMaxNeighbors) break;
+        }
+
+        steerX_[i] = steerX;
+        steerY_[i] = steerY;
+    }
+}
@@ -0,0 +1,65 @@
+﻿#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "SpatialHashGrid.h"
+
+/// <summary>
+/// 群れの押し離し（分離ステアリング）を計算するクラス
+/// 全員の位置を1つの空間ハッシュに入れ、近くの仲間から離れる向きを求める
+/// 計算前の位置（読み取り専用）から結果配列（書き込み専用）へ出力するので、個体ごとに並列で計算できる
+/// </summary>
+class CrowdSeparation {
+public:
+    CrowdSeparation() = default;
+    ~CrowdSeparation() = default;
+
+    /// <summary>
+    /// 分離の向きを計算する
+    /// 結果は GetSteerX/Y(i) で取り出す（重なりが大きいほど長い。最大でおよそ kMaxNeighbors）
+    /// </summary>
+    /// <param name="xs">X座標の配列</param>
+    /// <param name="ys">Y座標の配列</param>
+    /// <param name="radii">半径の配列</param>
+    /// <param name="count">個体数</param>
+    void Compute(const float* xs, const float* ys, const float* radii, size_t count);
+
+    float GetSteerX(size_t index) const { return steerX_[index]; }
+    float GetSteerY(size_t index) const { return steerY_[index]; }
+    const float* GetSteerXData() const { return steerX_.data(); }
+    const float* GetSteerYData() const { return steerY_.data(); }
+
+    // 半径の合計にこれを足した距離まで近づいたら離れようとする
+    void SetPadding(float padding) { padding_ = padding; }
+
+    // 並列実行の設定（個体数がしきい値以上のときだけ分割する）
+    void SetParallel(bool enable) { isParallel_ = enable; }
+
+    // 直近のComputeで作った近傍グリッド
+    const SpatialHashGrid& GetGrid() const { return grid_; }
+
+private:
+    // 1体が考慮する仲間の上限（密集しても計算量が増えすぎないように）
+    static constexpr int kMaxNeighbors = 8;
+
+    // 並列化する最小個体数と1タスクあたりの個体数
+    static constexpr size_t kParallelThreshold = 1024;
+    static constexpr size_t kChunkSize = 256;
+
+    // 分割範囲と、その範囲専用の作業領域（スレッド間で共有しない）
+    struct Chunk {
+        size_t begin = 0;
+        size_t end = 0;
+        std::vector<uint32_t> candidates;
+    };
+
+    SpatialHashGrid grid_;
+    std::vector<float> steerX_;
+    std::vector<float> steerY_;
+    std::vector<Chunk> chunks_;
+
+    float padding_ = 4.0f;
+    bool isParallel_ = true;
+
+    void ComputeRange(Chunk& chunk, const float* xs, const float* ys, const float* radii);
+};
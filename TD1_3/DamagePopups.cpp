@@ -0,0 +1,176 @@
+﻿#include "DamagePopups.h"
+#include "Camera2D.h"
+#include "SimulationClock.h"
+#include "Random.h"
+#include <Novice.h>
+#include <cmath>
+
+bool DamagePopupManager::SetFont(const FontAtlas& atlas) {
+    textureHandle_ = atlas.GetTextureHandle();
+    texW_ = atlas.GetTexW();
+    texH_ = atlas.GetTexH();
+    lineHeight_ = atlas.GetLineHeight();
+
+    // 0～9 のグリフを写す（描画中にアトラスの検索をしない）
+    bool hasAllDigits = true;
+    for (int digit = 0; digit < 10; ++digit) {
+        const Glyph* glyph = atlas.GetGlyph('0' + digit);
+        digitGlyphs_[digit] = glyph ? *glyph : Glyph{};
+        hasAllDigits = hasAllDigits && glyph != nullptr;
+    }
+
+    hasFont_ = hasAllDigits && textureHandle_ > 0 && texW_ > 0 && texH_ > 0;
+
+    for (int value = 0; value < kCachedValueCount; ++value) {
+        BuildRun(value, runs_[value]);
+    }
+    return hasFont_;
+}
+
+void DamagePopupManager::BuildRun(int value, GlyphRun& run) const {
+    run = {};
+
+    // 下の桁から取り出して、上の桁から並べ直す
+    uint8_t reversed[kMaxDigits] = {};
+    unsigned int rest = value > 0 ? static_cast<unsigned int>(value) : 0u;
+    do {
+        reversed[run.count++] = static_cast<uint8_t>(rest % 10u);
+        rest /= 10u;
+    } while (rest > 0 && run.count < kMaxDigits);
+
+    int penX = 0;
+    for (uint8_t i = 0; i < run.count; ++i) {
+        const uint8_t digit = reversed[run.count - 1 - i];
+        run.digits[i] = digit;
+        run.offsetX[i] = static_cast<int16_t>(penX + digitGlyphs_[digit].xoffset);
+        penX += digitGlyphs_[digit].xadvance;
+    }
+    run.width = static_cast<int16_t>(penX);
+}
+
+void DamagePopupManager::Spawn(const Vector2& position, int value, bool isCritical) {
+    if (!isEnabled_) return;
+
+    // 満杯なら一番古いものを捨てて場所を空ける
+    if (count_ == kCapacity) {
+        head_ = (head_ + 1) & kIndexMask;
+        --count_;
+    }
+
+    const size_t index = (head_ + count_) & kIndexMask;
+    ++count_;
+
+    // 同じ敵に続けて当たっても重ならないよう、横に少し散らす
+    const float spread = Rng(RandomStreamId::Visual).RandomFloat(-kSpreadSpeed, kSpreadSpeed);
+
+    posX_[index] = position.x;
+    posY_[index] = position.y;
+    prevX_[index] = position.x;
+    prevY_[index] = position.y;
+    velX_[index] = spread;
+    velY_[index] = kRiseSpeed;
+    age_[index] = 0.0f;
+    value_[index] = value > 0 ? value : 0;
+    isCritical_[index] = isCritical ? 1 : 0;
+    scale_[index] = 1.0f + kPopScale;
+    alpha_[index] = 0xFF;
+}
+
+void DamagePopupManager::Update(float deltaTime) {
+    // 位置・経過時間と、描画用の大きさ・濃さをまとめて進める
+    for (size_t i = 0; i < count_; ++i) {
+        const size_t index = (head_ + i) & kIndexMask;
+
+        prevX_[index] = posX_[index];
+        prevY_[index] = posY_[index];
+        posX_[index] += velX_[index] * deltaTime;
+        posY_[index] += velY_[index] * deltaTime;
+        velY_[index] += kGravity * deltaTime;
+
+        const float age = age_[index] + deltaTime;
+        age_[index] = age;
+
+        const float pop = age < kPopDuration ? 1.0f - age / kPopDuration : 0.0f;
+        scale_[index] = 1.0f + kPopScale * pop;
+
+        float fade = 1.0f;
+        if (age > kFadeStart) {
+            fade = 1.0f - (age - kFadeStart) / (kLifeTime - kFadeStart);
+            if (fade < 0.0f) fade = 0.0f;
+        }
+        alpha_[index] = static_cast<uint8_t>(fade * 255.0f);
+    }
+
+    // 寿命はどれも同じなので、古い方から順に寿命が来たものを消す
+    while (count_ > 0 && age_[head_] >= kLifeTime) {
+        head_ = (head_ + 1) & kIndexMask;
+        --count_;
+    }
+}
+
+void DamagePopupManager::Draw(const Camera2D& camera) const {
+    if (!hasFont_ || count_ == 0) return;
+
+    Vector2 viewMin;
+    Vector2 viewMax;
+    camera.GetVisibleWorldRect(viewMin, viewMax);
+
+    const Affine2x3& vp = camera.GetVpVpAffine();
+    const float interpolation = SimulationClock::GetInstance().GetInterpolationAlpha();
+    // ワールドの1pxが画面で何pxになるか（ズームに合わせて数字も拡大縮小する）
+    const float worldToScreen = std::sqrt(vp.m00 * vp.m00 + vp.m01 * vp.m01);
+
+    // 画面外の判定に使う余白（数字の大きさの目安）
+    const float margin = static_cast<float>(lineHeight_) * kCriticalTextScale * (1.0f + kPopScale);
+
+    GlyphRun overflowRun;
+    for (size_t i = 0; i < count_; ++i) {
+        const size_t index = (head_ + i) & kIndexMask;
+
+        const float x = prevX_[index] + (posX_[index] - prevX_[index]) * interpolation;
+        const float y = prevY_[index] + (posY_[index] - prevY_[index]) * interpolation;
+        if (x < viewMin.x - margin || x > viewMax.x + margin ||
+            y < viewMin.y - margin || y > viewMax.y + margin) {
+            continue;
+        }
+
+        const int value = value_[index];
+        const GlyphRun* run = &overflowRun;
+        if (value < kCachedValueCount) {
+            run = &runs_[value];
+        }
+        else {
+            BuildRun(value, overflowRun);
+        }
+
+        const bool isCritical = isCritical_[index] != 0;
+        const float scale = (isCritical ? kCriticalTextScale : kTextScale) * scale_[index] * worldToScreen;
+        const unsigned int color = (isCritical ? kCriticalColor : kNormalColor) | alpha_[index];
+
+        // 数字の並びの中心を出す位置に合わせる
+        const Vector2 center = vp.Transform({ x, y });
+        const float left = center.x - static_cast<float>(run->width) * scale * 0.5f;
+        const float top = center.y - static_cast<float>(lineHeight_) * scale * 0.5f;
+
+        for (uint8_t d = 0; d < run->count; ++d) {
+            const Glyph& glyph = digitGlyphs_[run->digits[d]];
+            if (glyph.w <= 0 || glyph.h <= 0) continue;
+
+            Novice::DrawSpriteRect(
+                static_cast<int>(left + static_cast<float>(run->offsetX[d]) * scale),
+                static_cast<int>(top + static_cast<float>(glyph.yoffset) * scale),
+                glyph.x, glyph.y, glyph.w, glyph.h,
+                textureHandle_,
+                static_cast<float>(glyph.w) * scale / static_cast<float>(texW_),
+                static_cast<float>(glyph.h) * scale / static_cast<float>(texH_),
+                0.0f,
+                color
+            );
+        }
+    }
+}
+
+void DamagePopupManager::Clear() {
+    head_ = 0;
+    count_ = 0;
+}
@@ -0,0 +1,122 @@
+﻿#pragma once
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include "Vector2.h"
+#include "FontAtlas.h"
+
+class Camera2D; // 前方宣言
+
+/// <summary>
+/// 敵に当たった時に出るダメージ数字をまとめて管理するクラス
+/// 決まった数のリングバッファに位置・速度・経過時間を配列で持ち、動きと薄れ方は Update でまとめて計算する
+/// 寿命はどれも同じなので古いものから順に消え、満杯の時は一番古いものを上書きする
+/// 数字の並び（どのグリフをどこに置くか）は SetFont の時に値ごとに作っておき、描画中に文字列やグリフの検索をしない
+/// </summary>
+class DamagePopupManager {
+public:
+    // 同時に出せる数（2のべき乗。超えたら古いものから上書き）
+    static constexpr size_t kCapacity = 512;
+
+    // 並びを作っておく値の範囲（これ以上の値は描画時にその場で作る）
+    static constexpr int kCachedValueCount = 1000;
+
+    DamagePopupManager() = default;
+    ~DamagePopupManager() = default;
+
+    /// <summary>
+    /// 数字の描画に使うフォントを設定する（0～9 のグリフと値ごとの並びをここで作る）
+    /// グリフとテクスチャの情報は写し取るので、atlas はこの後破棄してもよい
+    /// </summary>
+    /// <returns>数字のグリフが揃っていて描画できるか</returns>
+    bool SetFont(const FontAtlas& atlas);
+
+    /// <summary>
+    /// ダメージ数字を1つ出す
+    /// </summary>
+    /// <param name="position">出す位置（ワールド座標。数字の中心）</param>
+    /// <param name="value">表示する値（負の値は0）</param>
+    /// <param name="isCritical">クリティカルなら大きく黄色で出す</param>
+    void Spawn(const Vector2& position, int value, bool isCritical);
+
+    /// <summary>
+    /// 全ての数字を1ステップ動かし、寿命が来たものを消す
+    /// </summary>
+    void Update(float deltaTime);
+
+    /// <summary>
+    /// カメラに映る数字を描画する（フォントが無ければ何もしない）
+    /// </summary>
+    void Draw(const Camera2D& camera) const;
+
+    void Clear();
+
+    void SetEnabled(bool isEnabled) { isEnabled_ = isEnabled; }
+    bool IsEnabled() const { return isEnabled_; }
+
+    size_t GetActiveCount() const { return count_; }
+
+private:
+    static constexpr size_t kIndexMask = kCapacity - 1;
+    static_assert((kCapacity & kIndexMask) == 0, "DamagePopupManager: kCapacity must be a power of two");
+
+    // int の最大桁数
+    static constexpr int kMaxDigits = 10;
+
+    // 動き（秒・px/s・px/s^2）
+    static constexpr float kLifeTime = 0.6f;
+    static constexpr float kRiseSpeed = -120.0f;
+    static constexpr float kGravity = 240.0f;
+    static constexpr float kSpreadSpeed = 30.0f;
+    static constexpr float kFadeStart = 0.35f;   // ここから寿命まで薄れる
+    static constexpr float kPopDuration = 0.1f;  // 出た直後に大きく見せる時間
+    static constexpr float kPopScale = 0.6f;     // 出た直後の拡大分
+
+    // フォントに対する大きさ（通常・クリティカル）
+    static constexpr float kTextScale = 0.45f;
+    static constexpr float kCriticalTextScale = 0.7f;
+
+    static constexpr unsigned int kNormalColor = 0xFFFFFF00;
+    static constexpr unsigned int kCriticalColor = 0xFFDD3300;
+
+    // 値1つ分の数字の並び（左端からの位置は拡大前のフォントのピクセル）
+    struct GlyphRun {
+        uint8_t count = 0;
+        uint8_t digits[kMaxDigits] = {};
+        int16_t offsetX[kMaxDigits] = {};
+        int16_t width = 0;
+    };
+
+    // 数字のグリフ（フォントから写したもの）
+    std::array<Glyph, 10> digitGlyphs_{};
+    int textureHandle_ = -1;
+    int texW_ = 0;
+    int texH_ = 0;
+    int lineHeight_ = 0;
+    bool hasFont_ = false;
+
+    // 値ごとの並び
+    std::array<GlyphRun, kCachedValueCount> runs_{};
+
+    // リングバッファ（head_ が一番古いもの）
+    std::array<float, kCapacity> posX_{};
+    std::array<float, kCapacity> posY_{};
+    std::array<float, kCapacity> prevX_{};
+    std::array<float, kCapacity> prevY_{};
+    std::array<float, kCapacity> velX_{};
+    std::array<float, kCapacity> velY_{};
+    std::array<float, kCapacity> age_{};
+    std::array<int, kCapacity> value_{};
+    std::array<uint8_t, kCapacity> isCritical_{};
+
+    // Update でまとめて計算する描画用の値
+    std::array<float, kCapacity> scale_{};
+    std::array<uint8_t, kCapacity> alpha_{};
+
+    size_t head_ = 0;
+    size_t count_ = 0;
+    bool isEnabled_ = true;
+
+    // 値の並びを作る（文字列を作らず、下の桁から割って求める）
+    void BuildRun(int value, GlyphRun& run) const;
+};
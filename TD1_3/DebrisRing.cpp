@@ -0,0 +1,219 @@
+﻿#include "DebrisRing.h"
+#include <cmath>
+#include "Random.h"
+#include "WorldSnapshot.h"
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#include <emmintrin.h>
+#define DEBRIS_RING_USE_SSE
+#endif
+
+void DebrisRing::Add(const Vector2& position) {
+    dirX_.push_back(1.0f);
+    dirY_.push_back(0.0f);
+    angleOffset_.push_back(0.0f);
+    distNoise_.push_back(static_cast<float>(Rng(RandomStreamId::Gameplay).RandomInt(-20, 19)));
+
+    posX_.push_back(position.x);
+    posY_.push_back(position.y);
+    targetX_.push_back(position.x);
+    targetY_.push_back(position.y);
+}
+
+void DebrisRing::RemoveLast() {
+    if (posX_.empty()) return;
+    dirX_.pop_back();
+    dirY_.pop_back();
+    angleOffset_.pop_back();
+    distNoise_.pop_back();
+    posX_.pop_back();
+    posY_.pop_back();
+    targetX_.pop_back();
+    targetY_.pop_back();
+}
+
+void DebrisRing::Clear() {
+    dirX_.clear();
+    dirY_.clear();
+    angleOffset_.clear();
+    distNoise_.clear();
+    posX_.clear();
+    posY_.clear();
+    targetX_.clear();
+    targetY_.clear();
+}
+
+void DebrisRing::Reserve(size_t count) {
+    dirX_.reserve(count);
+    dirY_.reserve(count);
+    angleOffset_.reserve(count);
+    distNoise_.reserve(count);
+    posX_.reserve(count);
+    posY_.reserve(count);
+    targetX_.reserve(count);
+    targetY_.reserve(count);
+}
+
+void DebrisRing::SaveState(SnapshotWriter& writer) const {
+    writer.WriteArray(dirX_);
+    writer.WriteArray(dirY_);
+    writer.WriteArray(angleOffset_);
+    writer.WriteArray(distNoise_);
+    writer.WriteArray(posX_);
+    writer.WriteArray(posY_);
+    writer.WriteArray(targetX_);
+    writer.WriteArray(targetY_);
+    writer.Write(stepsSinceResync_);
+}
+
+bool DebrisRing::LoadState(SnapshotReader& reader) {
+    reader.ReadArray(dirX_);
+    reader.ReadArray(dirY_);
+    reader.ReadArray(angleOffset_);
+    reader.ReadArray(distNoise_);
+    reader.ReadArray(posX_);
+    reader.ReadArray(posY_);
+    reader.ReadArray(targetX_);
+    reader.ReadArray(targetY_);
+    reader.Read(stepsSinceResync_);
+
+    // 配列の長さが揃っていなければ失敗（空にして不正な添字を防ぐ）
+    const size_t count = posX_.size();
+    const bool isConsistent = dirX_.size() == count && dirY_.size() == count &&
+        angleOffset_.size() == count && distNoise_.size() == count &&
+        posY_.size() == count && targetX_.size() == count && targetY_.size() == count;
+    if (!reader.IsOk() || !isConsistent) {
+        Clear();
+        return false;
+    }
+    return true;
+}
+
+void DebrisRing::Redistribute(float rotationAngle) {
+    const size_t count = Size();
+    const float step = count > 0 ? 6.2831853f / static_cast<float>(count) : 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        angleOffset_[i] = static_cast<float>(i) * step;
+    }
+    Resync(rotationAngle);
+}
+
+void DebrisRing::Resync(float rotationAngle) {
+    for (size_t i = 0; i < dirX_.size(); ++i) {
+        const float angle = angleOffset_[i] + rotationAngle;
+        dirX_[i] = std::cos(angle);
+        dirY_[i] = std::sin(angle);
+    }
+    stepsSinceResync_ = 0;
+}
+
+void DebrisRing::Update(float deltaTime, const Vector2* anchor, float radius, float rotationAngle, float rotationDelta) {
+    if (posX_.empty()) return;
+
+    // 1. 前ステップの目標へ遅れて追従（慣性）
+    Follow(deltaTime);
+
+    // 2. 輪を回す（全員同じ角度なので cos/sin はここで1回だけ）
+    if (++stepsSinceResync_ >= kResyncInterval) {
+        Resync(rotationAngle);
+    }
+    else {
+        Rotate(std::cos(rotationDelta), std::sin(rotationDelta));
+    }
+
+    // 3. 次の目標位置（アンカーが消えていたら直前の目標を保つ）
+    if (anchor) {
+        UpdateTargets(*anchor, radius);
+    }
+}
+
+void DebrisRing::Follow(float deltaTime) {
+    const size_t count = posX_.size();
+    const float factor = kFollowRate * deltaTime;
+    const float warpSq = kWarpDistance * kWarpDistance;
+    size_t i = 0;
+
+#ifdef DEBRIS_RING_USE_SSE
+    const __m128 vFactor = _mm_set1_ps(factor);
+    const __m128 vWarpSq = _mm_set1_ps(warpSq);
+
+    for (; i + 4 <= count; i += 4) {
+        const __m128 px = _mm_loadu_ps(&posX_[i]);
+        const __m128 py = _mm_loadu_ps(&posY_[i]);
+        const __m128 tx = _mm_loadu_ps(&targetX_[i]);
+        const __m128 ty = _mm_loadu_ps(&targetY_[i]);
+
+        const __m128 dx = _mm_sub_ps(tx, px);
+        const __m128 dy = _mm_sub_ps(ty, py);
+        const __m128 followX = _mm_add_ps(px, _mm_mul_ps(dx, vFactor));
+        const __m128 followY = _mm_add_ps(py, _mm_mul_ps(dy, vFactor));
+
+        // 離れすぎていたら目標へワープ（テレポート対策）
+        const __m128 isFar = _mm_cmpgt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), vWarpSq);
+        _mm_storeu_ps(&posX_[i], _mm_or_ps(_mm_and_ps(isFar, tx), _mm_andnot_ps(isFar, followX)));
+        _mm_storeu_ps(&posY_[i], _mm_or_ps(_mm_and_ps(isFar, ty), _mm_andnot_ps(isFar, followY)));
+    }
+#endif
+
+    // 残り（SSEが使えない環境では全件）
+    for (; i < count; ++i) {
+        const float dx = targetX_[i] - posX_[i];
+        const float dy = targetY_[i] - posY_[i];
+        if (dx * dx + dy * dy > warpSq) {
+            posX_[i] = targetX_[i];
+            posY_[i] = targetY_[i];
+        }
+        else {
+            posX_[i] += dx * factor;
+            posY_[i] += dy * factor;
+        }
+    }
+}
+
+void DebrisRing::Rotate(float cosDelta, float sinDelta) {
+    // (x + yi) * (cos + sin i)
+    const size_t count = dirX_.size();
+    size_t i = 0;
+
+#ifdef DEBRIS_RING_USE_SSE
+    const __m128 c = _mm_set1_ps(cosDelta);
+    const __m128 s = _mm_set1_ps(sinDelta);
+
+    for (; i + 4 <= count; i += 4) {
+        const __m128 x = _mm_loadu_ps(&dirX_[i]);
+        const __m128 y = _mm_loadu_ps(&dirY_[i]);
+        _mm_storeu_ps(&dirX_[i], _mm_sub_ps(_mm_mul_ps(x, c), _mm_mul_ps(y, s)));
+        _mm_storeu_ps(&dirY_[i], _mm_add_ps(_mm_mul_ps(x, s), _mm_mul_ps(y, c)));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        const float x = dirX_[i];
+        const float y = dirY_[i];
+        dirX_[i] = x * cosDelta - y * sinDelta;
+        dirY_[i] = x * sinDelta + y * cosDelta;
+    }
+}
+
+void DebrisRing::UpdateTargets(const Vector2& anchor, float radius) {
+    const size_t count = dirX_.size();
+    size_t i = 0;
+
+#ifdef DEBRIS_RING_USE_SSE
+    const __m128 ax = _mm_set1_ps(anchor.x);
+    const __m128 ay = _mm_set1_ps(anchor.y);
+    const __m128 r = _mm_set1_ps(radius);
+
+    for (; i + 4 <= count; i += 4) {
+        const __m128 dist = _mm_add_ps(r, _mm_loadu_ps(&distNoise_[i]));
+        _mm_storeu_ps(&targetX_[i], _mm_add_ps(ax, _mm_mul_ps(_mm_loadu_ps(&dirX_[i]), dist)));
+        _mm_storeu_ps(&targetY_[i], _mm_add_ps(ay, _mm_mul_ps(_mm_loadu_ps(&dirY_[i]), dist)));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        const float dist = radius + distNoise_[i];
+        targetX_[i] = anchor.x + dirX_[i] * dist;
+        targetY_[i] = anchor.y + dirY_[i] * dist;
+    }
+}
@@ -0,0 +1,83 @@
+﻿#pragma once
+#include <vector>
+#include <cstddef>
+#include "Vector2.h"
+
+class SnapshotWriter;
+class SnapshotReader;
+
+/// <summary>
+/// プレイヤーの周りを回るがれきの輪をまとめて計算するクラス
+/// 各がれきの向き（単位ベクトル）を配列で持ち、毎フレーム「回転角の差分」の複素数を1回掛けて回す
+/// （がれきごとの cos/sin は、誤差をならすための定期的な作り直しの時だけ）
+/// 目標位置への追従（慣性）も4個ずつSIMDで計算する
+/// </summary>
+class DebrisRing {
+public:
+    DebrisRing() = default;
+    ~DebrisRing() = default;
+
+    /// <summary>
+    /// がれきを1つ末尾に追加する（個体差はランダム。並びは Redistribute で整える）
+    /// </summary>
+    /// <param name="position">初期位置</param>
+    void Add(const Vector2& position);
+
+    /// <summary>
+    /// 末尾のがれきを取り除く
+    /// </summary>
+    void RemoveLast();
+
+    void Clear();
+    void Reserve(size_t count);
+    size_t Size() const { return posX_.size(); }
+
+    /// <summary>
+    /// 全がれきを円周上に等間隔に並べ直す（個数を変えた後に呼ぶ）
+    /// </summary>
+    /// <param name="rotationAngle">現在の輪の回転角</param>
+    void Redistribute(float rotationAngle);
+
+    /// <summary>
+    /// 1ステップ進める
+    /// 前ステップの目標へ追従させてから、輪を rotationDelta だけ回して次の目標を作る
+    /// </summary>
+    /// <param name="deltaTime">経過時間</param>
+    /// <param name="anchor">輪の中心（nullptrなら目標を更新しない）</param>
+    /// <param name="radius">輪の半径</param>
+    /// <param name="rotationAngle">回した後の輪の回転角（定期的な作り直しに使う）</param>
+    /// <param name="rotationDelta">このステップで回す角度</param>
+    void Update(float deltaTime, const Vector2* anchor, float radius, float rotationAngle, float rotationDelta);
+
+    const float* GetPositionX() const { return posX_.data(); }
+    const float* GetPositionY() const { return posY_.data(); }
+    Vector2 GetPosition(size_t index) const { return { posX_[index], posY_[index] }; }
+
+    // 配列の保存・復元（リトライ用。個体差も含めてそのまま写す）
+    void SaveState(SnapshotWriter& writer) const;
+    bool LoadState(SnapshotReader& reader);
+
+private:
+    // 何ステップごとに向きを cos/sin で作り直すか（回転の掛け算で溜まる誤差をならす）
+    static constexpr int kResyncInterval = 240;
+
+    // 追従の速さ（1秒あたり）と、これ以上離れたら目標へワープする距離
+    static constexpr float kFollowRate = 10.0f;
+    static constexpr float kWarpDistance = 500.0f;
+
+    // 輪の上での向き（angleOffset + 回転角 の cos / sin）
+    std::vector<float> dirX_, dirY_;
+    std::vector<float> angleOffset_;
+    std::vector<float> distNoise_; // 半径の個体差
+
+    // 実際の位置と、追従先の目標位置
+    std::vector<float> posX_, posY_;
+    std::vector<float> targetX_, targetY_;
+
+    int stepsSinceResync_ = 0;
+
+    void Resync(float rotationAngle);
+    void Follow(float deltaTime);
+    void Rotate(float cosDelta, float sinDelta);
+    void UpdateTargets(const Vector2& anchor, float radius);
+};
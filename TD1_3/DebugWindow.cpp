@@ -3,6 +3,7 @@
 #include "Player.h"
 #include "Easing.h"
 #include "ParticleManager.h"
+#include "GameObjectManager.h"
 
 #ifdef _DEBUG
 #include <imgui.h>
@@ -21,6 +22,7 @@ void DebugWindow::DrawDebugGui() {
 	ImGui::Checkbox("Show Camera Debug", &showCameraWindow_);
 	ImGui::Checkbox("Show Player Debug", &showPlayerWindow_);
 	ImGui::Checkbox("Show Particle Debug", &showParticleWindow_);
+	ImGui::Checkbox("Show Object Activity", &showObjectActivityWindow_);
 
 	ImGui::End();
 #endif
@@ -861,4 +863,62 @@ void DebugWindow::DrawParticleDebugWindow(ParticleManager* particleManager, Play
 
 	ImGui::End();
 #endif
-}
\ No newline at end of file
+}
+
+
+// ========================================
+// オブジェクト更新状況ウィンドウ
+// ========================================
+void DebugWindow::DrawObjectActivityDebugWindow(const GameObjectManager* objectManager) {
+	objectManager;
+#ifdef _DEBUG
+	if (!objectManager || !showObjectActivityWindow_) return;
+
+	ImGui::Begin("Object Activity", &showObjectActivityWindow_);
+
+	const ObjectActivityStats& stats = objectManager->GetActivityStats();
+
+	ImGui::Text("Total: %d", stats.total);
+	ImGui::Separator();
+
+	ImGui::Text("=== Sleep ===");
+	ImGui::Text("Awake: %d", stats.awake);
+	ImGui::Text("Sleeping: %d", stats.sleeping);
+
+	ImGui::Separator();
+
+	ImGui::Text("=== Activity Tier ===");
+	ImGui::Text("Updated: %d", stats.updated);
+	ImGui::Text("Throttled: %d", stats.throttled);
+	ImGui::BulletText("Near: %d", stats.nearCount);
+	ImGui::BulletText("Middle: %d", stats.middleCount);
+	ImGui::BulletText("Far: %d", stats.farCount);
+
+	ImGui::Separator();
+
+	const DrawListStats& drawStats = objectManager->GetDrawStats();
+	ImGui::Text("=== Draw ===");
+	ImGui::Text("Drawn: %d / %d", drawStats.drawn, drawStats.registered);
+	ImGui::Text("Culled: %d", drawStats.culled);
+	ImGui::Text("Sort: %s (moved %d)", drawStats.usedRadixSort ? "Radix" : "Insertion", drawStats.moved);
+
+	ImGui::Separator();
+
+	// タグ別一覧から数えるので全オブジェクトは走査しない
+	const TagRegistry& tags = TagRegistry::GetInstance();
+	ImGui::Text("=== Tags ===");
+	for (size_t i = 0; i < tags.GetTagCount(); ++i) {
+		const TagId tag = static_cast<TagId>(i);
+		if (objectManager->CountWithTag(tag) == 0) continue;
+
+		int sleeping = 0;
+		objectManager->ForEachWithTag(tag, [&sleeping](GameObject2D* obj) {
+			if (obj->IsSleeping()) ++sleeping;
+		});
+		ImGui::BulletText("%s: %d (sleeping %d)", tags.GetName(tag).c_str(),
+			static_cast<int>(objectManager->CountWithTag(tag)), sleeping);
+	}
+
+	ImGui::End();
+#endif
+}
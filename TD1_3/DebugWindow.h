@@ -4,6 +4,7 @@
 class Camera2D;
 class Player;
 class ParticleManager;
+class GameObjectManager;
 
 /// <summary>
 /// 統合デバッグウィンドウ
@@ -34,6 +35,11 @@ public:
 	// ========================================
 	void DrawParticleDebugWindow(ParticleManager* particleManager, Player* player = nullptr);
 
+	// ========================================
+	// オブジェクト更新状況GUI（スリープ・間引き）
+	// ========================================
+	void DrawObjectActivityDebugWindow(const GameObjectManager* objectManager);
+
 private:
 	// カメラデバッグモードの状態
 	bool cameraDebugMode_ = false;
@@ -51,5 +57,8 @@ private:
 	bool showActiveParticles_ = true;
 	bool showParticleParams_ = false;
 
+	// オブジェクト更新状況の表示
+	bool showObjectActivityWindow_ = true;
+
 
 };
\ No newline at end of file
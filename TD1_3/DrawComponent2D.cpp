@@ -177,31 +177,20 @@ void DrawComponent2D::Update(float deltaTime) {
 
 // ========== 描画 ==========
 void DrawComponent2D::Draw(const Camera2D& camera) {
-	Matrix3x3 vpMatrix = camera.GetVpVpMatrix();
+	const Affine2x3& vpMatrix = camera.GetVpVpAffine();
 
-	// カメラのY軸反転設定を確認してスケールを調整
-	if (camera.IsWorldYUp()) {
-		// Y軸反転が有効な場合、スケールのY成分を反転
-		Vector2 originalScale = transform_.scale;
-		transform_.scale.y *= -1.0f;
-
-		DrawInternal(&vpMatrix);
-
-		// スケールを元に戻す
-		transform_.scale = originalScale;
-	}
-	else {
-		DrawInternal(&vpMatrix);
-	}
+	// カメラのY軸反転設定はスケールを書き換えずに行列側で反映する
+	// （スケールを触るとTransform2Dの行列キャッシュが毎回無効になるため）
+	DrawInternal(&vpMatrix, camera.IsWorldYUp());
 }
 
 void DrawComponent2D::DrawWorld() {
-	DrawInternal(nullptr);
+	DrawInternal(nullptr, false);
 }
 
 void DrawComponent2D::DrawScreen() {
 	// スクリーン座標用の変換（Y軸反転なし）
-	DrawInternal(nullptr);
+	DrawInternal(nullptr, false);
 }
 
 void DrawComponent2D::Initialize() {
@@ -214,7 +203,7 @@ void DrawComponent2D::Initialize() {
 	effect_.StopAll();
 }
 
-void DrawComponent2D::DrawInternal(const Matrix3x3* vpMatrix) {
+void DrawComponent2D::DrawInternal(const Affine2x3* vpMatrix, bool flipWorldY) {
 	if (graphHandle_ < 0) return;
 
 	// 1. ソース矩形（テクスチャのどこを読むか）を計算
@@ -255,17 +244,27 @@ void DrawComponent2D::DrawInternal(const Matrix3x3* vpMatrix) {
 
 	// --- ここから下は変更なし（行列計算など） ---
 
+	// 親子付けされていない時はSRTが変わった場合だけ行列を作り直す
+	// （親子付けされている時はGameObject2D側で親の行列を掛け終わっている）
+	if (!transform_.hasParent) {
+		transform_.CalculateWorldMatrix();
+	}
+
 	// エフェクト適用後の変換行列を取得
-	Matrix3x3 worldMatrix = GetFinalTransformMatrix();
-	Matrix3x3 finalMatrix = worldMatrix;
-	if (vpMatrix) {
-		finalMatrix = Matrix3x3::Multiply(worldMatrix, *vpMatrix);
+	Affine2x3 worldMatrix = Affine2x3::FromMatrix(GetFinalTransformMatrix());
+	if (flipWorldY) {
+		// スケールのY成分を反転したのと同じ（Y軸の行だけ符号を反転）
+		worldMatrix.m10 = -worldMatrix.m10;
+		worldMatrix.m11 = -worldMatrix.m11;
 	}
 
-	// 変換行列を適用
+	// 変換行列を適用（カメラがあればワールド × ビュープロジェクションをまとめてから4頂点を変換）
 	Vector2 screenVertices[4];
-	for (int i = 0; i < 4; ++i) {
-		screenVertices[i] = Matrix3x3::Transform(localVertices[i], finalMatrix);
+	if (vpMatrix) {
+		Affine2x3::TransformQuad(worldMatrix, *vpMatrix, localVertices, screenVertices);
+	}
+	else {
+		worldMatrix.TransformQuad(localVertices, screenVertices);
 	}
 
 	// 反転処理
@@ -295,6 +294,26 @@ void DrawComponent2D::DrawInternal(const Matrix3x3* vpMatrix) {
 // ========== 内部処理 ==========
 
 Matrix3x3 DrawComponent2D::GetFinalTransformMatrix() const {
+	const Vector2 offset = effect_.GetPositionOffset();
+	const Vector2 effectScale = effect_.GetScaleMultiplier();
+	const float effectRotation = effect_.GetRotationOffset();
+
+	// エフェクトが掛かっていなければキャッシュ済みのワールド行列をそのまま使う
+	if (offset.x == 0.0f && offset.y == 0.0f &&
+		effectScale.x == 1.0f && effectScale.y == 1.0f && effectRotation == 0.0f) {
+		return transform_.worldMatrix;
+	}
+
+	// 親子付けされている場合はワールド行列の手前にエフェクト分の変形を挟む
+	if (transform_.hasParent) {
+		Matrix3x3 result = Matrix3x3::Multiply(
+			AffineMatrix2D::MakeAffine(effectScale, effectRotation, { 0.0f, 0.0f }),
+			transform_.worldMatrix);
+		result.m[2][0] += offset.x;
+		result.m[2][1] += offset.y;
+		return result;
+	}
+
 	Vector2 finalPos = GetFinalPosition();
 	Vector2 finalScale = GetFinalScale();
 	float finalRotation = GetFinalRotation();
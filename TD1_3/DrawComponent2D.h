@@ -106,7 +106,9 @@ public:
 	/// <summary>
 	/// Y軸反転描画
 	/// </summary>
-	void DrawInternal(const Matrix3x3* vpMatrix);
+	/// <param name="vpMatrix">ビュープロジェクション行列（nullptrなら変換しない）</param>
+	/// <param name="flipWorldY">ワールドのY軸を反転して描くか</param>
+	void DrawInternal(const Affine2x3* vpMatrix, bool flipWorldY);
 
 	// クロップ率の設定 (0.0f:非表示 ～ 1.0f:全表示)
 	void SetCropRatio(float ratio) { cropRatio_ = std::clamp(ratio, 0.0f, 1.0f); }
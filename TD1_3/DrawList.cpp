@@ -0,0 +1,210 @@
+﻿#include "DrawList.h"
+#include "GameObject2D.h"
+#include "Camera2D.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    // 符号付き16bitを、大小関係を保ったまま符号なしに直す
+    uint64_t ToOrderedBits(int16_t value) {
+        return static_cast<uint16_t>(value) ^ 0x8000u;
+    }
+
+    // floatを、大小関係を保ったまま符号なし32bitに直す（負数は全ビット反転、正数は符号ビットを立てる）
+    uint64_t ToOrderedBits(float value) {
+        uint32_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+    }
+}
+
+void DrawList::Add(GameObject2D* obj) {
+    if (!obj || obj->drawListSlot_ >= 0) return;
+
+    obj->drawListSlot_ = static_cast<int>(entries_.size());
+    entries_.push_back({ 0, obj });
+    ++addedSinceSort_;
+}
+
+void DrawList::Remove(GameObject2D* obj) {
+    if (!obj || obj->drawListSlot_ < 0) return;
+
+    entries_[obj->drawListSlot_].object = nullptr;
+    obj->drawListSlot_ = -1;
+    ++removedCount_;
+
+    // Prepare後、Submit前（描画中）に外されたものは描かない
+    if (!visible_.empty()) {
+        std::replace(visible_.begin(), visible_.end(), obj, static_cast<GameObject2D*>(nullptr));
+    }
+}
+
+void DrawList::Clear() {
+    for (const Entry& entry : entries_) {
+        if (entry.object) {
+            entry.object->drawListSlot_ = -1;
+        }
+    }
+    entries_.clear();
+    visible_.clear();
+    removedCount_ = 0;
+    addedSinceSort_ = 0;
+}
+
+uint64_t DrawList::MakeKey(const GameObject2D& obj, bool isWorldYUp) {
+    // 上位16bit: レイヤー / 中央32bit: Y座標（ySortのときのみ） / 下位16bit: サブ順
+    const DrawOrder& order = obj.drawOrder_;
+    uint64_t key = ToOrderedBits(order.layer) << 48;
+    if (order.ySort) {
+        // 画面の下にあるものほど手前（Y上向きのワールドではYが小さいほど下）
+        const float y = obj.GetDrawPosition().y;
+        key |= ToOrderedBits(isWorldYUp ? -y : y) << 16;
+    }
+    key |= ToOrderedBits(order.subOrder);
+    return key;
+}
+
+void DrawList::Compact() {
+    if (removedCount_ == 0) return;
+
+    // 順番を保ったまま空き枠を詰める
+    size_t write = 0;
+    for (size_t read = 0; read < entries_.size(); ++read) {
+        if (entries_[read].object) {
+            entries_[write++] = entries_[read];
+        }
+    }
+    entries_.resize(write);
+    removedCount_ = 0;
+}
+
+bool DrawList::InsertionSort(size_t maxMoves) {
+    size_t moves = 0;
+    for (size_t i = 1; i < entries_.size(); ++i) {
+        if (entries_[i - 1].key <= entries_[i].key) continue;
+
+        // 自分より大きいキーだけを後ろへずらす（同じキーは追い越さないので安定）
+        const Entry current = entries_[i];
+        size_t j = i;
+        while (j > 0 && entries_[j - 1].key > current.key) {
+            entries_[j] = entries_[j - 1];
+            --j;
+        }
+        entries_[j] = current;
+
+        moves += i - j;
+        if (moves > maxMoves) {
+            stats_.moved = static_cast<int>(moves);
+            return false;
+        }
+    }
+    stats_.moved = static_cast<int>(moves);
+    return true;
+}
+
+void DrawList::RadixSort() {
+    // 8bitずつ8パスのLSD基数ソート。全要素で同じ値の桁は飛ばす
+    constexpr int kPasses = 8;
+    size_t counts[kPasses][256] = {};
+    for (const Entry& entry : entries_) {
+        for (int pass = 0; pass < kPasses; ++pass) {
+            ++counts[pass][(entry.key >> (pass * 8)) & 0xFF];
+        }
+    }
+
+    scratch_.resize(entries_.size());
+    for (int pass = 0; pass < kPasses; ++pass) {
+        size_t* count = counts[pass];
+        const size_t firstDigit = (entries_[0].key >> (pass * 8)) & 0xFF;
+        if (count[firstDigit] == entries_.size()) continue;
+
+        size_t offset = 0;
+        for (int digit = 0; digit < 256; ++digit) {
+            const size_t c = count[digit];
+            count[digit] = offset;
+            offset += c;
+        }
+        for (const Entry& entry : entries_) {
+            scratch_[count[(entry.key >> (pass * 8)) & 0xFF]++] = entry;
+        }
+        entries_.swap(scratch_);
+    }
+}
+
+void DrawList::RefreshSlots() {
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        entries_[i].object->drawListSlot_ = static_cast<int>(i);
+    }
+}
+
+void DrawList::Sort(bool isWorldYUp) {
+    stats_.moved = 0;
+    stats_.usedRadixSort = false;
+
+    Compact();
+    if (entries_.empty()) {
+        addedSinceSort_ = 0;
+        return;
+    }
+
+    for (Entry& entry : entries_) {
+        entry.key = MakeKey(*entry.object, isWorldYUp);
+    }
+
+    // 前フレームから大きく変わったときは最初から基数ソート
+    const size_t count = entries_.size();
+    const bool isLargeChange = addedSinceSort_ > count / 4 + 16;
+    const size_t maxMoves = count * kInsertionMoveFactor + kInsertionMoveMin;
+
+    if (isLargeChange || !InsertionSort(maxMoves)) {
+        RadixSort();
+        stats_.usedRadixSort = true;
+    }
+
+    RefreshSlots();
+    addedSinceSort_ = 0;
+}
+
+void DrawList::Prepare(const Camera2D& camera) {
+    Sort(camera.IsWorldYUp());
+
+    Vector2 viewMin;
+    Vector2 viewMax;
+    camera.GetVisibleWorldRect(viewMin, viewMax);
+
+    stats_.registered = static_cast<int>(entries_.size());
+    stats_.drawn = 0;
+    stats_.culled = 0;
+    visible_.clear();
+
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        GameObject2D* obj = entries_[i].object;
+        if (!obj) continue;
+
+        const GameObjectInfo& info = obj->info_;
+        if (!info.isActive) continue;
+
+        if (!info.alwaysDraw && !obj->IsInView(viewMin, viewMax)) {
+            ++stats_.culled;
+            continue;
+        }
+
+        visible_.push_back(obj);
+    }
+    stats_.drawn = static_cast<int>(visible_.size());
+}
+
+void DrawList::Submit(const Camera2D& camera) {
+    // 描画中にRemoveされた枠（nullptr）は飛ばす。添字で回すのはDraw中の変更に備えるため
+    for (size_t i = 0; i < visible_.size(); ++i) {
+        if (GameObject2D* obj = visible_[i]) {
+            obj->Draw(camera);
+        }
+    }
+    visible_.clear();
+}
+
+void DrawList::Draw(const Camera2D& camera) {
+    Prepare(camera);
+    Submit(camera);
+}
@@ -0,0 +1,94 @@
+﻿#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+class GameObject2D; // 前方宣言
+class Camera2D;
+
+// 1フレーム分の描画状況（DebugWindow表示用）
+struct DrawListStats {
+    int registered = 0; // 登録中のオブジェクト数
+    int drawn = 0;      // Drawを呼んだ数
+    int culled = 0;     // カメラ外で省いた数
+    int moved = 0;      // 挿入ソートで動かした要素数
+    bool usedRadixSort = false; // 基数ソートに切り替えたか
+};
+
+/// <summary>
+/// 描画順を保ったオブジェクトの一覧
+/// 前フレームの並びを残しておき、毎フレームほぼ整列済みの配列を挿入ソートで直す。
+/// 動かす量が多いとき（大量生成直後など）だけ基数ソートに切り替える
+/// どちらも安定ソートなので、同じキー同士は登録順（前フレームの順）のまま描かれる
+/// </summary>
+class DrawList {
+public:
+    DrawList() = default;
+    ~DrawList() = default;
+
+    // コピー禁止（リスト内の位置をオブジェクト側に持たせているため）
+    DrawList(const DrawList&) = delete;
+    DrawList& operator=(const DrawList&) = delete;
+
+    /// <summary>
+    /// 末尾に登録する（同じキーの中では最後に描かれる）
+    /// </summary>
+    void Add(GameObject2D* obj);
+
+    /// <summary>
+    /// 登録を解除する（オブジェクトを破棄する前に呼ぶこと。詰めるのは次のSort）
+    /// </summary>
+    void Remove(GameObject2D* obj);
+
+    /// <summary>
+    /// 全ての登録を解除する
+    /// </summary>
+    void Clear();
+
+    /// <summary>
+    /// キーを計算し直して並べ替える
+    /// </summary>
+    /// <param name="isWorldYUp">ワールドがY上向きか（Y座標の小さいものほど手前になる）</param>
+    void Sort(bool isWorldYUp);
+
+    /// <summary>
+    /// 並べ替えてから、カメラに映るものだけを描画順に集める（描画命令は出さない）
+    /// </summary>
+    void Prepare(const Camera2D& camera);
+
+    /// <summary>
+    /// Prepareで集めたものに順にDrawを呼ぶ
+    /// </summary>
+    void Submit(const Camera2D& camera);
+
+    /// <summary>
+    /// Prepare と Submit をまとめて行う
+    /// </summary>
+    void Draw(const Camera2D& camera);
+
+    const DrawListStats& GetStats() const { return stats_; }
+
+private:
+    struct Entry {
+        uint64_t key;
+        GameObject2D* object; // Removeされた枠はnullptr
+    };
+
+    // 挿入ソートで動かしてよい量（要素数に対する倍率）。超えたら基数ソートに切り替える
+    static constexpr size_t kInsertionMoveFactor = 4;
+    static constexpr size_t kInsertionMoveMin = 256;
+
+    std::vector<Entry> entries_;
+    std::vector<Entry> scratch_; // 基数ソートの作業領域
+    std::vector<GameObject2D*> visible_; // Prepareで集めた描画対象（描画順）
+    size_t removedCount_ = 0;
+    size_t addedSinceSort_ = 0;
+    DrawListStats stats_;
+
+    static uint64_t MakeKey(const GameObject2D& obj, bool isWorldYUp);
+
+    void Compact();
+    bool InsertionSort(size_t maxMoves);
+    void RadixSort();
+    void RefreshSlots();
+};
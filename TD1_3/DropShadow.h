@@ -0,0 +1,47 @@
+﻿#pragma once
+#include "GameObject2D.h"
+#include "Vector2.h"
+
+/// <summary>
+/// オーナーの足元に付いて回る影
+/// オーナーを親としてTransformを引き継ぐので、位置は足元からの相対値だけ持つ
+/// </summary>
+class DropShadow : public GameObject2D {
+public:
+    /// <param name="offset">オーナーからの相対位置</param>
+    /// <param name="size">影の描画サイズ</param>
+    DropShadow(const Vector2& offset = { 0.0f, -36.0f }, const Vector2& size = { 56.0f, 16.0f })
+        : size_(size) {
+        transform_.translate = offset;
+        SetInheritOwnerTransform(true);
+
+        // オーナーより奥に描き、当たり判定は持たない
+        SetDrawLayer(-1);
+        collider_.canCollide = false;
+    }
+
+    void Initialize() override {
+        GameObject2D::Initialize(); // 描画コンポーネントの設定が戻るので、見た目はその後に決める
+
+        SetTexture(TextureId::White1x1);
+        drawComp_.SetDrawSize(size_.x, size_.y);
+        drawComp_.SetAnchorPoint({ 0.5f, 0.5f });
+        drawComp_.SetBaseColor(0x00000060);
+    }
+
+    void Update(float dt) override {
+        if (!info_.isActive) return;
+
+        // 自分は動かないので物理計算もスリープ判定もせず、親に合わせて行列だけ更新する（カメラ外判定用）
+        UpdateWorldMatrix();
+        drawComp_.Update(dt);
+
+        // オーナーが破棄されたら一緒に消える
+        if (!GetParent()) {
+            Destroy();
+        }
+    }
+
+private:
+    Vector2 size_;
+};
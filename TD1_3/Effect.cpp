@@ -1,5 +1,5 @@
 ﻿#include "Effect.h"
-#include <random>
+#include "Random.h"
 #include <algorithm>
 #include <cmath>
 
@@ -86,12 +86,9 @@ void Effect::StopShake() {
 void Effect::UpdateShake(float deltaTime) {
 	if (!shakeEffect_.isActive) return;
 
-	static std::random_device rd;
-	static std::mt19937 gen(rd());
-	std::uniform_real_distribution<float> dist(-shakeEffect_.intensity, shakeEffect_.intensity);
-
-	shakeEffect_.offset.x = dist(gen);
-	shakeEffect_.offset.y = dist(gen);
+	Random& rng = Rng(RandomStreamId::Visual);
+	shakeEffect_.offset.x = rng.RandomFloat(-shakeEffect_.intensity, shakeEffect_.intensity);
+	shakeEffect_.offset.y = rng.RandomFloat(-shakeEffect_.intensity, shakeEffect_.intensity);
 
 	if (!shakeEffect_.continuous) {
 		shakeEffect_.elapsed += deltaTime;
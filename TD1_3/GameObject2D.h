@@ -1,6 +1,8 @@
 ﻿#pragma once
 #include <string>
 #include <memory>
+#include <cmath>
+#include <cstdint>
 
 #include "Vector2.h"
 #include "Matrix3x3.h"
@@ -10,15 +12,31 @@
 #include "Rigidbody2D.hpp"
 #include "DrawComponent2D.h" 
 #include "TextureManager.h"
+#include "SimulationClock.h"
+#include "ObjectHandle.h"
+#include "TagRegistry.h"
+#include "WorldSnapshot.h"
 
 class GameObjectManager; // 前方宣言
+class PhysicsWorld;
+class CollisionWorld;
+class DrawList;
 
 // 必要な構造体定義
 struct GameObjectInfo {
     int id = -1;
-    std::string tag = "Untagged";
+    TagId tag = kUntaggedTag; // TagRegistryで登録した番号（文字列はGetTagName()）
     bool isActive = true;
     bool isVisible = true;
+    bool alwaysUpdate = false; // カメラから離れても更新頻度を落とさない（プレイヤーなど）
+    bool alwaysDraw = false;   // カメラ外でも描画を呼ぶ（Draw内でデバッグ表示をするものなど）
+};
+
+// 描画順の指定（layer → Y座標 → subOrder の順に小さいものから描く）
+struct DrawOrder {
+    int16_t layer = 0;    // 描画レイヤー（大きいほど手前）
+    bool ySort = false;   // 同じレイヤー内で画面の下にあるものほど手前に描くか（falseのものはySortするものより奥）
+    int16_t subOrder = 0; // レイヤー・Y座標が同じもの同士の順番
 };
 
 struct Collider {
@@ -35,8 +53,22 @@ struct Status {
 };
 
 class GameObject2D {
+    friend class PhysicsWorld; // SoAへの収集・書き戻しで直接アクセスする
+    friend class CollisionWorld; // AABBツリーの更新で直接アクセスする
+    friend class GameObjectManager; // タグ別一覧の位置を直接更新する
+    friend class DrawList; // 描画リスト内の位置を直接更新する
+
 protected:
-    GameObject2D* owner_ = nullptr; // 所有者オブジェクト
+    ObjectHandle owner_; // 所有者オブジェクト（破棄されていれば解決できない）
+    bool inheritOwnerTransform_ = false; // オーナーを親としてTransformを引き継ぐか
+
+    // 自分のハンドルと、ハンドルを解決する表（マネージャーが登録時に設定）
+    ObjectHandle handle_;
+    const HandleTable* handleTable_ = nullptr;
+
+    // GameObjectManagerのタグ別一覧の中での位置（-1 = 未登録）と、登録時のタグ
+    int tagSlot_ = -1;
+    TagId indexedTag_ = kUntaggedTag;
 
     // 基本情報
     GameObjectInfo info_;
@@ -47,8 +79,8 @@ protected:
     // 物理挙動（速度・加速度）
     Rigidbody2D rigidbody_;
 
-    // 描画機能
-    DrawComponent2D* drawComp_;
+    // 描画機能（オブジェクト本体と一緒に確保する）
+    DrawComponent2D drawComp_;
 
     // 当たり判定情報
     Collider collider_;
@@ -62,6 +94,34 @@ protected:
     // 死亡フラグ（trueになるとマネージャーが削除する）
     bool isDead_ = false;
 
+    // PhysicsWorldに登録されている場合のボディ番号（-1 = 未登録、個別に物理計算する）
+    int physicsBodyIndex_ = -1;
+
+    // Spawn時にPhysicsWorldへ登録するか（UsePhysicsWorldで設定）と、マップと衝突させるか
+    bool usePhysicsWorld_ = false;
+    bool collideWithMap_ = false;
+
+    // CollisionWorldのAABBツリー上のプロキシID（-1 = 未登録）
+    int collisionProxy_ = -1;
+
+    // スリープ状態（速度がしきい値未満のまま一定フレーム続くと物理計算を止める）
+    bool isSleeping_ = false;
+    int sleepFrames_ = 0;
+    Transform2D sleepTransform_; // 眠った時点のSRT（外から動かされたら起こす）
+
+    // 更新を間引かれている間に溜まった経過時間
+    float skippedTime_ = 0.0f;
+
+    // 描画順と、DrawList内での位置（-1 = 未登録）
+    DrawOrder drawOrder_;
+    int drawListSlot_ = -1;
+
+    // 補間済みワールド行列のキャッシュ（子から親として何度参照されても1フレームに1回だけ計算する）
+    // 固定ステップの開始時に無効にし、補間係数が変わった時も計算し直す
+    mutable Matrix3x3 interpolatedWorldMatrix_;
+    mutable float interpolatedAlpha_ = 0.0f;
+    mutable bool isInterpolatedDirty_ = true;
+
 public:
 
     GameObject2D() {
@@ -69,9 +129,6 @@ public:
         transform_.translate = { 0.0f, 0.0f };
         transform_.scale = { 1.0f, 1.0f };
         transform_.rotation = 0.0f;
-
-        // DrawComponent2Dの生成
-		drawComp_ = new DrawComponent2D();
     }
 
     virtual ~GameObject2D() = default;
@@ -79,85 +136,368 @@ public:
     // IDとタグを指定して初期化
     GameObject2D(int id, const std::string& tag) : GameObject2D() {
         info_.id = id;
-        info_.tag = tag;
+        info_.tag = InternTag(tag);
     }
 
     // 生成時や初期化時にセットする
-    void SetOwner(GameObject2D* owner) { owner_ = owner; }
-    GameObject2D* GetOwner() const { return owner_; }
+    void SetOwner(GameObject2D* owner) { owner_ = owner ? owner->handle_ : ObjectHandle{}; }
+    void SetOwner(ObjectHandle owner) { owner_ = owner; }
+
+    // オーナーを取得（オーナーが既に破棄されていればnullptr）
+    GameObject2D* GetOwner() const { return ResolveHandle<GameObject2D>(owner_); }
+    ObjectHandle GetOwnerHandle() const { return owner_; }
 
 	// オーナーかどうか判定
-    bool IsOwnedBy(GameObject2D* potentialOwner) const {
-        return owner_ == potentialOwner;
+    bool IsOwnedBy(const GameObject2D* potentialOwner) const {
+        return potentialOwner && !owner_.IsNull() && owner_ == potentialOwner->handle_;
     }
 
+    // 自分を指すハンドル（マネージャー未登録なら無効）
+    ObjectHandle GetHandle() const { return handle_; }
+
 	// 初期化処理
     virtual void Initialize() {
         rigidbody_.Initialize();
 
-        // 描画コンポーネントの初期化があれば呼ぶ
-        if (drawComp_) {
-            drawComp_->Initialize();
-        }
+        // 描画コンポーネントの初期化
+        drawComp_.Initialize();
     }
 
     // テクスチャの設定（DrawComponent2Dへ流す）
     void SetTexture(TextureId id) {
-        if (drawComp_) {
-			drawComp_->SetTexture(id);
-        }
+        drawComp_.SetTexture(id);
     }
 
     virtual void Update(float deltaTime = 60.0f) {
         if (!info_.isActive) return;
 
-        // 1. 物理挙動の更新（速度計算）
-        rigidbody_.Update(deltaTime);
+        // PhysicsWorldに登録済みなら 1～3 はワールド側でまとめて行う
+        if (!IsSimulatedByWorld()) {
+            if (isSleeping_ && ShouldWake()) {
+                WakeUp();
+            }
+
+            // 眠っている間は位置も行列も変わらないので省略
+            if (!isSleeping_) {
+                // 1. 物理挙動の更新（速度計算）
+                rigidbody_.Update(deltaTime);
+
+                // 2. 計算された速度を座標に反映
+                transform_.translate += rigidbody_.GetMoveDelta(deltaTime);
+                transform_.rotation += rigidbody_.GetRotationDelta(deltaTime);
+
+                // 3. ワールド行列の更新
+                ApplyPhysicsResult();
+                UpdateSleepState();
+            }
+        }
+
+        // 4. 描画コンポーネントの更新
+        drawComp_.Update(deltaTime);
+    }
+
+    /// <summary>
+    /// 物理計算後の座標をワールド行列と描画コンポーネントへ反映する
+    /// </summary>
+    void ApplyPhysicsResult() {
+        UpdateWorldMatrix();
+        drawComp_.SetTransform(transform_);
+    }
+
+    // --- 親子関係（オーナーを親として座標を引き継ぐ） ---
+
+    /// <summary>
+    /// オーナーのTransformを親として引き継ぐか設定する
+    /// 有効にするとtransform_.translate等はオーナーからの相対値になる
+    /// </summary>
+    void SetInheritOwnerTransform(bool enable) {
+        inheritOwnerTransform_ = enable;
+        transform_.InvalidateCache();
+        isInterpolatedDirty_ = true;
+    }
+    bool IsInheritOwnerTransform() const { return inheritOwnerTransform_; }
+
+    // Transformの親（引き継がない設定か、オーナーが破棄済みならnullptr）
+    GameObject2D* GetParent() const { return inheritOwnerTransform_ ? GetOwner() : nullptr; }
+
+    /// <summary>
+    /// ワールド行列を更新する
+    /// 親がいれば先に親を更新してから掛け合わせる（変化がなければどちらも計算しない）
+    /// </summary>
+    void UpdateWorldMatrix() {
+        if (GameObject2D* parent = GetParent()) {
+            parent->UpdateWorldMatrix();
+            transform_.CalculateWorldMatrix(parent->transform_);
+        }
+        else {
+            transform_.CalculateWorldMatrix();
+        }
+    }
+
+    // ワールド座標での位置（親がいなければGetPositionと同じ）
+    Vector2 GetWorldPosition() {
+        UpdateWorldMatrix();
+        return transform_.GetWorldPosition();
+    }
+
+    // PhysicsWorldで物理計算されているか
+    bool IsSimulatedByWorld() const { return physicsBodyIndex_ >= 0; }
+
+    /// <summary>
+    /// Spawn時にマネージャーのPhysicsWorldへ登録させる（派生クラスのコンストラクタで呼ぶ）
+    /// 登録したオブジェクトは速度を書き換えるだけでよく、積分とマップ衝突はワールドがまとめて行う
+    /// </summary>
+    void UsePhysicsWorld(bool collideWithMap) {
+        usePhysicsWorld_ = true;
+        collideWithMap_ = collideWithMap;
+    }
+
+    // ==========================================
+    //  スリープ
+    // ==========================================
+
+    // 眠らせる速度のしきい値と、それが続くフレーム数
+    static constexpr float kSleepLinearThreshold = 2.0f;    // px/s
+    static constexpr float kSleepAngularThreshold = 0.01f;  // rad/s
+    static constexpr int kSleepFrameCount = 30;
+
+    bool IsSleeping() const { return isSleeping_; }
+
+    /// <summary>
+    /// スリープを解除する（力を加えた時・接触した時に呼ばれる）
+    /// </summary>
+    void WakeUp() {
+        isSleeping_ = false;
+        sleepFrames_ = 0;
+    }
+
+    /// <summary>
+    /// 眠っている間に力や速度を与えられた、または外から動かされたか
+    /// </summary>
+    bool ShouldWake() const {
+        const Vector2& v = rigidbody_.velocity;
+        const Vector2& a = rigidbody_.acceleration;
+        return a.x != 0.0f || a.y != 0.0f || rigidbody_.angularAcceleration != 0.0f ||
+            v.x * v.x + v.y * v.y > kSleepLinearThreshold * kSleepLinearThreshold ||
+            std::abs(rigidbody_.angularVelocity) > kSleepAngularThreshold ||
+            transform_.translate.x != sleepTransform_.translate.x ||
+            transform_.translate.y != sleepTransform_.translate.y ||
+            transform_.rotation != sleepTransform_.rotation ||
+            transform_.scale.x != sleepTransform_.scale.x ||
+            transform_.scale.y != sleepTransform_.scale.y;
+    }
+
+    /// <summary>
+    /// 物理計算後に呼ぶ：遅い状態が続いたら眠らせる
+    /// </summary>
+    void UpdateSleepState() {
+        const Vector2& v = rigidbody_.velocity;
+        const bool isSlow = v.x * v.x + v.y * v.y <= kSleepLinearThreshold * kSleepLinearThreshold &&
+            std::abs(rigidbody_.angularVelocity) <= kSleepAngularThreshold;
+
+        if (!isSlow) {
+            sleepFrames_ = 0;
+            return;
+        }
+
+        if (++sleepFrames_ >= kSleepFrameCount) {
+            isSleeping_ = true;
+            rigidbody_.velocity = { 0.0f, 0.0f };
+            rigidbody_.angularVelocity = 0.0f;
+            sleepTransform_ = transform_;
+        }
+    }
 
-        // 2. 計算された速度を座標に反映
-        transform_.translate += rigidbody_.GetMoveDelta(deltaTime);
-        transform_.rotation += rigidbody_.GetRotationDelta(deltaTime);
+    // ==========================================
+    //  更新頻度の間引き（GameObjectManagerが使用）
+    // ==========================================
 
-        // 3. ワールド行列の更新
-        transform_.CalculateWorldMatrix();
+    // 更新を飛ばしたフレームの経過時間を溜める
+    void AccumulateSkippedTime(float deltaTime) { skippedTime_ += deltaTime; }
 
-       
-        // 4. 描画コンポーネント等の更新があれば呼ぶ
-        if (drawComp_) { 
-			drawComp_->SetTransform(transform_);
-            drawComp_->Update(deltaTime);}
+    // 溜まった経過時間を取り出す
+    float TakeSkippedTime() {
+        const float time = skippedTime_;
+        skippedTime_ = 0.0f;
+        return time;
     }
 
     virtual void Draw(const Camera2D& camera) {
         if (!info_.isActive || !info_.isVisible) return;
 
-        // DrawComponent2Dを使って描画
-        if (drawComp_) {
-            drawComp_->Draw(camera);
-        }
+        // DrawComponent2Dを使って描画（固定ステップ間を補間した位置に描く）
+        drawComp_.SetTransform(GetInterpolatedTransform());
+        drawComp_.Draw(camera);
+    }
+
+    // --- 描画順・カメラ外判定 ---
+
+    const DrawOrder& GetDrawOrder() const { return drawOrder_; }
+    void SetDrawOrder(const DrawOrder& order) { drawOrder_ = order; }
+    void SetDrawLayer(int16_t layer) { drawOrder_.layer = layer; }
+    void SetYSort(bool enable) { drawOrder_.ySort = enable; }
+    void SetDrawSubOrder(int16_t subOrder) { drawOrder_.subOrder = subOrder; }
+
+    // 描画の基準となるワールド座標（親子付けされていればワールド行列の位置）
+    Vector2 GetDrawPosition() const {
+        return transform_.hasParent ? transform_.GetWorldPosition() : transform_.translate;
+    }
+
+    /// <summary>
+    /// カメラ外判定に使う、基準点から描画範囲の最も遠い角までの距離
+    /// DrawComponent2D以外で大きく描く派生クラスはオーバーライドする
+    /// </summary>
+    virtual float GetDrawCullRadius() const {
+        const Vector2 size = drawComp_.GetFinalDrawSize();
+        return std::sqrt(size.x * size.x + size.y * size.y);
+    }
+
+    // 表示範囲（ワールド座標の矩形）に掛かっているか
+    bool IsInView(const Vector2& viewMin, const Vector2& viewMax) const {
+        const Vector2 pos = GetDrawPosition();
+        const float radius = GetDrawCullRadius();
+        return pos.x + radius >= viewMin.x && pos.x - radius <= viewMax.x &&
+            pos.y + radius >= viewMin.y && pos.y - radius <= viewMax.y;
+    }
+
+    // --- 当たり判定イベント（GameObjectManagerから呼ばれる） ---
+    // どちらかのColliderがisTriggerならTrigger系、それ以外はCollision系が呼ばれる
+
+    virtual void OnCollisionEnter(GameObject2D* other) { other; }
+    virtual void OnCollisionStay(GameObject2D* other) { other; }
+    virtual void OnCollisionExit(GameObject2D* other) { other; }
+
+    virtual void OnTriggerEnter(GameObject2D* other) { other; }
+    virtual void OnTriggerStay(GameObject2D* other) { other; }
+    virtual void OnTriggerExit(GameObject2D* other) { other; }
+
+    // --- スナップショット（リトライ・巻き戻し用） ---
+    // 派生クラスは固有の状態を足す時に override し、先に基底クラスの処理を呼ぶ
+    // ハンドル・タグ・マネージャーへの登録などは保存しない（同じオブジェクトへ書き戻す前提）
+
+    virtual void SaveState(SnapshotWriter& writer) const {
+        writer.Write(info_.isActive);
+        writer.Write(info_.isVisible);
+        writer.Write(transform_);
+        writer.Write(rigidbody_);
+        writer.Write(collider_);
+        writer.Write(status_);
+        writer.Write(isDead_);
+        writer.Write(isSleeping_);
+        writer.Write(sleepFrames_);
+        writer.Write(sleepTransform_);
+        writer.Write(skippedTime_);
+    }
+
+    virtual void LoadState(SnapshotReader& reader) {
+        // 子が親の変化に気付けるよう、行列の世代番号は今のものから進める
+        const uint32_t version = transform_.version;
+
+        reader.Read(info_.isActive);
+        reader.Read(info_.isVisible);
+        reader.Read(transform_);
+        reader.Read(rigidbody_);
+        reader.Read(collider_);
+        reader.Read(status_);
+        reader.Read(isDead_);
+        reader.Read(isSleeping_);
+        reader.Read(sleepFrames_);
+        reader.Read(sleepTransform_);
+        reader.Read(skippedTime_);
+
+        transform_.version = version;
+        transform_.InvalidateCache();
+        isInterpolatedDirty_ = true;
+        ApplyPhysicsResult();
     }
 
     // 力を加える
-    void AddForce(const Vector2& force) { rigidbody_.AddForce(force); }
+    void AddForce(const Vector2& force) {
+        rigidbody_.AddForce(force);
+        WakeUp();
+    }
 
     // --- Getters / Setters ---
 
     GameObjectInfo& GetInfo() { return info_; }
+    const std::string& GetTagName() const { return TagRegistry::GetInstance().GetName(info_.tag); }
     Transform2D& GetTransform() { return transform_; }
+    const Transform2D& GetTransform() const { return transform_; }
     Rigidbody2D& GetRigidbody() { return rigidbody_; }
     Collider& GetCollider() { return collider_; }
     Status& GetStatus() { return status_; }
 
     // 描画コンポーネントへのアクセス（細かい設定用）
-    DrawComponent2D* GetDrawComponent() { return drawComp_; }
+    DrawComponent2D* GetDrawComponent() { return &drawComp_; }
 
     void SetPosition(const Vector2& pos) { transform_.translate = pos; }
     Vector2 GetPosition() const { return transform_.translate; }
 
+    // --- 描画補間（固定ステップ更新用） ---
+
+    // 固定ステップの開始時にマネージャーから呼ばれる
+    // ワープ直後に呼ぶと、前の位置からの補間をやめる
+    void SavePreviousTransform() {
+        transform_.SavePrevious();
+        isInterpolatedDirty_ = true;
+    }
+
+    // 描画用の補間済みTransform
+    Transform2D GetInterpolatedTransform() const {
+        Transform2D result = transform_.Interpolated(SimulationClock::GetInstance().GetInterpolationAlpha());
+        if (GetParent()) {
+            // 親の補間済み行列はキャッシュから取るので、親をたどり直すのは1フレームに1回だけ
+            result.worldMatrix = GetInterpolatedWorldMatrix();
+            result.hasParent = true;
+        }
+        return result;
+    }
+
+    /// <summary>
+    /// 親も含めて補間したワールド行列
+    /// 固定ステップが進むか補間係数が変わるまではキャッシュを返す
+    /// </summary>
+    const Matrix3x3& GetInterpolatedWorldMatrix() const {
+        const float alpha = SimulationClock::GetInstance().GetInterpolationAlpha();
+        if (!isInterpolatedDirty_ && alpha == interpolatedAlpha_) {
+            return interpolatedWorldMatrix_;
+        }
+
+        Vector2 translate = transform_.translate;
+        Vector2 scale = transform_.scale;
+        float rotation = transform_.rotation;
+        if (transform_.hasPrevious) {
+            translate = transform_.previousTranslate + (translate - transform_.previousTranslate) * alpha;
+            scale = transform_.previousScale + (scale - transform_.previousScale) * alpha;
+            rotation = transform_.previousRotation + (rotation - transform_.previousRotation) * alpha;
+        }
+
+        interpolatedWorldMatrix_ = AffineMatrix2D::MakeAffine(scale, rotation, translate);
+        if (const GameObject2D* parent = GetParent()) {
+            interpolatedWorldMatrix_ = Matrix3x3::Multiply(interpolatedWorldMatrix_, parent->GetInterpolatedWorldMatrix());
+        }
+        interpolatedAlpha_ = alpha;
+        isInterpolatedDirty_ = false;
+        return interpolatedWorldMatrix_;
+    }
+
     // --- マネージャー連携用セッター ---
     void SetManager(GameObjectManager* manager) { manager_ = manager; }
+    void SetHandle(const HandleTable* table, ObjectHandle handle) {
+        handleTable_ = table;
+        handle_ = handle;
+    }
 
     // 自分を殺す（リストから削除依頼）
     void Destroy() { isDead_ = true; }
     bool IsDead() const { return isDead_; }
+
+protected:
+    /// <summary>
+    /// 同じマネージャーに登録されたオブジェクトをハンドルから取得（破棄済みならnullptr）
+    /// </summary>
+    template <typename T>
+    T* ResolveHandle(ObjectHandle handle) const {
+        return handleTable_ ? static_cast<T*>(handleTable_->Resolve(handle)) : nullptr;
+    }
 };
\ No newline at end of file
@@ -1 +1,53 @@
 ﻿#include "GameObjectManager.h"
+#include <Novice.h>
+#include <cmath>
+
+bool GameObjectManager::CheckThrottledCatchUp() {
+    constexpr float kDeltaTime = 1.0f / 60.0f;
+    // 遠い段階の間隔の倍数にして、最後のステップで遠いボディが追い付くようにする
+    constexpr int kStepCount = static_cast<int>(kFarInterval) * 16;
+    // 溜めた時間は kMaxCatchUpStep ずつ進めるので、毎ステップの積分とは減速の分だけわずかにずれる
+    constexpr float kRelativeTolerance = 0.01f;
+
+    Camera2D camera({ 640.0f, 360.0f }, { 1280.0f, 720.0f });
+    GameObjectManager manager;
+    manager.SetActivityCamera(&camera);
+
+    // 同じ速度・減速率のボディを、カメラから遠い位置（先に作るので0番）と画面の中に置く
+    auto spawnBody = [&manager](const Vector2& position) {
+        GameObject2D* body = manager.Spawn<GameObject2D>(nullptr);
+        body->SetPosition(position);
+        body->GetRigidbody().velocity = { 300.0f, -200.0f };
+        body->GetRigidbody().deceleration = { 0.5f, 0.5f };
+        manager.GetPhysicsWorld().AddBody(body);
+        return body;
+    };
+    const Vector2 farStart = { 100000.0f, 360.0f };
+    const Vector2 nearStart = camera.GetPosition();
+    GameObject2D* farBody = spawnBody(farStart);
+    GameObject2D* nearBody = spawnBody(nearStart);
+
+    // 遠いボディは間引かれている間は止まり、kFarInterval ステップに1回だけ動くはず
+    int throttledCount = 0;
+    int farMoveCount = 0;
+    for (int i = 0; i < kStepCount; ++i) {
+        const Vector2 farBefore = farBody->GetPosition();
+        manager.Update(kDeltaTime);
+        throttledCount += manager.GetActivityStats().throttled;
+        if (farBody->GetPosition().x != farBefore.x || farBody->GetPosition().y != farBefore.y) {
+            ++farMoveCount;
+        }
+    }
+
+    const Vector2 farMove = farBody->GetPosition() - farStart;
+    const Vector2 nearMove = nearBody->GetPosition() - nearStart;
+    const Vector2 diff = farMove - nearMove;
+    const float error = std::sqrt(diff.x * diff.x + diff.y * diff.y);
+    const float distance = std::sqrt(nearMove.x * nearMove.x + nearMove.y * nearMove.y);
+    const bool isOk = farMoveCount == kStepCount / static_cast<int>(kFarInterval) &&
+        error <= distance * kRelativeTolerance;
+
+    Novice::ConsolePrintf("PhysicsCheck: throttled=%d farSteps=%d near=(%.3f, %.3f) far=(%.3f, %.3f) error=%.3f %s\n",
+        throttledCount, farMoveCount, nearMove.x, nearMove.y, farMove.x, farMove.y, error, isOk ? "OK" : "NG");
+    return isOk;
+}
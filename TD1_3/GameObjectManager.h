@@ -1,9 +1,33 @@
 ﻿#pragma once
 #include "GameObject2D.h"
+#include "GameObjectPool.h"
 #include <vector>
 #include <memory>
 #include <algorithm>
+#include <initializer_list>
 #include "MapData.h"
+#include "PhysicsWorld.h"
+#include "CollisionWorld.h"
+#include "DrawList.h"
+
+// カメラからの距離による更新頻度の段階
+enum class ActivityTier {
+    Near,   // 画面内と周辺：毎フレーム更新
+    Middle, // 画面1枚分外側まで：数フレームに1回
+    Far     // それより遠く：さらに間引く
+};
+
+// 1フレーム分の更新状況（DebugWindow表示用）
+struct ObjectActivityStats {
+    int total = 0;      // 管理中のオブジェクト数
+    int updated = 0;    // このフレームに更新したオブジェクト数
+    int throttled = 0;  // 距離による間引きで更新を飛ばしたオブジェクト数
+    int awake = 0;      // 起きているオブジェクト数
+    int sleeping = 0;   // 眠っているオブジェクト数
+    int nearCount = 0;
+    int middleCount = 0;
+    int farCount = 0;
+};
 
 enum class ObjectType {
     Player,
@@ -16,11 +40,130 @@ enum class ObjectType {
 
 class GameObjectManager {
 private:
-    // 全オブジェクトを所有権付きで管理
-    std::vector<std::unique_ptr<GameObject2D>> objects_;
+    // 型ごとのオブジェクトプール（添字は GameObjectPool<T>::TypeIndex()）
+    // オブジェクトより後に破棄されるよう、objects_ より先に宣言する
+    std::vector<std::unique_ptr<IGameObjectPool>> pools_;
+
+    // 全オブジェクトを所有権付きで管理（破棄時はプールへ返る）
+    std::vector<GameObjectPtr> objects_;
 
     // 追加待ちキュー（Update中の追加によるイテレータ無効化を防ぐ）
-    std::vector<std::unique_ptr<GameObject2D>> pendingObjects_;
+    std::vector<GameObjectPtr> pendingObjects_;
+
+    // ハンドル → オブジェクトの表（破棄時に世代を進めて古いハンドルを無効にする）
+    HandleTable handles_;
+
+    // タグ番号ごとの所属オブジェクト（添字 = TagId、生成時に追加・削除時に末尾と入れ替えて外す）
+    std::vector<std::vector<GameObject2D*>> tagMembers_;
+
+    // 登録したオブジェクトの物理挙動を一括計算する
+    PhysicsWorld physicsWorld_;
+
+    // オブジェクト同士の当たり判定（Collider + Transform2D から動的AABBツリーを維持）
+    CollisionWorld collisionWorld_;
+
+    // 描画順（レイヤー → Y座標 → サブ順）に並べた一覧。前フレームの並びを使い回して差分だけ直す
+    DrawList drawList_;
+
+    // 更新頻度の間引きに使うカメラ（nullptrなら全て毎フレーム更新）
+    Camera2D* activityCamera_ = nullptr;
+    unsigned int frameCount_ = 0;
+    ObjectActivityStats stats_;
+
+    // 画面外周の余白と、段階ごとの更新間隔（フレーム）
+    static constexpr float kNearMargin = 256.0f;
+    static constexpr unsigned int kMiddleInterval = 2;
+    static constexpr unsigned int kFarInterval = 8;
+
+    /// <summary>
+    /// カメラの表示範囲から更新段階を決める
+    /// </summary>
+    ActivityTier ComputeActivityTier(const GameObject2D& obj, const Vector2& viewMin, const Vector2& viewMax) const {
+        const Vector2 pos = obj.GetPosition();
+        const Vector2 viewSize = viewMax - viewMin;
+
+        if (pos.x >= viewMin.x - kNearMargin && pos.x <= viewMax.x + kNearMargin &&
+            pos.y >= viewMin.y - kNearMargin && pos.y <= viewMax.y + kNearMargin) {
+            return ActivityTier::Near;
+        }
+        if (pos.x >= viewMin.x - viewSize.x && pos.x <= viewMax.x + viewSize.x &&
+            pos.y >= viewMin.y - viewSize.y && pos.y <= viewMax.y + viewSize.y) {
+            return ActivityTier::Middle;
+        }
+        return ActivityTier::Far;
+    }
+
+    void AddToTagIndex(GameObject2D* obj) {
+        const TagId tag = obj->info_.tag;
+        if (tag >= tagMembers_.size()) {
+            tagMembers_.resize(static_cast<size_t>(tag) + 1);
+        }
+
+        std::vector<GameObject2D*>& members = tagMembers_[tag];
+        obj->tagSlot_ = static_cast<int>(members.size());
+        obj->indexedTag_ = tag;
+        members.push_back(obj);
+    }
+
+    void RemoveFromTagIndex(GameObject2D* obj) {
+        if (obj->tagSlot_ < 0) return;
+
+        std::vector<GameObject2D*>& members = tagMembers_[obj->indexedTag_];
+        GameObject2D* last = members.back();
+        members[obj->tagSlot_] = last;
+        last->tagSlot_ = obj->tagSlot_;
+        members.pop_back();
+        obj->tagSlot_ = -1;
+    }
+
+    /// <summary>
+    /// T型のプールを取得（初回のみ作成）
+    /// </summary>
+    template <typename T>
+    GameObjectPool<T>& GetPool() {
+        const size_t index = GameObjectPool<T>::TypeIndex();
+        if (index >= pools_.size()) {
+            pools_.resize(index + 1);
+        }
+        if (!pools_[index]) {
+            pools_[index] = std::make_unique<GameObjectPool<T>>();
+        }
+        return static_cast<GameObjectPool<T>&>(*pools_[index]);
+    }
+
+    // 生成待ちのオブジェクトをメインリストへ移す
+    void MergePendingObjects() {
+        for (auto& obj : pendingObjects_) {
+            drawList_.Add(obj.get());
+            objects_.push_back(std::move(obj));
+        }
+        pendingObjects_.clear();
+    }
+
+    // 死亡フラグが立ったオブジェクトを登録先から外して破棄する
+    // （イベント中に死んだものもここで外し、相手にExitを送ってから破棄する）
+    void RemoveDeadObjects() {
+        for (auto& obj : objects_) {
+            if (obj->IsDead()) {
+                collisionWorld_.RemoveObject(obj.get());
+            }
+        }
+        collisionWorld_.FlushRemovals();
+
+        objects_.erase(
+            std::remove_if(objects_.begin(), objects_.end(),
+                [this](const GameObjectPtr& obj) {
+                    if (!obj->IsDead()) return false;
+                    physicsWorld_.RemoveBody(obj.get());
+                    drawList_.Remove(obj.get());
+                    handles_.Unregister(obj->GetHandle());
+                    RemoveFromTagIndex(obj.get());
+                    return true;
+                }
+            ),
+            objects_.end()
+        );
+    }
 
 public:
     // ==========================================
@@ -32,20 +175,36 @@ public:
     /// <typeparam name="T">生成したいクラス (例: Bullet)</typeparam>
     /// <param name="owner">生成主 (例: this)</param>
     /// <param name="tag">タグ (任意)</param>
-    /// <returns>生成されたオブジェクトのポインタ</returns>
+    /// <returns>生成されたオブジェクトのポインタ（生成直後の設定用。保持するならGetHandle()を使う）</returns>
     template <typename T>
     T* Spawn(GameObject2D* owner, const std::string& tag = "Untagged") {
-        // 1. メモリ確保 (T型で作成)
-        auto newObj = std::make_unique<T>();
+        return Spawn<T>(owner, InternTag(tag));
+    }
+
+    /// <summary>
+    /// タグ番号を指定して生成（毎回の文字列検索を避けたい大量生成向け）
+    /// </summary>
+    template <typename T>
+    T* Spawn(GameObject2D* owner, TagId tag) {
+        // 1. T型のプールの空き枠に構築（破棄されると同じ枠が再利用される）
+        GameObjectPool<T>& pool = GetPool<T>();
+        GameObjectPtr newObj(pool.Create(), PooledObjectDeleter{ &pool });
 
         // 2. 基本情報のセットアップ
+        newObj->SetHandle(&handles_, handles_.Register(newObj.get())); // ハンドル発行
         newObj->SetOwner(owner);      // オーナー登録
         newObj->SetManager(this);     // マネージャー登録
         newObj->GetInfo().tag = tag;  // タグ設定
         newObj->Initialize();         // 初期化呼び出し
+        AddToTagIndex(newObj.get());  // タグ別一覧へ登録
+
+        // 物理計算をワールドに任せるものは登録（以後GameObject2D::Updateは積分しない）
+        if (newObj->usePhysicsWorld_) {
+            physicsWorld_.AddBody(newObj.get(), newObj->collideWithMap_);
+        }
 
         // 3. 呼び出し元に返すための生ポインタを取得
-        T* rawPtr = newObj.get();
+        T* rawPtr = static_cast<T*>(newObj.get());
 
         // 4. リストへ追加（Update中はpendingに入れ、後でマージする等の処理推奨）
         // ここでは簡易的に直接追加か、次フレーム追加用リストに入れる
@@ -56,6 +215,131 @@ public:
         return rawPtr;
     }
 
+    // ==========================================
+    //  タグによる検索
+    // ==========================================
+
+    /// <summary>
+    /// 指定タグの生きているオブジェクト全てに func(GameObject2D*) を呼ぶ
+    /// （文字列比較なし。func内での生成・破棄予約は可）
+    /// </summary>
+    template <typename Func>
+    void ForEachWithTag(TagId tag, Func&& func) const {
+        if (tag >= tagMembers_.size()) return;
+
+        // 途中で同じタグが生成されても添字で回すので安全（追加分は次回から）
+        const size_t count = tagMembers_[tag].size();
+        for (size_t i = 0; i < count; ++i) {
+            GameObject2D* obj = tagMembers_[tag][i];
+            if (!obj->IsDead()) {
+                func(obj);
+            }
+        }
+    }
+
+    // 文字列版（未登録のタグなら何もしない）
+    template <typename Func>
+    void ForEachWithTag(const std::string& tag, Func&& func) const {
+        TagId id = kUntaggedTag;
+        if (TagRegistry::GetInstance().TryFind(tag, id)) {
+            ForEachWithTag(id, std::forward<Func>(func));
+        }
+    }
+
+    // 指定タグのオブジェクト数（破棄予約中を含む）
+    size_t CountWithTag(TagId tag) const {
+        return tag < tagMembers_.size() ? tagMembers_[tag].size() : 0;
+    }
+
+    /// <summary>
+    /// 生成後にタグを付け替える（GetInfo().tagを直接書き換えるとタグ別一覧とずれるのでこちらを使う）
+    /// </summary>
+    void SetTag(GameObject2D* obj, TagId tag) {
+        RemoveFromTagIndex(obj);
+        obj->GetInfo().tag = tag;
+        AddToTagIndex(obj);
+    }
+
+    // ==========================================
+    //  ハンドルの解決
+    // ==========================================
+
+    /// <summary>
+    /// ハンドルからオブジェクトを取得（破棄済み・無効ならnullptr）
+    /// </summary>
+    GameObject2D* Resolve(ObjectHandle handle) const {
+        return handles_.Resolve(handle);
+    }
+
+    /// <summary>
+    /// ハンドルから型を指定して取得（型はSpawn時のものと一致させること）
+    /// </summary>
+    template <typename T>
+    T* Get(ObjectHandle handle) const {
+        return static_cast<T*>(handles_.Resolve(handle));
+    }
+
+    // ハンドルの指すオブジェクトがまだ生きているか（O(1)）
+    bool IsAlive(ObjectHandle handle) const {
+        return handles_.IsValid(handle);
+    }
+
+    /// <summary>
+    /// T型のプールの枠を先に確保しておく（弾など大量に出すものの初回確保を避ける）
+    /// </summary>
+    template <typename T>
+    void ReservePool(size_t count) {
+        GetPool<T>().Reserve(count);
+    }
+
+    /// <summary>
+    /// 物理計算を一括処理するワールド（UsePhysicsWorld を呼んだオブジェクトはSpawn時に登録される。破棄時の解除もマネージャーが行う）
+    /// </summary>
+    PhysicsWorld& GetPhysicsWorld() { return physicsWorld_; }
+
+    /// <summary>
+    /// 更新頻度の間引きに使うカメラを設定（遠いオブジェクトほど更新間隔を空ける）
+    /// </summary>
+    void SetActivityCamera(Camera2D* camera) { activityCamera_ = camera; }
+
+    // 直近フレームの更新状況
+    const ObjectActivityStats& GetActivityStats() const { return stats_; }
+
+    /// <summary>
+    /// 間引きの確認：カメラから遠くて間引かれるボディが、毎ステップ計算するボディと同じ位置まで追い付くかを調べる
+    /// （--physics-check で起動した時に使う。結果はコンソールに出す）
+    /// </summary>
+    /// <returns>遠いボディが間引かれた回数だけ止まっていて、移動量の差が許容範囲内なら true</returns>
+    static bool CheckThrottledCatchUp();
+
+    // 直近フレームの描画状況（並べ替え・カメラ外で省いた数）
+    const DrawListStats& GetDrawStats() const { return drawList_.GetStats(); }
+
+    // ==========================================
+    //  当たり判定の問い合わせ
+    // ==========================================
+
+    /// <summary>
+    /// 現在接触中のオブジェクトの組
+    /// </summary>
+    const std::vector<CollisionPair>& GetOverlappingPairs() const {
+        return collisionWorld_.GetOverlappingPairs();
+    }
+
+    /// <summary>
+    /// 矩形範囲と重なるオブジェクトを取得
+    /// </summary>
+    void QueryRegion(const Vector2& min, const Vector2& max, std::vector<GameObject2D*>& out) const {
+        collisionWorld_.QueryRegion(min, max, out);
+    }
+
+    /// <summary>
+    /// 線分上で最も近いオブジェクトを取得（トリガーは無視）
+    /// </summary>
+    bool RayCast(const Vector2& origin, const Vector2& end, RaycastHit& hit) const {
+        return collisionWorld_.RayCast(origin, end, hit);
+    }
+
 	// MapDataから
 	//void SpawnFromMapData() {
 	//	const MapData& mapData = MapData::GetInstance();
@@ -73,35 +357,103 @@ public:
     // ==========================================
     void Update(float deltaTime) {
         // 1. 新規追加オブジェクトをメインリストへ統合
-        for (auto& obj : pendingObjects_) {
-            objects_.push_back(std::move(obj));
+        MergePendingObjects();
+
+        // 描画補間用に、このステップ開始時のTransformを保存
+        for (auto& obj : objects_) {
+            obj->SavePreviousTransform();
         }
-        pendingObjects_.clear();
 
-        // 2. 全オブジェクト更新
+        // 2. 全オブジェクト更新（カメラから遠いものは間隔を空け、溜めた時間を分けて更新）
+        ++frameCount_;
+        stats_ = {};
+
+        Vector2 viewMin = { 0.0f, 0.0f };
+        Vector2 viewMax = { 0.0f, 0.0f };
+        if (activityCamera_) {
+            viewMin = activityCamera_->GetTopLeft();
+            viewMax = activityCamera_->GetBottomRight();
+        }
+
+        for (size_t i = 0; i < objects_.size(); ++i) {
+            GameObject2D* obj = objects_[i].get();
+
+            ActivityTier tier = ActivityTier::Near;
+            if (activityCamera_ && !obj->GetInfo().alwaysUpdate) {
+                tier = ComputeActivityTier(*obj, viewMin, viewMax);
+            }
+
+            unsigned int interval = 1;
+            switch (tier) {
+            case ActivityTier::Near:   ++stats_.nearCount; break;
+            case ActivityTier::Middle: ++stats_.middleCount; interval = kMiddleInterval; break;
+            case ActivityTier::Far:    ++stats_.farCount; interval = kFarInterval; break;
+            }
+
+            // 同じフレームに集中しないよう、番号でずらして順番に更新する
+            // 飛ばすステップは PhysicsWorld 側のボディも計算しない
+            if ((frameCount_ + static_cast<unsigned int>(i)) % interval != 0) {
+                obj->AccumulateSkippedTime(deltaTime);
+                physicsWorld_.DeferBody(obj, deltaTime);
+                ++stats_.throttled;
+                continue;
+            }
+
+            // 溜めた時間は一度に進めず、PhysicsWorld::kMaxCatchUpStep 以下に分けて更新する（すり抜け防止）
+            const float updateTime = deltaTime + obj->TakeSkippedTime();
+            const int stepCount = PhysicsWorld::CountCatchUpSteps(updateTime, deltaTime);
+            const float step = updateTime / static_cast<float>(stepCount);
+            for (int s = 0; s < stepCount; ++s) {
+                obj->Update(step);
+            }
+            ++stats_.updated;
+        }
+
+        // 3. 登録ボディの物理計算（積分 → マップ衝突。間引いたボディは飛ばし、溜めた時間は分けて進める）
+        physicsWorld_.Step(deltaTime, &MapData::GetInstance());
+
+        // 4. オブジェクト同士の当たり判定（ペア検出 → Enter/Stay/Exit）
+        collisionWorld_.Update(objects_, deltaTime);
+
+        stats_.total = static_cast<int>(objects_.size());
         for (auto& obj : objects_) {
-            obj->Update(deltaTime);
+            if (obj->IsSleeping()) {
+                ++stats_.sleeping;
+            }
         }
+        stats_.awake = stats_.total - stats_.sleeping;
 
-        // 3. 死亡フラグが立ったオブジェクトを削除
-        objects_.erase(
-            std::remove_if(objects_.begin(), objects_.end(),
-                [](const std::unique_ptr<GameObject2D>& obj) {
-                    return obj->IsDead();
-                }
-            ),
-            objects_.end()
-        );
+        // 5. 死亡フラグが立ったオブジェクトを削除
+        RemoveDeadObjects();
     }
 
-    void Draw(const Camera2D& camera) {
+    /// <summary>
+    /// 指定したもの以外のオブジェクトを今すぐ全て削除する（スナップショットの復元用。Update・Drawの外から呼ぶこと）
+    /// </summary>
+    void RemoveAllExcept(std::initializer_list<const GameObject2D*> keep) {
+        MergePendingObjects();
         for (auto& obj : objects_) {
-            obj->Draw(camera);
+            if (std::find(keep.begin(), keep.end(), obj.get()) == keep.end()) {
+                obj->Destroy();
+            }
         }
+        RemoveDeadObjects();
+    }
+
+    /// <summary>
+    /// 描画順に並べ替え、カメラに映るものだけ描画する
+    /// </summary>
+    void Draw(const Camera2D& camera) {
+        drawList_.Draw(camera);
     }
 
     // 全削除（シーン切り替え時など）
     void Clear() {
+        drawList_.Clear();
+        physicsWorld_.Clear();
+        collisionWorld_.Clear();
+        handles_.Clear();
+        tagMembers_.clear();
         objects_.clear();
         pendingObjects_.clear();
     }
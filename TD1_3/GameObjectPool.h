@@ -0,0 +1,66 @@
+﻿#pragma once
+#include <memory>
+#include <cstddef>
+#include "GameObject2D.h"
+#include "ObjectPool.h"
+
+/// <summary>
+/// 型ごとのプールをGameObject2Dとしてまとめて扱うための窓口
+/// </summary>
+class IGameObjectPool {
+public:
+    virtual ~IGameObjectPool() = default;
+
+    // オブジェクトを破棄して枠をプールへ返す
+    virtual void Release(GameObject2D* obj) = 0;
+};
+
+// プールの型番号を採番する（全ての型で共通のカウンター）
+inline size_t NextGameObjectPoolTypeIndex() {
+    static size_t next = 0;
+    return next++;
+}
+
+/// <summary>
+/// 派生クラスTのオブジェクトを使い回すプール
+/// </summary>
+template <typename T>
+class GameObjectPool : public IGameObjectPool {
+public:
+    T* Create() { return pool_.Create(); }
+    void Release(GameObject2D* obj) override { pool_.Destroy(static_cast<T*>(obj)); }
+
+    void Reserve(size_t count) { pool_.Reserve(count); }
+    size_t GetActiveCount() const { return pool_.GetActiveCount(); }
+    size_t GetCapacity() const { return pool_.GetCapacity(); }
+
+    /// <summary>
+    /// 型ごとに振られる通し番号（マネージャーのプール配列の添字）
+    /// </summary>
+    static size_t TypeIndex() {
+        static const size_t index = NextGameObjectPoolTypeIndex();
+        return index;
+    }
+
+private:
+    ObjectPool<T> pool_;
+};
+
+/// <summary>
+/// unique_ptrの破棄時にオブジェクトを生成元のプールへ返すデリーター
+/// </summary>
+struct PooledObjectDeleter {
+    IGameObjectPool* pool = nullptr;
+
+    void operator()(GameObject2D* obj) const {
+        if (pool) {
+            pool->Release(obj);
+        }
+        else {
+            delete obj;
+        }
+    }
+};
+
+// マネージャーが所有するオブジェクトのポインタ
+using GameObjectPtr = std::unique_ptr<GameObject2D, PooledObjectDeleter>;
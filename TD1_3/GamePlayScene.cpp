@@ -8,9 +8,11 @@
 #include "WorldOrigin.h"
 #include "ParticleManager.h"
 
-#include "PhysicsManager.h"
+#include "SimulationClock.h"
+#include "ObjectRegistry.h"
 
 #include "SceneUtilityIncludes.h"
+#include "WorldSnapshot.h"
 
 GamePlayScene::GamePlayScene(SceneManager& mgr)
 	: manager_(mgr) {
@@ -32,6 +34,7 @@ void GamePlayScene::Initialize() {
 	fade_ = 0.0f;
 
 	objectManager_.Clear();
+	spawnStreamer_.Clear();
 	player_ = nullptr;
 	worldOrigin_ = nullptr;
 
@@ -53,6 +56,7 @@ void GamePlayScene::Initialize() {
 	mapEditor_.SetMapManager(&mapManager_);
 
 	InitializeCamera();
+	objectManager_.SetActivityCamera(camera_.get());
 	InitializeObjects(); // ここでObject生成（マップデータから自動生成）
 	InitializeBackground();
 
@@ -60,6 +64,9 @@ void GamePlayScene::Initialize() {
 	if (player_) {
 		camera_->SetPosition(player_->GetPosition());
 	}
+
+	// 開始位置の周りの配置オブジェクトを先に生成しておく
+	spawnStreamer_.Update(camera_->GetPosition(), objectManager_);
 }
 
 void GamePlayScene::InitializeCamera() {
@@ -75,16 +82,32 @@ void GamePlayScene::InitializeObjects() {
 	auto& mapData = MapData::GetInstance();
 	const auto& spawns = mapData.GetObjectSpawns();
 
+	// 原点・プレイヤーはすぐ生成し、それ以外はカメラが近づいた時に生成する
 	for (const auto& spawn : spawns) {
-		SpawnObjectFromData(spawn);
+		if (IsStartupObjectType(spawn.objectTypeId)) {
+			SpawnObjectFromData(spawn);
+		}
+		else {
+			spawnStreamer_.Add(spawn);
+		}
 	}
+	spawnStreamer_.Build();
+	spawnStreamer_.SetSpawnFunction([this](const SpawnRecord& record) {
+		return SpawnStreamedObject(record);
+	});
 
 	// Playerが生成されていない場合はデフォルト位置に配置
 	if (!player_) {
 		player_ = objectManager_.Spawn<Player>(nullptr, "Player");
+		player_->GetInfo().alwaysUpdate = true;
+		player_->GetInfo().alwaysDraw = true; // Draw内でデバッグウィンドウを出すため
 		player_->SetPosition({ 12000.0f, 12000.0f });
 	}
 
+	// 影はプレイヤーを親にして、位置は足元からの相対値だけ持たせる
+	playerShadow_ = objectManager_.Spawn<DropShadow>(player_, "PlayerShadow");
+	playerShadow_->GetInfo().alwaysUpdate = true;
+
 	// WorldOriginが見つからない場合はデフォルト位置に生成
 	if (!worldOrigin_) {
 		Novice::ConsolePrintf("[GamePlayScene] No WorldOrigin found, creating at default position\n");
@@ -112,24 +135,35 @@ void GamePlayScene::SpawnObjectFromData(const ObjectSpawnInfo& spawn) {
 	case 100: // PlayerStart
 		if (!player_) {
 			player_ = objectManager_.Spawn<Player>(nullptr, "Player");
+			player_->GetInfo().alwaysUpdate = true;
+			player_->GetInfo().alwaysDraw = true; // Draw内でデバッグウィンドウを出すため
 			player_->SetPosition(spawn.position);
 			Novice::ConsolePrintf("[GamePlayScene] Spawned Player at (%.1f, %.1f)\n",
 				spawn.position.x, spawn.position.y);
 		}
 		break;
 
-		// 追加するオブジェクトタイプはここに追加
-		// case 101: // Enemy_Normal
-		//     auto* enemy = objectManager_.Spawn<Enemy>(nullptr, "Enemy");
-		//     enemy->SetPosition(spawn.position);
-		//     break;
-
 	default:
 		Novice::ConsolePrintf("[GamePlayScene] Unknown object type: %d\n", spawn.objectTypeId);
 		break;
 	}
 }
 
+bool GamePlayScene::IsStartupObjectType(int objectTypeId) {
+	return objectTypeId == ObjectTypeId::WorldOrigin || objectTypeId == ObjectTypeId::PlayerStart;
+}
+
+GameObject2D* GamePlayScene::SpawnStreamedObject(const SpawnRecord& record) {
+	// 位置・HPは生成後にSpawnStreamerが反映する。customDataはrecord.paramsに展開済み
+	// 追加するオブジェクトタイプはここに追加
+	// if (record.objectTypeId == ObjectTypeId::EnemyNormal) {
+	//     return objectManager_.Spawn<Enemy>(nullptr, record.tag);
+	// }
+
+	Novice::ConsolePrintf("[GamePlayScene] Unknown object type: %d\n", record.objectTypeId);
+	return nullptr;
+}
+
 void GamePlayScene::InitializeBackground() {
 	background_.clear();
 
@@ -161,6 +195,47 @@ void GamePlayScene::InitializeBackground() {
 	background_[8]->SetPosition({ kWindowWidth, 0.0f });
 }
 
+GameObject2D* GamePlayScene::GetPlayer() const {
+	return player_;
+}
+
+bool GamePlayScene::SaveSnapshot(SnapshotWriter& writer) const {
+	if (!player_ || !worldOrigin_) {
+		return false;
+	}
+
+	writer.Write(fade_);
+	camera_->SaveState(writer);
+	player_->SaveState(writer);
+	worldOrigin_->SaveState(writer);
+	spawnStreamer_.SaveState(writer, objectManager_);
+	particleManager_->SaveState(writer);
+	return true;
+}
+
+bool GamePlayScene::RestoreSnapshot(SnapshotReader& reader) {
+	if (!player_ || !worldOrigin_) {
+		return false;
+	}
+
+	// 開始時からいるもの以外（配置データから生成したものなど）は消し、保存時の状態から作り直す
+	objectManager_.RemoveAllExcept({ player_, worldOrigin_, playerShadow_ });
+
+	reader.Read(fade_);
+	camera_->LoadState(reader);
+	player_->LoadState(reader);
+	worldOrigin_->LoadState(reader);
+	const bool isStreamerRestored = spawnStreamer_.LoadState(reader);
+	particleManager_->LoadState(reader);
+	if (!isStreamerRestored || !reader.IsOk()) {
+		return false;
+	}
+
+	// 戻した位置の周りの配置オブジェクトを作り直す
+	spawnStreamer_.Update(camera_->GetPosition(), objectManager_);
+	return true;
+}
+
 void GamePlayScene::Update(float dt, const char* keys, const char* pre) {
 	if (fade_ < 1.0f) {
 		fade_ += dt * 4.0f;
@@ -193,14 +268,13 @@ void GamePlayScene::Update(float dt, const char* keys, const char* pre) {
 	// 動的タイルの更新(カリングとアニメーション更新)
 	mapManager_.Update(dt,*camera_);
 
+	// カメラの周りに入った配置オブジェクトを生成し、離れたものを片付ける
+	spawnStreamer_.Update(camera_->GetPosition(), objectManager_);
+
 	// GameObjectManager 経由で更新
 	objectManager_.Update(dt);
 
-	// 当たり判定（物理演算)
-	auto& mapData = MapData::GetInstance();
-	if (player_) {
-		PhysicsManager::ResolveMapCollision(player_, mapData);
-	}
+	// プレイヤーのマップ衝突は objectManager_ の PhysicsWorld が解決する
 
 	// GameObjectManager でオブジェクト更新（移動処理）
 	//objectManager_.Update(dt);
@@ -229,6 +303,9 @@ void GamePlayScene::Update(float dt, const char* keys, const char* pre) {
 }
 
 void GamePlayScene::Draw() {
+	// 固定ステップ間の補間位置でカメラ行列を作る
+	camera_->ApplyInterpolation(SimulationClock::GetInstance().GetInterpolationAlpha());
+
 	for (auto& background : background_) {
 		background->Draw(*camera_);
 	}
@@ -260,6 +337,7 @@ void GamePlayScene::Draw() {
 		debugWindow_->DrawCameraDebugWindow(camera_.get());
 		debugWindow_->DrawPlayerDebugWindow(player_);
 		debugWindow_->DrawParticleDebugWindow(particleManager_, player_);
+		debugWindow_->DrawObjectActivityDebugWindow(&objectManager_);
 	}
 #endif
 }
\ No newline at end of file
@@ -10,6 +10,8 @@
 #include <memory>
 #include <vector>
 #include "WorldOrigin.h"
+#include "DropShadow.h"
+#include "SpawnStreamer.h"
 
 class SceneManager;
 class Player;
@@ -25,6 +27,13 @@ public:
     void Update(float dt, const char* keys, const char* pre) override;
     void Draw() override;
 
+    // プレイヤー・原点・配置オブジェクト・パーティクル・カメラの状態を保存・復元する
+    // マップやテクスチャなどの読み込み済みデータはそのまま使う
+    bool SaveSnapshot(SnapshotWriter& writer) const override;
+    bool RestoreSnapshot(SnapshotReader& reader) override;
+
+    GameObject2D* GetPlayer() const override;
+
 private:
     SceneManager& manager_;
 
@@ -32,6 +41,10 @@ private:
     GameObjectManager objectManager_;
     Player* player_ = nullptr;
     WorldOrigin* worldOrigin_ = nullptr; // ワールド原点
+    DropShadow* playerShadow_ = nullptr; // プレイヤーの足元に付いて回る影（プレイヤーが親）
+
+    // 配置データのうち、カメラの周りに入ったものだけを生成する
+    SpawnStreamer spawnStreamer_;
 
     // --- カメラ ---
     std::unique_ptr<Camera2D> camera_;
@@ -63,6 +76,10 @@ private:
     void InitializeObjects();
     void InitializeBackground();
     void SpawnObjectFromData(const ObjectSpawnInfo& spawn);
+    GameObject2D* SpawnStreamedObject(const SpawnRecord& record);
+
+    // 開始時にまとめて生成する種類か（原点・プレイヤーなど、範囲生成しないもの）
+    static bool IsStartupObjectType(int objectTypeId);
 
     // ワールド原点取得
     Vector2 GetWorldOriginOffset() const {
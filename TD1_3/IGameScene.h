@@ -1,5 +1,9 @@
 ﻿#pragma once
 
+class SnapshotWriter;
+class SnapshotReader;
+class GameObject2D;
+
 class IScene {
 public:
 	virtual ~IScene() = default;
@@ -7,4 +11,12 @@ public:
 	virtual void Draw() = 0;
 
 	virtual int GetStageIndex() const { return -1; }
+
+	// シミュレーション状態の保存・復元（リトライ・巻き戻し用）
+	// 対応していないシーンは false を返し、リトライ時は作り直しになる
+	virtual bool SaveSnapshot(SnapshotWriter& writer) const { writer; return false; }
+	virtual bool RestoreSnapshot(SnapshotReader& reader) { reader; return false; }
+
+	// 操作しているプレイヤー（いないシーンはnullptr。リプレイ後の状態比較に使う）
+	virtual GameObject2D* GetPlayer() const { return nullptr; }
 };
\ No newline at end of file
@@ -13,19 +13,73 @@ InputManager::InputManager() {
 	preMousePos_ = mousePos_;
 }
 
+void InputManager::LatchFrame(const char* keys) {
+	if (scriptedKeys_ || injectedFrame_) return;
+
+	for (int i = 0; i < 256; i++) {
+		latchedKeys_[i] |= keys[i];
+	}
+	for (int i = 0; i < 3; i++) {
+		if (Novice::IsPressMouse(i)) {
+			latchedMouseButtons_ |= static_cast<uint8_t>(1 << i);
+		}
+	}
+}
+
 void InputManager::Update() {
+	// 覚えておいたボタンはこのUpdateで使い切る
+	const uint8_t latchedButtons = latchedMouseButtons_;
+	latchedMouseButtons_ = 0;
+
 	// 1. キーボード更新
 	memcpy(preKeys_, keys_, 256);
+	if (scriptedKeys_) {
+		// 差し替え中はキーだけ更新する
+		memcpy(keys_, scriptedKeys_, 256);
+		currentInputMode_ = InputMode::KeyboardMouse;
+		return;
+	}
+	if (injectedFrame_) {
+		// 差し替え中は記録された入力をそのまま読む
+		memcpy(keys_, injectedFrame_->keys, 256);
+		ApplyMouse(injectedFrame_->mouseX, injectedFrame_->mouseY,
+			injectedFrame_->mouseButtons, injectedFrame_->wheel);
+		pad_.Update();
+		UpdateInputMode();
+		return;
+	}
 	Novice::GetHitKeyStateAll(keys_);
+	// 今は離していても、前回のUpdate以降に押されていたキーは押されていたものとして扱う
+	for (int i = 0; i < 256; i++) {
+		keys_[i] |= latchedKeys_[i];
+	}
+	memset(latchedKeys_, 0, sizeof(latchedKeys_));
 
 	// 2. マウス更新
 	int x, y;
 	Novice::GetMousePosition(&x, &y);
+	// 今は離していても、前回のUpdate以降に押されていたボタンは押されていたものとして扱う
+	uint8_t buttons = latchedButtons;
+	for (int i = 0; i < 3; i++) {
+		if (Novice::IsPressMouse(i)) {
+			buttons |= static_cast<uint8_t>(1 << i);
+		}
+	}
+	ApplyMouse(x, y, buttons, Novice::GetWheel());
+
+	// 3. パッド更新
+	pad_.Update();
+
+	// 4. 入力モードの自動検知
+	UpdateInputMode();
+}
+
+void InputManager::ApplyMouse(int x, int y, uint8_t buttons, int wheel) {
 	mousePos_ = { (float)x, (float)y };
 
 	for (int i = 0; i < 3; i++) {
 		preMouseBtn_[i] = currMouseBtn_[i];
-		currMouseBtn_[i] = Novice::IsPressMouse(i);
+		currMouseBtn_[i] = (buttons & (1 << i)) != 0;
 	}
 
 	// 移動量（Delta）の計算
@@ -34,13 +88,49 @@ void InputManager::Update() {
 	preMousePos_ = mousePos_;
 
 	// ホイール更新
-	wheel_ = Novice::GetWheel();
+	wheel_ = wheel;
+}
 
-	// 3. パッド更新
-	pad_.Update();
+// ==========================================
+// 入力の差し替え・記録
+// ==========================================
 
-	// 4. 入力モードの自動検知
-	UpdateInputMode();
+void InputManager::SetInjectedFrame(const InputFrame* frame) {
+	injectedFrame_ = frame;
+	pad_.SetInjectedState(frame ? &frame->pad : nullptr);
+}
+
+InputFrame InputManager::CaptureFrame() const {
+	InputFrame frame;
+	memcpy(frame.keys, keys_, 256);
+	frame.mouseX = static_cast<int>(mousePos_.x);
+	frame.mouseY = static_cast<int>(mousePos_.y);
+	for (int i = 0; i < 3; i++) {
+		if (currMouseBtn_[i]) {
+			frame.mouseButtons |= static_cast<uint8_t>(1 << i);
+		}
+	}
+	frame.wheel = wheel_;
+	frame.pad = pad_.GetRawState();
+	return frame;
+}
+
+void InputManager::ResetToFrame(const InputFrame& frame) {
+	// この入力を「前回の状態」にして、次のUpdateから記録・再生と同じ流れにする
+	memcpy(keys_, frame.keys, 256);
+	memcpy(preKeys_, frame.keys, 256);
+	mousePos_ = { (float)frame.mouseX, (float)frame.mouseY };
+	preMousePos_ = mousePos_;
+	mouseDelta_ = { 0.0f, 0.0f };
+	for (int i = 0; i < 3; i++) {
+		currMouseBtn_[i] = (frame.mouseButtons & (1 << i)) != 0;
+		preMouseBtn_[i] = currMouseBtn_[i];
+	}
+	wheel_ = frame.wheel;
+	pad_.ResetToState(frame.pad);
+
+	currentInputMode_ = InputMode::KeyboardMouse;
+	inputDetectionTimer_ = 0;
 }
 
 // ==========================================
@@ -64,11 +154,12 @@ bool InputManager::ReleaseKey(int diKey) const {
 // ==========================================
 
 bool InputManager::TriggerMouse(MouseButton button) const {
-	return Novice::IsTriggerMouse(static_cast<int>(button));
+	int idx = static_cast<int>(button);
+	return currMouseBtn_[idx] && !preMouseBtn_[idx];
 }
 
 bool InputManager::PressMouse(MouseButton button) const {
-	return Novice::IsPressMouse(static_cast<int>(button));
+	return currMouseBtn_[static_cast<int>(button)];
 }
 
 bool InputManager::ReleaseMouse(MouseButton button) const {
@@ -10,6 +10,16 @@ enum class MouseButton {
 	Middle = 2
 };
 
+// 1ステップ分の入力（記録・再生用）
+struct InputFrame {
+	char keys[256] = {};
+	int mouseX = 0;
+	int mouseY = 0;
+	uint8_t mouseButtons = 0; // ビット0: 左, 1: 右, 2: 中
+	int wheel = 0;
+	Pad::RawState pad;
+};
+
 // 入力モード（どちらで操作しているか）
 enum class InputMode {
 	KeyboardMouse,
@@ -34,6 +44,11 @@ public:
 	// 毎フレーム呼ぶ更新処理
 	void Update();
 
+	// 描画フレームごとに呼ぶ：次のUpdateまでに押されたキーとマウスボタンを覚えておく
+	// （シミュレーションが描画より遅いと、ステップの無いフレームだけで押して離した入力を取りこぼすため）
+	// keys はこのフレームのキー状態（256要素）
+	void LatchFrame(const char* keys);
+
 	// ==========================================
 	// キーボード入力
 	// ==========================================
@@ -47,6 +62,9 @@ public:
 	// キーが離された瞬間だけ true
 	bool ReleaseKey(int diKey) const;
 
+	// 直近のUpdateで読んだキー状態（256要素。覚えておいたキーも押されたものとして入っている）
+	const char* GetKeys() const { return keys_; }
+
 	// ==========================================
 	// マウス入力
 	// ==========================================
@@ -95,10 +113,34 @@ public:
 	// カーソル表示・非表示の切り替え（便利機能）
 	void SetCursorVisibility(bool visible);
 
+	// ==========================================
+	// 入力の差し替え（ベンチマーク・自動テスト用）
+	// ==========================================
+
+	// 実際のキーボードの代わりにこの配列（256要素）をキー状態として読む。nullptrで元に戻す
+	// 差し替え中はマウス・パッドを読まず、入力モードはキーボードに固定する
+	void SetScriptedKeys(const char* keys) { scriptedKeys_ = keys; }
+	bool IsScripted() const { return scriptedKeys_ != nullptr; }
+
+	// 実際の機器の代わりにこの入力（キー・マウス・パッド全部）を読む。nullptrで元に戻す
+	// 記録した入力の再生に使う。入力モードの判定は普段通り行う
+	void SetInjectedFrame(const InputFrame* frame);
+	bool IsInjected() const { return injectedFrame_ != nullptr; }
+
+	// 直近のUpdateで読んだ入力をまとめて取り出す（記録用）
+	InputFrame CaptureFrame() const;
+
+	// 記録・再生の開始時に、前回の状態と入力モードの判定をこの入力で揃える
+	// （記録時と再生時で最初のステップのトリガー判定が食い違わないように）
+	void ResetToFrame(const InputFrame& frame);
+
 private:
 	// キーボード状態
 	char keys_[256] = { 0 };
 	char preKeys_[256] = { 0 };
+	const char* scriptedKeys_ = nullptr; // 差し替え中のキー状態（呼び出し側が所有）
+	const InputFrame* injectedFrame_ = nullptr; // 差し替え中の入力全体（呼び出し側が所有）
+	char latchedKeys_[256] = { 0 }; // 前回のUpdate以降にLatchFrameで押されていたキー
 
 	// マウス状態
 	int wheel_ = 0;
@@ -110,6 +152,7 @@ private:
 	// マウスボタンの状態保存用（左、右、中）
 	bool preMouseBtn_[3] = { false, false, false };
 	bool currMouseBtn_[3] = { false, false, false };
+	uint8_t latchedMouseButtons_ = 0; // 前回のUpdate以降にLatchFrameで押されていたボタン（ビットはInputFrameと同じ）
 
 	// パッド
 	Pad pad_;
@@ -131,4 +174,7 @@ private:
 
 	// モード自動切り替えの内部処理
 	void UpdateInputMode();
+
+	// マウスの位置・ボタン・ホイールを反映する（実機・差し替えの共通処理）
+	void ApplyMouse(int x, int y, uint8_t buttons, int wheel);
 };
\ No newline at end of file
@@ -0,0 +1,320 @@
+﻿#include "InputRecording.h"
+#include <Novice.h>
+#include <fstream>
+#include <cstring>
+#include <iterator>
+
+namespace {
+    constexpr char kMagic[4] = { 'T', 'D', 'I', 'R' };
+    constexpr uint16_t kVersion = 2; // 2: 終了時の状態ハッシュを追加
+
+    // 1ステップ分の先頭1バイト：変わった項目のビット
+    enum ChangeFlag : uint8_t {
+        kKeys = 1 << 0,         // 変わったキーだけ（個数 + (番号, 値) の並び）
+        kKeysFull = 1 << 1,     // キー全部（変わった数が多すぎる時）
+        kMousePos = 1 << 2,
+        kMouseButtons = 1 << 3,
+        kWheel = 1 << 4,
+        kPadButtons = 1 << 5,   // 接続状態とボタン
+        kPadSticks = 1 << 6,
+        kPadTriggers = 1 << 7,
+    };
+
+    // 変わったキーをこの数まで個別に書く（超えたら全部書く方が短い）
+    constexpr size_t kMaxKeyChanges = 127;
+
+    template <typename T>
+    void Put(std::vector<uint8_t>& out, T value) {
+        const size_t offset = out.size();
+        out.resize(offset + sizeof(T));
+        std::memcpy(out.data() + offset, &value, sizeof(T));
+    }
+
+    template <typename T>
+    bool Get(const std::vector<uint8_t>& in, size_t& pos, T& value) {
+        if (pos + sizeof(T) > in.size()) return false;
+        std::memcpy(&value, in.data() + pos, sizeof(T));
+        pos += sizeof(T);
+        return true;
+    }
+
+    // 入力1ステップ分を差分なしでそのまま書く・読む（ファイル先頭の開始時の入力用）
+    void PutFullFrame(std::vector<uint8_t>& out, const InputFrame& frame) {
+        const size_t offset = out.size();
+        out.resize(offset + sizeof(frame.keys));
+        std::memcpy(out.data() + offset, frame.keys, sizeof(frame.keys));
+        Put<int32_t>(out, frame.mouseX);
+        Put<int32_t>(out, frame.mouseY);
+        Put<uint8_t>(out, frame.mouseButtons);
+        Put<int32_t>(out, frame.wheel);
+        Put<uint8_t>(out, frame.pad.connected ? 1 : 0);
+        Put<uint16_t>(out, frame.pad.buttons);
+        Put<int16_t>(out, frame.pad.thumbLX);
+        Put<int16_t>(out, frame.pad.thumbLY);
+        Put<int16_t>(out, frame.pad.thumbRX);
+        Put<int16_t>(out, frame.pad.thumbRY);
+        Put<uint8_t>(out, frame.pad.leftTrigger);
+        Put<uint8_t>(out, frame.pad.rightTrigger);
+    }
+
+    bool GetFullFrame(const std::vector<uint8_t>& in, size_t& pos, InputFrame& frame) {
+        if (pos + sizeof(frame.keys) > in.size()) return false;
+        std::memcpy(frame.keys, in.data() + pos, sizeof(frame.keys));
+        pos += sizeof(frame.keys);
+
+        int32_t mouseX = 0, mouseY = 0, wheel = 0;
+        uint8_t connected = 0;
+        bool ok = Get(in, pos, mouseX) && Get(in, pos, mouseY) &&
+            Get(in, pos, frame.mouseButtons) && Get(in, pos, wheel) &&
+            Get(in, pos, connected) && Get(in, pos, frame.pad.buttons) &&
+            Get(in, pos, frame.pad.thumbLX) && Get(in, pos, frame.pad.thumbLY) &&
+            Get(in, pos, frame.pad.thumbRX) && Get(in, pos, frame.pad.thumbRY) &&
+            Get(in, pos, frame.pad.leftTrigger) && Get(in, pos, frame.pad.rightTrigger);
+        frame.mouseX = mouseX;
+        frame.mouseY = mouseY;
+        frame.wheel = wheel;
+        frame.pad.connected = connected != 0;
+        return ok;
+    }
+}
+
+// ==========================================
+// 記録
+// ==========================================
+
+void InputRecording::Begin(const InputRecordingHeader& header, const InputFrame& initialFrame) {
+    header_ = header;
+    header_.frameCount = 0;
+    header_.fingerprint = 0;
+    initialFrame_ = initialFrame;
+    lastWritten_ = initialFrame;
+    data_.clear();
+    // 1時間分（60Hz）で何も触っていなければ約200KB。最初はその程度を確保しておく
+    data_.reserve(60 * 60 * 60);
+    isRecording_ = true;
+    Rewind();
+}
+
+void InputRecording::Append(const InputFrame& frame) {
+    if (!isRecording_) return;
+
+    const InputFrame& prev = lastWritten_;
+
+    // 変わったキーを数える
+    size_t keyChanges = 0;
+    for (size_t i = 0; i < sizeof(frame.keys); ++i) {
+        if (frame.keys[i] != prev.keys[i]) ++keyChanges;
+    }
+
+    uint8_t flags = 0;
+    if (keyChanges > kMaxKeyChanges) flags |= kKeysFull;
+    else if (keyChanges > 0) flags |= kKeys;
+    if (frame.mouseX != prev.mouseX || frame.mouseY != prev.mouseY) flags |= kMousePos;
+    if (frame.mouseButtons != prev.mouseButtons) flags |= kMouseButtons;
+    if (frame.wheel != prev.wheel) flags |= kWheel;
+    if (frame.pad.connected != prev.pad.connected || frame.pad.buttons != prev.pad.buttons) flags |= kPadButtons;
+    if (frame.pad.thumbLX != prev.pad.thumbLX || frame.pad.thumbLY != prev.pad.thumbLY ||
+        frame.pad.thumbRX != prev.pad.thumbRX || frame.pad.thumbRY != prev.pad.thumbRY) {
+        flags |= kPadSticks;
+    }
+    if (frame.pad.leftTrigger != prev.pad.leftTrigger || frame.pad.rightTrigger != prev.pad.rightTrigger) {
+        flags |= kPadTriggers;
+    }
+
+    Put<uint8_t>(data_, flags);
+
+    if (flags & kKeys) {
+        Put<uint8_t>(data_, static_cast<uint8_t>(keyChanges));
+        for (size_t i = 0; i < sizeof(frame.keys); ++i) {
+            if (frame.keys[i] == prev.keys[i]) continue;
+            Put<uint8_t>(data_, static_cast<uint8_t>(i));
+            Put<char>(data_, frame.keys[i]);
+        }
+    }
+    if (flags & kKeysFull) {
+        const size_t offset = data_.size();
+        data_.resize(offset + sizeof(frame.keys));
+        std::memcpy(data_.data() + offset, frame.keys, sizeof(frame.keys));
+    }
+    if (flags & kMousePos) {
+        // ウィンドウ内の座標なので16bitに収まる
+        Put<int16_t>(data_, static_cast<int16_t>(frame.mouseX));
+        Put<int16_t>(data_, static_cast<int16_t>(frame.mouseY));
+    }
+    if (flags & kMouseButtons) {
+        Put<uint8_t>(data_, frame.mouseButtons);
+    }
+    if (flags & kWheel) {
+        Put<int32_t>(data_, frame.wheel);
+    }
+    if (flags & kPadButtons) {
+        Put<uint8_t>(data_, frame.pad.connected ? 1 : 0);
+        Put<uint16_t>(data_, frame.pad.buttons);
+    }
+    if (flags & kPadSticks) {
+        Put<int16_t>(data_, frame.pad.thumbLX);
+        Put<int16_t>(data_, frame.pad.thumbLY);
+        Put<int16_t>(data_, frame.pad.thumbRX);
+        Put<int16_t>(data_, frame.pad.thumbRY);
+    }
+    if (flags & kPadTriggers) {
+        Put<uint8_t>(data_, frame.pad.leftTrigger);
+        Put<uint8_t>(data_, frame.pad.rightTrigger);
+    }
+
+    lastWritten_ = frame;
+    ++header_.frameCount;
+}
+
+void InputRecording::Finish(uint32_t fingerprint, uint64_t stateHash) {
+    if (!isRecording_) return;
+    header_.fingerprint = fingerprint;
+    header_.stateHash = stateHash;
+    isRecording_ = false;
+}
+
+bool InputRecording::SaveToFile(const std::string& path) const {
+    std::vector<uint8_t> out;
+    out.reserve(64 + sizeof(InputFrame) + data_.size());
+
+    for (const char c : kMagic) {
+        Put<char>(out, c);
+    }
+    Put<uint16_t>(out, kVersion);
+    Put<uint16_t>(out, static_cast<uint16_t>(header_.simulationRate));
+    Put<uint32_t>(out, header_.seed);
+    Put<int32_t>(out, static_cast<int32_t>(header_.startScene));
+    Put<uint32_t>(out, header_.frameCount);
+    Put<uint32_t>(out, header_.fingerprint);
+    Put<uint64_t>(out, header_.stateHash);
+    PutFullFrame(out, initialFrame_);
+    Put<uint32_t>(out, static_cast<uint32_t>(data_.size()));
+    out.insert(out.end(), data_.begin(), data_.end());
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+#ifdef _DEBUG
+        Novice::ConsolePrintf("InputRecording: Failed to open for writing: %s\n", path.c_str());
+#endif
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()));
+    return file.good();
+}
+
+// ==========================================
+// 再生
+// ==========================================
+
+bool InputRecording::LoadFromFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+#ifdef _DEBUG
+        Novice::ConsolePrintf("InputRecording: File not found: %s\n", path.c_str());
+#endif
+        return false;
+    }
+    const std::vector<uint8_t> in((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    size_t pos = 0;
+    char magic[4] = {};
+    uint16_t version = 0;
+    uint16_t rate = 0;
+    int32_t scene = 0;
+    uint32_t dataSize = 0;
+    InputRecordingHeader header;
+    InputFrame initial;
+
+    bool ok = Get(in, pos, magic[0]) && Get(in, pos, magic[1]) && Get(in, pos, magic[2]) && Get(in, pos, magic[3]) &&
+        std::memcmp(magic, kMagic, sizeof(kMagic)) == 0 &&
+        Get(in, pos, version) && version == kVersion &&
+        Get(in, pos, rate) && Get(in, pos, header.seed) && Get(in, pos, scene) &&
+        Get(in, pos, header.frameCount) && Get(in, pos, header.fingerprint) && Get(in, pos, header.stateHash) &&
+        GetFullFrame(in, pos, initial) &&
+        Get(in, pos, dataSize) && pos + dataSize <= in.size();
+    if (!ok) {
+#ifdef _DEBUG
+        Novice::ConsolePrintf("InputRecording: Invalid file: %s\n", path.c_str());
+#endif
+        return false;
+    }
+
+    header.simulationRate = rate;
+    header.startScene = static_cast<SceneType>(scene);
+
+    header_ = header;
+    initialFrame_ = initial;
+    data_.assign(in.begin() + static_cast<std::ptrdiff_t>(pos), in.begin() + static_cast<std::ptrdiff_t>(pos + dataSize));
+    isRecording_ = false;
+    Rewind();
+    return true;
+}
+
+void InputRecording::Rewind() {
+    readPos_ = 0;
+    readFrames_ = 0;
+    readFrame_ = initialFrame_;
+}
+
+const InputFrame* InputRecording::ReadNext() {
+    if (readFrames_ >= header_.frameCount) return nullptr;
+
+    uint8_t flags = 0;
+    if (!Get(data_, readPos_, flags)) return nullptr;
+
+    InputFrame& frame = readFrame_;
+    bool ok = true;
+
+    if (flags & kKeys) {
+        uint8_t count = 0;
+        ok = ok && Get(data_, readPos_, count);
+        for (uint8_t k = 0; ok && k < count; ++k) {
+            uint8_t index = 0;
+            char value = 0;
+            ok = Get(data_, readPos_, index) && Get(data_, readPos_, value);
+            frame.keys[index] = value;
+        }
+    }
+    if (ok && (flags & kKeysFull)) {
+        ok = readPos_ + sizeof(frame.keys) <= data_.size();
+        if (ok) {
+            std::memcpy(frame.keys, data_.data() + readPos_, sizeof(frame.keys));
+            readPos_ += sizeof(frame.keys);
+        }
+    }
+    if (ok && (flags & kMousePos)) {
+        int16_t x = 0, y = 0;
+        ok = Get(data_, readPos_, x) && Get(data_, readPos_, y);
+        frame.mouseX = x;
+        frame.mouseY = y;
+    }
+    if (ok && (flags & kMouseButtons)) {
+        ok = Get(data_, readPos_, frame.mouseButtons);
+    }
+    if (ok && (flags & kWheel)) {
+        int32_t wheel = 0;
+        ok = Get(data_, readPos_, wheel);
+        frame.wheel = wheel;
+    }
+    if (ok && (flags & kPadButtons)) {
+        uint8_t connected = 0;
+        ok = Get(data_, readPos_, connected) && Get(data_, readPos_, frame.pad.buttons);
+        frame.pad.connected = connected != 0;
+    }
+    if (ok && (flags & kPadSticks)) {
+        ok = Get(data_, readPos_, frame.pad.thumbLX) && Get(data_, readPos_, frame.pad.thumbLY) &&
+            Get(data_, readPos_, frame.pad.thumbRX) && Get(data_, readPos_, frame.pad.thumbRY);
+    }
+    if (ok && (flags & kPadTriggers)) {
+        ok = Get(data_, readPos_, frame.pad.leftTrigger) && Get(data_, readPos_, frame.pad.rightTrigger);
+    }
+
+    if (!ok) {
+        // 途中で切れている記録はそこで終わりにする
+        readFrames_ = header_.frameCount;
+        return nullptr;
+    }
+
+    ++readFrames_;
+    return &frame;
+}
@@ -0,0 +1,83 @@
+﻿#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include "InputManager.h"
+#include "SceneType.h"
+
+/// <summary>
+/// 記録の先頭に書く情報（再生時に同じ条件から始めるためのもの）
+/// </summary>
+struct InputRecordingHeader {
+    uint32_t seed = 0;          // RandomStreams::SeedAll に渡した種
+    int simulationRate = 60;    // 固定ステップの周波数
+    SceneType startScene = SceneType::GamePlay; // 記録を始めたシーン（再生時はこのシーンを作り直して始める）
+    uint32_t frameCount = 0;    // 記録したステップ数
+    uint32_t fingerprint = 0;   // 記録終了時の Gameplay 系統の乱数の状態（再生結果が一致したかの確認用）
+    uint64_t stateHash = 0;     // 記録終了時のシミュレーション状態のハッシュ（同上。SceneManager::ComputeStateHash）
+};
+
+/// <summary>
+/// 固定ステップごとの入力の記録
+/// 1ステップ分は「前のステップから変わった項目だけ」を書くので、何も触っていないステップは1バイトで済む
+/// 記録中・再生中とも、変換済みのバイト列だけを持ち、展開した入力は1ステップ分しか持たない
+/// </summary>
+class InputRecording {
+public:
+    // ==========================================
+    // 記録
+    // ==========================================
+
+    /// <summary>
+    /// 記録を始める（それまでの記録は捨てる）
+    /// </summary>
+    /// <param name="header">種・周波数・開始シーン（フレーム数などは記録中に埋める）</param>
+    /// <param name="initialFrame">開始時点の入力（最初のステップの「前回の入力」になる）</param>
+    void Begin(const InputRecordingHeader& header, const InputFrame& initialFrame);
+
+    // 1ステップ分の入力を追加する
+    void Append(const InputFrame& frame);
+
+    // 記録を終える（終了時の乱数の状態とシミュレーション状態のハッシュを残す）
+    void Finish(uint32_t fingerprint, uint64_t stateHash);
+
+    bool IsRecording() const { return isRecording_; }
+
+    bool SaveToFile(const std::string& path) const;
+
+    // ==========================================
+    // 再生
+    // ==========================================
+
+    bool LoadFromFile(const std::string& path);
+
+    // 最初のステップから読み直す
+    void Rewind();
+
+    /// <summary>
+    /// 次のステップの入力を返す（最後まで読んだらnullptr）
+    /// 返した入力は次に呼ぶまで有効
+    /// </summary>
+    const InputFrame* ReadNext();
+
+    const InputRecordingHeader& GetHeader() const { return header_; }
+    const InputFrame& GetInitialFrame() const { return initialFrame_; }
+    size_t GetByteSize() const { return data_.size(); }
+
+private:
+    InputRecordingHeader header_;
+    InputFrame initialFrame_;
+
+    // ステップごとの差分を並べたもの
+    std::vector<uint8_t> data_;
+
+    // 記録中：直前に書いた入力（差分の基準）
+    InputFrame lastWritten_;
+    bool isRecording_ = false;
+
+    // 再生中：読み出し位置と、そこまでを展開した入力
+    size_t readPos_ = 0;
+    uint32_t readFrames_ = 0;
+    InputFrame readFrame_;
+};
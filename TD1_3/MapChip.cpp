@@ -38,17 +38,27 @@ bool MapChip::IsSameTile(int myID, int tx, int ty, TileLayer layer) const {
 
 void MapChip::Draw(Camera2D& camera) {
 	if (!mapData_) return;
-
-	DrawLayer(camera, TileLayer::Decoration);
-	DrawLayer(camera, TileLayer::Block);
+	mapData_->RefreshOcclusionMask();
+
+	// 両レイヤーのタイルを集めてから、頂点をまとめて変換して描画する
+	tileDraws_.clear();
+	tileWorldVertices_.clear();
+	CollectLayer(camera, TileLayer::Decoration);
+	CollectLayer(camera, TileLayer::Block);
+	DrawCollectedTiles(camera);
 }
 
 void MapChip::Draw(Camera2D& camera, const MapData& mapData) {
 	if (!mapData_) return;
 	mapData_ = const_cast<MapData*>(&mapData);
-
-	DrawLayer(camera, TileLayer::Decoration);
-	DrawLayer(camera, TileLayer::Block);
+	mapData_->RefreshOcclusionMask();
+
+	// 両レイヤーのタイルを集めてから、頂点をまとめて変換して描画する
+	tileDraws_.clear();
+	tileWorldVertices_.clear();
+	CollectLayer(camera, TileLayer::Decoration);
+	CollectLayer(camera, TileLayer::Block);
+	DrawCollectedTiles(camera);
 }
 
 // --- カリング範囲計算 ---
@@ -97,8 +107,7 @@ MapChip::DrawSize MapChip::CalculateDrawSize(TileLayer layer, int texW, int texH
 
 // --- タイル頂点計算 ---
 MapChip::TileVertices MapChip::CalculateTileVertices(int x, int y, float tileSize,
-	const Vector2& drawOffset, const DrawSize& drawSize,
-	const Matrix3x3& vpVp) const {
+	const Vector2& drawOffset, const DrawSize& drawSize) const {
 	TileVertices vertices;
 
 	// ワールド座標
@@ -112,12 +121,6 @@ MapChip::TileVertices MapChip::CalculateTileVertices(int x, int y, float tileSiz
 	vertices.worldLB = { tileLeft,  tileBottom };
 	vertices.worldRB = { tileRight, tileBottom };
 
-	// スクリーン座標への変換
-	vertices.screenLT = Matrix3x3::Transform(vertices.worldLT, vpVp);
-	vertices.screenRT = Matrix3x3::Transform(vertices.worldRT, vpVp);
-	vertices.screenLB = Matrix3x3::Transform(vertices.worldLB, vpVp);
-	vertices.screenRB = Matrix3x3::Transform(vertices.worldRB, vpVp);
-
 	return vertices;
 }
 
@@ -192,8 +195,8 @@ MapChip::SrcRect MapChip::CalculateAutoTileSrcRect(int mask, int texW, int texH)
 	return rect;
 }
 
-// --- メイン描画処理 ---
-void MapChip::DrawLayer(Camera2D& camera, TileLayer layer) {
+// --- 描画するタイルの収集 ---
+void MapChip::CollectLayer(Camera2D& camera, TileLayer layer) {
 	if (!mapData_) return;
 
 	const int width = mapData_->GetWidth();
@@ -201,9 +204,11 @@ void MapChip::DrawLayer(Camera2D& camera, TileLayer layer) {
 	const float tileSize = mapData_->GetTileSize();
 	const int cullingMarginTiles = 3;
 
+	// Blockより下のレイヤーは、不透明ブロックに隠れるタイルを描画しない
+	const bool useOcclusion = (layer != TileLayer::Block);
+
 	// 1. カリング範囲計算
 	CullingRange range = CalculateCullingRange(camera, width, height, tileSize, cullingMarginTiles);
-	const Matrix3x3 vpVp = camera.GetVpVpMatrix();
 
 	// 2. タイルループ
 	for (int y = range.startY; y < range.endY; ++y) {
@@ -211,6 +216,9 @@ void MapChip::DrawLayer(Camera2D& camera, TileLayer layer) {
 			const int tileID = mapData_->GetTile(x, y, layer);
 			if (tileID == 0) continue;
 
+			// タイルサイズで描画されるレイヤーはセル単位で判定できる
+			if (useOcclusion && layer != TileLayer::Decoration && mapData_->IsOccluded(x, y)) continue;
+
 			const TileDefinition* def = TileRegistry::GetTile(tileID);
 			if (!def) continue;
 
@@ -233,7 +241,14 @@ void MapChip::DrawLayer(Camera2D& camera, TileLayer layer) {
 			DrawSize drawSize = CalculateDrawSize(layer, texW, texH, tileSize);
 
 			// 6. タイル頂点計算
-			TileVertices vertices = CalculateTileVertices(x, y, tileSize, def->drawOffset, drawSize, vpVp);
+			TileVertices vertices = CalculateTileVertices(x, y, tileSize, def->drawOffset, drawSize);
+
+			// Decorationは実サイズで描画されるため、覆うセルが全て遮蔽されている場合のみ省略
+			if (useOcclusion && layer == TileLayer::Decoration &&
+				mapData_->IsOccluded(x, y) &&
+				mapData_->IsRectOccluded(vertices.worldLT, vertices.worldRB)) {
+				continue;
+			}
 
 			// 7. src矩形計算
 			SrcRect srcRect = { 0, 0, texW, texH };
@@ -242,16 +257,39 @@ void MapChip::DrawLayer(Camera2D& camera, TileLayer layer) {
 				srcRect = CalculateAutoTileSrcRect(mask, texW, texH);
 			}
 
-			// 8. 描画
-			Novice::DrawQuad(
-				static_cast<int>(vertices.screenLT.x), static_cast<int>(vertices.screenLB.y),
-				static_cast<int>(vertices.screenRT.x), static_cast<int>(vertices.screenRB.y),
-				static_cast<int>(vertices.screenLB.x), static_cast<int>(vertices.screenLT.y),
-				static_cast<int>(vertices.screenRB.x), static_cast<int>(vertices.screenRT.y),
-				srcRect.x, srcRect.y, srcRect.w, srcRect.h,
-				handle,
-				0xFFFFFFFF
-			);
+			// 8. 描画リストに積む（頂点は LT, RT, LB, RB の順）
+			tileDraws_.push_back({ handle, srcRect });
+			tileWorldVertices_.push_back(vertices.worldLT);
+			tileWorldVertices_.push_back(vertices.worldRT);
+			tileWorldVertices_.push_back(vertices.worldLB);
+			tileWorldVertices_.push_back(vertices.worldRB);
 		}
 	}
-}
\ No newline at end of file
+}
+
+// --- 集めたタイルの描画 ---
+void MapChip::DrawCollectedTiles(Camera2D& camera) {
+	if (tileDraws_.empty()) return;
+
+	// 全タイルの頂点を1回でスクリーン座標へ変換
+	tileScreenVertices_.resize(tileWorldVertices_.size());
+	camera.GetVpVpAffine().TransformPoints(tileWorldVertices_, tileScreenVertices_);
+
+	for (size_t i = 0; i < tileDraws_.size(); ++i) {
+		const TileDraw& tile = tileDraws_[i];
+		const Vector2& screenLT = tileScreenVertices_[i * 4 + 0];
+		const Vector2& screenRT = tileScreenVertices_[i * 4 + 1];
+		const Vector2& screenLB = tileScreenVertices_[i * 4 + 2];
+		const Vector2& screenRB = tileScreenVertices_[i * 4 + 3];
+
+		Novice::DrawQuad(
+			static_cast<int>(screenLT.x), static_cast<int>(screenLB.y),
+			static_cast<int>(screenRT.x), static_cast<int>(screenRB.y),
+			static_cast<int>(screenLB.x), static_cast<int>(screenLT.y),
+			static_cast<int>(screenRB.x), static_cast<int>(screenRT.y),
+			tile.src.x, tile.src.y, tile.src.w, tile.src.h,
+			tile.handle,
+			0xFFFFFFFF
+		);
+	}
+}
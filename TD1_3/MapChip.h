@@ -2,6 +2,7 @@
 #include <Novice.h>
 #include <map>
 #include <string>
+#include <vector>
 #include "MapData.h"
 #include "Camera2D.h"
 #include "TileRegistry.h"
@@ -24,7 +25,8 @@ private:
 
     void LoadTexturesFromManager();
     bool IsSameTile(int myID, int tx, int ty, TileLayer layer) const;
-    void DrawLayer(Camera2D& camera, TileLayer layer);
+    void CollectLayer(Camera2D& camera, TileLayer layer);
+    void DrawCollectedTiles(Camera2D& camera);
 
     /// <summary>
     /// カリング範囲を計算（マージン付き）
@@ -49,10 +51,9 @@ private:
     /// </summary>
     struct TileVertices {
         Vector2 worldLT, worldRT, worldLB, worldRB;
-        Vector2 screenLT, screenRT, screenLB, screenRB;
     };
     TileVertices CalculateTileVertices(int x, int y, float tileSize, const Vector2& drawOffset,
-        const DrawSize& drawSize, const Matrix3x3& vpVp) const;
+        const DrawSize& drawSize) const;
 
     /// <summary>
     /// オートタイルのマスク値を計算
@@ -66,4 +67,15 @@ private:
         int x, y, w, h;
     };
     SrcRect CalculateAutoTileSrcRect(int mask, int texW, int texH) const;
+
+    /// <summary>
+    /// 描画待ちのタイル（頂点は tileWorldVertices_ に4つずつ並ぶ。配列は毎フレーム使い回す）
+    /// </summary>
+    struct TileDraw {
+        int handle;
+        SrcRect src;
+    };
+    std::vector<TileDraw> tileDraws_;
+    std::vector<Vector2> tileWorldVertices_;
+    std::vector<Vector2> tileScreenVertices_;
 };
\ No newline at end of file
@@ -1,4 +1,5 @@
 ﻿#include "MapData.h"
+#include <cmath>
 
 MapData::MapData() {
     Reset(kMapChipWidth, kMapChipHeight);
@@ -16,6 +17,9 @@ void MapData::Reset(int width, int height, float tileSize) {
 
     // オブジェクトスポーン情報をクリア
     objectSpawns_.clear();
+
+    // 遮蔽マスクは次の描画前に作り直す
+    occlusionDirty_ = true;
 }
 
 bool MapData::Load(const std::string& filePath) {
@@ -62,11 +66,14 @@ bool MapData::Load(const std::string& filePath) {
                 spawn.position.y = obj["position"]["y"];
                 spawn.tag = obj.value("tag", "");
                 spawn.customData = obj.value("data", json::object());
+                spawn.params = SpawnParams::FromJson(spawn.customData);
                 objectSpawns_.push_back(spawn);
             }
             Novice::ConsolePrintf("[MapData] Loaded %d object spawns\n", (int)objectSpawns_.size());
         }
 
+        occlusionDirty_ = true;
+
         Novice::ConsolePrintf("[MapData] Loaded map: %dx%d\n", width_, height_);
         return true;
     }
@@ -114,6 +121,7 @@ void MapData::AddObjectSpawn(int typeId, const Vector2& position, const std::str
     spawn.position = position;
     spawn.tag = tag;
     spawn.customData = customData;
+    spawn.params = SpawnParams::FromJson(customData);
     objectSpawns_.push_back(spawn);
 }
 
@@ -174,4 +182,73 @@ void MapData::SetTile(int col, int row, int tileID, TileLayer layer) {
     if (data && !data->empty()) {
         (*data)[row][col] = tileID;
     }
+
+    // Blockレイヤーの変更は遮蔽マスクに反映
+    if (layer == TileLayer::Block) {
+        UpdateOcclusionAround(col, row);
+    }
+}
+
+void MapData::RefreshOcclusionMask() {
+    if (!occlusionDirty_) return;
+
+    occlusionMask_.assign(static_cast<size_t>(width_) * height_, 0);
+    for (int row = 0; row < height_; ++row) {
+        for (int col = 0; col < width_; ++col) {
+            if (IsOpaqueCell(col, row)) {
+                occlusionMask_[static_cast<size_t>(row) * width_ + col] = 1;
+            }
+        }
+    }
+    occlusionDirty_ = false;
+}
+
+bool MapData::IsRectOccluded(const Vector2& min, const Vector2& max) const {
+    if (occlusionDirty_ || occlusionMask_.empty()) return false;
+
+    // 矩形が触れるセル範囲（右端・下端ちょうどのセルは含めない）
+    const int startCol = static_cast<int>(std::floor(min.x / tileSize_));
+    const int startRow = static_cast<int>(std::floor(min.y / tileSize_));
+    const int endCol = static_cast<int>(std::ceil(max.x / tileSize_));
+    const int endRow = static_cast<int>(std::ceil(max.y / tileSize_));
+
+    for (int row = startRow; row < endRow; ++row) {
+        for (int col = startCol; col < endCol; ++col) {
+            if (!IsOccluded(col, row)) return false;
+        }
+    }
+    return true;
+}
+
+bool MapData::IsOpaqueCell(int col, int row) const {
+    const int id = GetTile(col, row, TileLayer::Block);
+    if (id == 0) return false;
+
+    const TileDefinition* def = TileRegistry::GetTile(id);
+    if (!def || !def->isOpaque || def->renderMode == RenderMode::Component) return false;
+    if (def->type != TileType::AutoTile) return true;
+
+    // オートタイルは周囲8マスが同じタイルの場合（内側パーツ）のみ不透明とみなす
+    // 範囲外はMapChipのオートタイル判定と同じく「同じタイル」扱い
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            const int nx = col + dx;
+            const int ny = row + dy;
+            if (nx < 0 || nx >= width_ || ny < 0 || ny >= height_) continue;
+            if (tilesBlock_[ny][nx] != id) return false;
+        }
+    }
+    return true;
+}
+
+void MapData::UpdateOcclusionAround(int col, int row) {
+    // 未構築なら次のRefreshでまとめて作る
+    if (occlusionDirty_) return;
+
+    for (int ny = row - 1; ny <= row + 1; ++ny) {
+        for (int nx = col - 1; nx <= col + 1; ++nx) {
+            if (nx < 0 || nx >= width_ || ny < 0 || ny >= height_) continue;
+            occlusionMask_[static_cast<size_t>(ny) * width_ + nx] = IsOpaqueCell(nx, ny) ? 1 : 0;
+        }
+    }
 }
\ No newline at end of file
@@ -1,17 +1,43 @@
 ﻿#pragma once
 #include <vector>
 #include <string>
+#include <cstdint>
 #include <Novice.h>
 #include "Vector2.h"
 #include "JsonUtil.h"
 #include "TileRegistry.h"
 
+/// <summary>
+/// customDataを読み込み時に型付きで展開したもの（生成のたびにJSONを引かないため）
+/// 書かれていないキーは既定値のまま
+/// </summary>
+struct SpawnParams {
+    float direction = 0.0f;  // "direction" 向き（ラジアン）
+    int hp = -1;             // "hp" 初期HP（-1 = クラスの既定値を使う）
+    float speed = 0.0f;      // "speed" 移動速度（0 = クラスの既定値を使う）
+    int aiType = 0;          // "ai" AIの種類
+    bool persistent = false; // "persistent" カメラから離れても消さない
+
+    static SpawnParams FromJson(const json& data) {
+        SpawnParams params;
+        if (!data.is_object()) return params;
+
+        params.direction = JsonUtil::GetValue<float>(data, "direction", params.direction);
+        params.hp = JsonUtil::GetValue<int>(data, "hp", params.hp);
+        params.speed = JsonUtil::GetValue<float>(data, "speed", params.speed);
+        params.aiType = JsonUtil::GetValue<int>(data, "ai", params.aiType);
+        params.persistent = JsonUtil::GetValue<bool>(data, "persistent", params.persistent);
+        return params;
+    }
+};
+
 // オブジェクトスポーン情報
 struct ObjectSpawnInfo {
     int objectTypeId;       // オブジェクトタイプID（100=Player, 101=Enemy等）
     Vector2 position;       // ワールド座標（自由配置）
     std::string tag;        // タグ（検索用、例: "player", "enemy"）
-    json customData;        // カスタムパラメータ（向き、HP、AI設定等）
+    json customData;        // カスタムパラメータ（向き、HP、AI設定等）。保存・エディタ用
+    SpawnParams params;     // customDataを展開したもの（ゲーム側はこちらを使う）
 };
 
 /// <summary>
@@ -86,6 +112,35 @@ public:
     std::vector<std::vector<int>>* GetLayerDataMutable(TileLayer layer);
     const std::vector<std::vector<int>>* GetLayerData(TileLayer layer) const;
 
+    // --- 遮蔽マスク（不透明なBlockタイルに完全に覆われたセル） ---
+
+    /// <summary>
+    /// 遮蔽マスクが古ければ作り直す（描画前に呼ぶ）
+    /// タイル定義の登録前に読み込まれた場合もここで反映される
+    /// </summary>
+    void RefreshOcclusionMask();
+
+    /// <summary>
+    /// 指定セルが不透明なBlockタイルに覆われているか（範囲外はfalse）
+    /// </summary>
+    bool IsOccluded(int col, int row) const {
+        if (col < 0 || col >= width_ || row < 0 || row >= height_) return false;
+        if (occlusionDirty_ || occlusionMask_.empty()) return false;
+        return occlusionMask_[static_cast<size_t>(row) * width_ + col] != 0;
+    }
+
+    /// <summary>
+    /// ワールド矩形が覆うセルが全て遮蔽されているか
+    /// </summary>
+    bool IsRectOccluded(const Vector2& min, const Vector2& max) const;
+
+private:
+    // 指定セルのBlockタイルがセル全体を不透明に覆うか
+    bool IsOpaqueCell(int col, int row) const;
+
+    // 指定セルとその周囲8マスの遮蔽状態を更新（オートタイルの見た目が周囲に依存するため）
+    void UpdateOcclusionAround(int col, int row);
+
 private:
     // タイルレイヤー
     std::vector<std::vector<int>> tilesBackground_;
@@ -95,6 +150,10 @@ private:
     // オブジェクトスポーン情報（座標管理）
     std::vector<ObjectSpawnInfo> objectSpawns_;
 
+    // 遮蔽マスク（width * height、1=不透明ブロックで覆われている）
+    std::vector<uint8_t> occlusionMask_;
+    bool occlusionDirty_ = true;
+
     static const int kMapChipWidth = 1000;
     static const int kMapChipHeight = 1000;
 
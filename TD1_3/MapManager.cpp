@@ -47,8 +47,13 @@ void MapManager::Update(float deltaTime, Camera2D& camera) {
 }
 
 void MapManager::Draw(const Camera2D& camera) {
+    auto& mapData = MapData::GetInstance();
+    mapData.RefreshOcclusionMask();
+
     // 描画自体はTileInstance側でDrawComponent2Dを介して行う
     for (auto& tile : dynamicTiles_) {
+        // 不透明ブロックに埋まっている装飾は描画しない
+        if (tile->IsOccluded(mapData)) continue;
         tile->Draw(camera);
     }
 }
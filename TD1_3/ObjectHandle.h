@@ -0,0 +1,112 @@
+﻿#pragma once
+#include <vector>
+#include <cstdint>
+#include <cassert>
+
+class GameObject2D; // 前方宣言
+
+/// <summary>
+/// オブジェクトを指す32bitのハンドル（下位20bit = 番号, 上位12bit = 世代）
+/// オブジェクトが破棄されると世代が進むため、古いハンドルは解決できなくなる
+/// </summary>
+struct ObjectHandle {
+    static constexpr uint32_t kIndexBits = 20;
+    static constexpr uint32_t kIndexMask = (1u << kIndexBits) - 1;
+    static constexpr uint32_t kMaxGeneration = (1u << (32 - kIndexBits)) - 1;
+
+    uint32_t value = 0; // 0 = 無効（世代は1から始まるので有効なハンドルは0にならない）
+
+    static ObjectHandle Make(uint32_t index, uint32_t generation) {
+        return ObjectHandle{ (generation << kIndexBits) | index };
+    }
+
+    uint32_t GetIndex() const { return value & kIndexMask; }
+    uint32_t GetGeneration() const { return value >> kIndexBits; }
+
+    bool IsNull() const { return value == 0; }
+    explicit operator bool() const { return value != 0; }
+
+    bool operator==(const ObjectHandle& other) const { return value == other.value; }
+    bool operator!=(const ObjectHandle& other) const { return value != other.value; }
+};
+
+/// <summary>
+/// ハンドルからオブジェクトを引く表
+/// 番号で配列を直接引き、世代を比べるだけなので有効判定はO(1)
+/// </summary>
+class HandleTable {
+public:
+    /// <summary>
+    /// オブジェクトを登録してハンドルを発行する
+    /// </summary>
+    ObjectHandle Register(GameObject2D* obj) {
+        uint32_t index;
+        if (!freeIndices_.empty()) {
+            index = freeIndices_.back();
+            freeIndices_.pop_back();
+        }
+        else {
+            index = static_cast<uint32_t>(entries_.size());
+            assert(index <= ObjectHandle::kIndexMask && "HandleTable: too many objects");
+            entries_.push_back({});
+        }
+
+        entries_[index].object = obj;
+        return ObjectHandle::Make(index, entries_[index].generation);
+    }
+
+    /// <summary>
+    /// 登録を解除する（世代を進め、このハンドルを無効にする）
+    /// </summary>
+    void Unregister(ObjectHandle handle) {
+        if (!IsValid(handle)) return;
+
+        Entry& entry = entries_[handle.GetIndex()];
+        entry.object = nullptr;
+        entry.generation = (entry.generation >= ObjectHandle::kMaxGeneration) ? 1 : entry.generation + 1;
+        freeIndices_.push_back(handle.GetIndex());
+    }
+
+    /// <summary>
+    /// 格納場所を移したオブジェクトのアドレスを差し替える（ハンドルはそのまま使える）
+    /// </summary>
+    void Relocate(ObjectHandle handle, GameObject2D* newAddress) {
+        if (!IsValid(handle)) return;
+        entries_[handle.GetIndex()].object = newAddress;
+    }
+
+    bool IsValid(ObjectHandle handle) const {
+        const uint32_t index = handle.GetIndex();
+        return !handle.IsNull() &&
+            index < entries_.size() &&
+            entries_[index].object != nullptr &&
+            entries_[index].generation == handle.GetGeneration();
+    }
+
+    /// <summary>
+    /// ハンドルからオブジェクトを取得（破棄済みならnullptr）
+    /// </summary>
+    GameObject2D* Resolve(ObjectHandle handle) const {
+        return IsValid(handle) ? entries_[handle.GetIndex()].object : nullptr;
+    }
+
+    /// <summary>
+    /// 全て解除する（発行済みのハンドルは全て無効になる）
+    /// </summary>
+    void Clear() {
+        for (uint32_t i = 0; i < entries_.size(); ++i) {
+            if (entries_[i].object) {
+                Unregister(ObjectHandle::Make(i, entries_[i].generation));
+            }
+        }
+    }
+
+private:
+    struct Entry {
+        GameObject2D* object = nullptr;
+        uint32_t generation = 1;
+    };
+
+    std::vector<Entry> entries_;
+    std::vector<uint32_t> freeIndices_;
+};
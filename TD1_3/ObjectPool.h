@@ -0,0 +1,90 @@
+﻿#pragma once
+#include <vector>
+#include <memory>
+#include <new>
+#include <cstddef>
+#include <cassert>
+#include <utility>
+
+/// <summary>
+/// 同じ型のオブジェクトを使い回すメモリプール
+/// ブロック単位でまとめて領域を確保し、空き枠にplacement newで構築する
+/// 破棄した枠は空きリストに戻すため、定常状態ではヒープ確保が発生しない
+/// </summary>
+/// <remarks>
+/// ブロックは解放・移動しないので、生成したオブジェクトのアドレスは破棄まで変わらない
+/// </remarks>
+/// <typeparam name="T">格納する型</typeparam>
+/// <typeparam name="BlockSize">1ブロックあたりの枠数</typeparam>
+template <typename T, size_t BlockSize = 64>
+class ObjectPool {
+public:
+    ObjectPool() = default;
+
+    ~ObjectPool() {
+        // 生きているオブジェクトが残っていると破棄できない（所有者が先に返すこと）
+        assert(activeCount_ == 0);
+    }
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    /// <summary>
+    /// 空き枠にオブジェクトを構築する（空きがなければ1ブロック追加）
+    /// </summary>
+    template <typename... Args>
+    T* Create(Args&&... args) {
+        if (freeSlots_.empty()) {
+            AddBlock();
+        }
+
+        Slot* slot = freeSlots_.back();
+        freeSlots_.pop_back();
+        ++activeCount_;
+        return ::new (static_cast<void*>(slot->storage)) T(std::forward<Args>(args)...);
+    }
+
+    /// <summary>
+    /// オブジェクトを破棄して枠を空きリストに戻す
+    /// </summary>
+    void Destroy(T* obj) {
+        if (!obj) return;
+
+        obj->~T();
+        freeSlots_.push_back(reinterpret_cast<Slot*>(obj));
+        --activeCount_;
+    }
+
+    /// <summary>
+    /// 枠を先に確保しておく（ゲーム中の初回確保を避けたい時に使う）
+    /// </summary>
+    void Reserve(size_t count) {
+        while (GetCapacity() < count) {
+            AddBlock();
+        }
+    }
+
+    size_t GetActiveCount() const { return activeCount_; }
+    size_t GetCapacity() const { return blocks_.size() * BlockSize; }
+
+private:
+    // Tのサイズとアラインメントを持つ生の領域
+    struct Slot {
+        alignas(T) std::byte storage[sizeof(T)];
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> blocks_;
+    std::vector<Slot*> freeSlots_; // 後入れ先出し（直前に使った枠ほどキャッシュに残っている）
+    size_t activeCount_ = 0;
+
+    void AddBlock() {
+        blocks_.push_back(std::make_unique<Slot[]>(BlockSize));
+        Slot* block = blocks_.back().get();
+
+        freeSlots_.reserve(GetCapacity());
+        // 先頭の枠から使われるよう逆順に積む
+        for (size_t i = BlockSize; i > 0; --i) {
+            freeSlots_.push_back(&block[i - 1]);
+        }
+    }
+};
@@ -24,7 +24,52 @@ void Pad::ClearState() {
 void Pad::ReadHardware() {
 	XINPUT_STATE state{};
 	DWORD res = XInputGetState(index_, &state);
-	connected_ = (res == ERROR_SUCCESS);
+
+	RawState raw;
+	raw.connected = (res == ERROR_SUCCESS);
+	if (raw.connected) {
+		unsigned short b = state.Gamepad.wButtons;
+
+		// XInputのビットを Button の並び順のビットへ並べ替える
+		auto setBit = [&](Button bt, unsigned short mask) {
+			if (b & mask) {
+				raw.buttons |= static_cast<uint16_t>(1u << static_cast<unsigned>(bt));
+			}
+			};
+		setBit(Button::A, XINPUT_GAMEPAD_A);
+		setBit(Button::B, XINPUT_GAMEPAD_B);
+		setBit(Button::X, XINPUT_GAMEPAD_X);
+		setBit(Button::Y, XINPUT_GAMEPAD_Y);
+		setBit(Button::DPadUp, XINPUT_GAMEPAD_DPAD_UP);
+		setBit(Button::DPadDown, XINPUT_GAMEPAD_DPAD_DOWN);
+		setBit(Button::DPadLeft, XINPUT_GAMEPAD_DPAD_LEFT);
+		setBit(Button::DPadRight, XINPUT_GAMEPAD_DPAD_RIGHT);
+		setBit(Button::Start, XINPUT_GAMEPAD_START);
+		setBit(Button::Back, XINPUT_GAMEPAD_BACK);
+		setBit(Button::LShoulder, XINPUT_GAMEPAD_LEFT_SHOULDER);
+		setBit(Button::RShoulder, XINPUT_GAMEPAD_RIGHT_SHOULDER);
+		setBit(Button::LThumb, XINPUT_GAMEPAD_LEFT_THUMB);
+		setBit(Button::RThumb, XINPUT_GAMEPAD_RIGHT_THUMB);
+
+		raw.thumbLX = state.Gamepad.sThumbLX;
+		raw.thumbLY = state.Gamepad.sThumbLY;
+		raw.thumbRX = state.Gamepad.sThumbRX;
+		raw.thumbRY = state.Gamepad.sThumbRY;
+		raw.leftTrigger = state.Gamepad.bLeftTrigger;
+		raw.rightTrigger = state.Gamepad.bRightTrigger;
+	}
+
+	ApplyRawState(raw);
+}
+
+void Pad::ResetToState(const RawState& state) {
+	ClearState();
+	ApplyRawState(state);
+}
+
+void Pad::ApplyRawState(const RawState& state) {
+	raw_ = state;
+	connected_ = state.connected;
 	if (!connected_) {
 		ClearState();
 		return;
@@ -33,8 +78,6 @@ void Pad::ReadHardware() {
 	// ⭐ 前フレームの状態を保存
 	prev_ = now_;
 
-	unsigned short b = state.Gamepad.wButtons;
-
 	// ⭐ ボタン状態設定のラムダ関数（修正版）
 	auto setBtn = [&](Button bt, bool on) {
 		size_t i = static_cast<size_t>(bt);
@@ -59,30 +102,20 @@ void Pad::ReadHardware() {
 		};
 
 	// ⭐ 各ボタンの状態を設定
-	setBtn(Button::A, (b & XINPUT_GAMEPAD_A) != 0);
-	setBtn(Button::B, (b & XINPUT_GAMEPAD_B) != 0);
-	setBtn(Button::X, (b & XINPUT_GAMEPAD_X) != 0);
-	setBtn(Button::Y, (b & XINPUT_GAMEPAD_Y) != 0);
-	setBtn(Button::DPadUp, (b & XINPUT_GAMEPAD_DPAD_UP) != 0);
-	setBtn(Button::DPadDown, (b & XINPUT_GAMEPAD_DPAD_DOWN) != 0);
-	setBtn(Button::DPadLeft, (b & XINPUT_GAMEPAD_DPAD_LEFT) != 0);
-	setBtn(Button::DPadRight, (b & XINPUT_GAMEPAD_DPAD_RIGHT) != 0);
-	setBtn(Button::Start, (b & XINPUT_GAMEPAD_START) != 0);
-	setBtn(Button::LShoulder, (b & XINPUT_GAMEPAD_LEFT_SHOULDER) != 0);
-	setBtn(Button::RShoulder, (b & XINPUT_GAMEPAD_RIGHT_SHOULDER) != 0);
-	setBtn(Button::LThumb, (b & XINPUT_GAMEPAD_LEFT_THUMB) != 0);
-	setBtn(Button::RThumb, (b & XINPUT_GAMEPAD_RIGHT_THUMB) != 0);
+	for (int i = 0; i < static_cast<int>(Button::COUNT); ++i) {
+		setBtn(static_cast<Button>(i), (state.buttons & (1u << static_cast<unsigned>(i))) != 0);
+	}
 
 	// スティック正規化
 	const float stickNorm = 1.0f / 32767.0f;
-	leftX_ = ApplyDeadZone(state.Gamepad.sThumbLX * stickNorm, 0.15f);
-	leftY_ = ApplyDeadZone(state.Gamepad.sThumbLY * stickNorm, 0.15f);
-	rightX_ = ApplyDeadZone(state.Gamepad.sThumbRX * stickNorm, 0.15f);
-	rightY_ = ApplyDeadZone(state.Gamepad.sThumbRY * stickNorm, 0.15f);
+	leftX_ = ApplyDeadZone(state.thumbLX * stickNorm, 0.15f);
+	leftY_ = ApplyDeadZone(state.thumbLY * stickNorm, 0.15f);
+	rightX_ = ApplyDeadZone(state.thumbRX * stickNorm, 0.15f);
+	rightY_ = ApplyDeadZone(state.thumbRY * stickNorm, 0.15f);
 
 	// トリガ
-	leftTrigger_ = state.Gamepad.bLeftTrigger / 255.0f;
-	rightTrigger_ = state.Gamepad.bRightTrigger / 255.0f;
+	leftTrigger_ = state.leftTrigger / 255.0f;
+	rightTrigger_ = state.rightTrigger / 255.0f;
 	if (leftTrigger_ < 0.05f) leftTrigger_ = 0.0f;
 	if (rightTrigger_ < 0.05f) rightTrigger_ = 0.0f;
 }
@@ -107,6 +140,10 @@ void Pad::ApplyVibration() {
 }
 
 void Pad::Update() {
+	if (injected_) {
+		ApplyRawState(*injected_);
+		return;
+	}
 	ReadHardware();
 	ApplyVibration();
 }
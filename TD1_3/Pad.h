@@ -22,6 +22,15 @@ public:
 		COUNT
 	};
 
+	// 1フレーム分の加工前の入力（記録・再生用。ボタンは Button の並び順のビット）
+	struct RawState {
+		bool connected = false;
+		uint16_t buttons = 0;
+		int16_t thumbLX = 0, thumbLY = 0;
+		int16_t thumbRX = 0, thumbRY = 0;
+		uint8_t leftTrigger = 0, rightTrigger = 0;
+	};
+
 	explicit Pad(uint32_t index = 0);
 
 	void Update();
@@ -47,6 +56,15 @@ public:
 	void StopVibration();
 	bool IsConnected() const { return connected_; }
 
+	// 直近のUpdateで読んだ加工前の入力
+	const RawState& GetRawState() const { return raw_; }
+
+	// 実機の代わりにこの入力を読む（nullptrで元に戻す）。差し替え中は振動させない
+	void SetInjectedState(const RawState* state) { injected_ = state; }
+
+	// 押しっぱなしの情報を捨て、この入力から始め直す（記録・再生の開始時用）
+	void ResetToState(const RawState& state);
+
 private:
 	uint32_t index_;
 	bool connected_ = false;
@@ -59,11 +77,15 @@ private:
 	float rightX_ = 0.0f, rightY_ = 0.0f;
 	float leftTrigger_ = 0.0f, rightTrigger_ = 0.0f;
 
+	RawState raw_;
+	const RawState* injected_ = nullptr; // 差し替え中の入力（呼び出し側が所有）
+
 	int   vibRemainFrames_ = 0;
 	float vibLeft_ = 0.0f, vibRight_ = 0.0f;
 
 	static float ApplyDeadZone(float v, float dz);
 	void ApplyVibration();
 	void ReadHardware();
+	void ApplyRawState(const RawState& state);
 	void ClearState();
 };
\ No newline at end of file
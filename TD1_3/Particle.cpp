@@ -106,18 +106,14 @@ void Particle::Update(float deltaTime) {
 	else if (behavior_ == ParticleBehavior::Homing) {
 		// Homing 挙動
 		if (homingTarget_ != nullptr) {
-			// ターゲットへの方向ベクトルを計算
-			Vector2 direction = {
+			// ターゲットへの方向と距離（平方根は1回だけ）
+			const Vector2 toTarget = {
 				homingTarget_->x - position_.x,
 				homingTarget_->y - position_.y
 			};
-
-			// 正規化
-			float length = sqrtf(direction.x * direction.x + direction.y * direction.y);
+			float length = 0.0f;
+			const Vector2 direction = Vector2::LengthAndNormalize(toTarget, length);
 			if (length > 0.001f) {
-				direction.x /= length;
-				direction.y /= length;
-
 				// ターゲット方向への加速度を追加
 				velocity_.x += direction.x * homingStrength_ * deltaTime;
 				velocity_.y += direction.y * homingStrength_ * deltaTime;
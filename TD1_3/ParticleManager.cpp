@@ -6,6 +6,8 @@
 #include "json.hpp"
 #include "Camera2D.h"
 #include "Effect.h"
+#include "Random.h"
+#include "WorldSnapshot.h"
 
 // nlohmann/json の警告を抑制
 #pragma warning(push)
@@ -484,18 +486,19 @@ void ParticleManager::Update(float deltaTime) {
 // ========== Draw メソッド ==========
 void ParticleManager::Draw(const Camera2D& camera) {
 	// カメラから ViewProjectionMatrix を取得
-	Matrix3x3 vpMatrix = camera.GetVpVpMatrix();
+	const Affine2x3& vpMatrix = camera.GetVpVpAffine();
 
 	// ズーム倍率（描画サイズにも反映させる）
 	const float cameraZoom = camera.GetZoom();
 
-	// パーティクルタイプごとにブレンドモードをグループ化して描画
+	// 1. パーティクルタイプごとに描画情報とワールド頂点を集める（ブレンドモードのグループ順を保つ）
+	drawEntries_.clear();
+	drawWorldPoints_.clear();
+
 	for (auto it = params_.begin(); it != params_.end(); ++it) {
 		ParticleType type = it->first;
 		const ParticleParam& param = it->second;
 
-		Novice::SetBlendMode(param.blendMode);
-
 		for (auto& p : particles_) {
 			if (!p.IsAlive() || p.GetType() != type) continue;
 
@@ -506,90 +509,111 @@ void ParticleManager::Draw(const Camera2D& camera) {
 			int texWidth, texHeight;
 			Novice::GetTextureSize(p.GetTextureHandle(), &texWidth, &texHeight);
 
+			ParticleDrawEntry entry{};
+			entry.textureHandle = p.GetTextureHandle();
+			entry.color = p.GetCurrentColor();
+			entry.blendMode = param.blendMode;
+			entry.firstPoint = drawWorldPoints_.size();
+
 			// ソース矩形
-			int srcX = 0, srcY = 0;
-			int srcW = texWidth, srcH = texHeight;
+			entry.srcX = 0;
+			entry.srcY = 0;
+			entry.srcW = texWidth;
+			entry.srcH = texHeight;
 			if (p.UseAnimation()) {
 				int divX = p.GetDivX();
 				int divY = p.GetDivY();
 				int frame = p.GetCurrentFrame();
-				srcW = texWidth / divX;
-				srcH = texHeight / divY;
+				entry.srcW = texWidth / divX;
+				entry.srcH = texHeight / divY;
 				int frameX = frame % divX;
 				int frameY = frame / divX;
-				srcX = frameX * srcW;
-				srcY = frameY * srcH;
+				entry.srcX = frameX * entry.srcW;
+				entry.srcY = frameY * entry.srcH;
 			}
 
 			// 描画サイズ（ピクセル基準）
 			float baseSize = p.GetDrawSize();
 			if (baseSize <= 0.0f) {
-				baseSize = static_cast<float>(srcW);
+				baseSize = static_cast<float>(entry.srcW);
 			}
 			float finalScale = p.GetCurrentScale();
 
 			// カメラズームを描画サイズに反映
-			float drawWidth = baseSize * finalScale * cameraZoom;
-			float drawHeight = baseSize * finalScale * cameraZoom;
+			entry.drawWidth = baseSize * finalScale * cameraZoom;
+			entry.drawHeight = baseSize * finalScale * cameraZoom;
 
 			float rot = p.GetRotation();
-
-			if (std::fabs(rot) > 1e-4f) {
-				// 回転付き：ワールド空間で回転 → 各頂点を行列でスクリーンへ
-				float hw = drawWidth * 0.5f;
-				float hh = drawHeight * 0.5f;
-
-				Vector2 ltLocal = { -hw,  hh };
-				Vector2 rtLocal = { hw,  hh };
-				Vector2 lbLocal = { -hw, -hh };
-				Vector2 rbLocal = { hw, -hh };
-
-				float c = std::cos(rot);
-				float s = std::sin(rot);
-
-				auto RotateAddCenter = [&](const Vector2& v) -> Vector2 {
-					return {
-						worldPos.x + (v.x * c - v.y * s),
-						worldPos.y + (v.x * s + v.y * c)
-					};
-					};
-
-				Vector2 wLT = RotateAddCenter(ltLocal);
-				Vector2 wRT = RotateAddCenter(rtLocal);
-				Vector2 wLB = RotateAddCenter(lbLocal);
-				Vector2 wRB = RotateAddCenter(rbLocal);
-
-				Vector2 vLT = Matrix3x3::Transform(wLT, vpMatrix);
-				Vector2 vRT = Matrix3x3::Transform(wRT, vpMatrix);
-				Vector2 vLB = Matrix3x3::Transform(wLB, vpMatrix);
-				Vector2 vRB = Matrix3x3::Transform(wRB, vpMatrix);
-
-				Novice::DrawQuad(
-					static_cast<int>(vLT.x), static_cast<int>(vLT.y),
-					static_cast<int>(vRT.x), static_cast<int>(vRT.y),
-					static_cast<int>(vLB.x), static_cast<int>(vLB.y),
-					static_cast<int>(vRB.x), static_cast<int>(vRB.y),
-					srcX, srcY, srcW, srcH,
-					p.GetTextureHandle(),
-					p.GetCurrentColor()
-				);
+			entry.isRotated = std::fabs(rot) > 1e-4f;
+
+			if (entry.isRotated) {
+				// 回転付き：ワールド空間で回転した4頂点を積む（スクリーンへはあとでまとめて変換）
+				float hw = entry.drawWidth * 0.5f;
+				float hh = entry.drawHeight * 0.5f;
+
+				const Affine2x3 world = Affine2x3::MakeAffine({ 1.0f, 1.0f }, std::cos(rot), std::sin(rot), worldPos);
+				const Vector2 local[4] = { { -hw, hh }, { hw, hh }, { -hw, -hh }, { hw, -hh } };
+				Vector2 worldVertices[4];
+				world.TransformQuad(local, worldVertices);
+				drawWorldPoints_.insert(drawWorldPoints_.end(), std::begin(worldVertices), std::end(worldVertices));
 			}
 			else {
-				Vector2 screenPos = Matrix3x3::Transform(worldPos, vpMatrix);
-
-				float offsetX = screenPos.x - drawWidth * 0.5f;
-				float offsetY = screenPos.y - drawHeight * 0.5f;
-
-				Novice::DrawQuad(
-					static_cast<int>(offsetX), static_cast<int>(offsetY),
-					static_cast<int>(offsetX + drawWidth), static_cast<int>(offsetY),
-					static_cast<int>(offsetX), static_cast<int>(offsetY + drawHeight),
-					static_cast<int>(offsetX + drawWidth), static_cast<int>(offsetY + drawHeight),
-					srcX, srcY, srcW, srcH,
-					p.GetTextureHandle(),
-					p.GetCurrentColor()
-				);
+				// 回転なし：中心だけ変換し、スクリーン上で軸に沿って広げる
+				drawWorldPoints_.push_back(worldPos);
 			}
+
+			drawEntries_.push_back(entry);
+		}
+	}
+
+	if (drawEntries_.empty()) return;
+
+	// 2. 全パーティクルの頂点を1回でスクリーンへ変換
+	drawScreenPoints_.resize(drawWorldPoints_.size());
+	vpMatrix.TransformPoints(drawWorldPoints_, drawScreenPoints_);
+
+	// 3. 集めた順に描画（ブレンドモードはタイプの切り替わりで設定）
+	bool hasBlendMode = false;
+	BlendMode currentBlendMode = kBlendModeNormal;
+
+	for (const ParticleDrawEntry& entry : drawEntries_) {
+		if (!hasBlendMode || entry.blendMode != currentBlendMode) {
+			Novice::SetBlendMode(entry.blendMode);
+			currentBlendMode = entry.blendMode;
+			hasBlendMode = true;
+		}
+
+		const Vector2* screen = &drawScreenPoints_[entry.firstPoint];
+
+		if (entry.isRotated) {
+			const Vector2& vLT = screen[0];
+			const Vector2& vRT = screen[1];
+			const Vector2& vLB = screen[2];
+			const Vector2& vRB = screen[3];
+
+			Novice::DrawQuad(
+				static_cast<int>(vLT.x), static_cast<int>(vLT.y),
+				static_cast<int>(vRT.x), static_cast<int>(vRT.y),
+				static_cast<int>(vLB.x), static_cast<int>(vLB.y),
+				static_cast<int>(vRB.x), static_cast<int>(vRB.y),
+				entry.srcX, entry.srcY, entry.srcW, entry.srcH,
+				entry.textureHandle,
+				entry.color
+			);
+		}
+		else {
+			float offsetX = screen[0].x - entry.drawWidth * 0.5f;
+			float offsetY = screen[0].y - entry.drawHeight * 0.5f;
+
+			Novice::DrawQuad(
+				static_cast<int>(offsetX), static_cast<int>(offsetY),
+				static_cast<int>(offsetX + entry.drawWidth), static_cast<int>(offsetY),
+				static_cast<int>(offsetX), static_cast<int>(offsetY + entry.drawHeight),
+				static_cast<int>(offsetX + entry.drawWidth), static_cast<int>(offsetY + entry.drawHeight),
+				entry.srcX, entry.srcY, entry.srcW, entry.srcH,
+				entry.textureHandle,
+				entry.color
+			);
 		}
 	}
 
@@ -965,9 +989,19 @@ Particle& ParticleManager::GetNextParticle() {
 	return p;
 }
 
+void ParticleManager::SaveState(SnapshotWriter& writer) const {
+	writer.Write(particles_);
+	writer.Write(nextIndex_);
+}
+
+void ParticleManager::LoadState(SnapshotReader& reader) {
+	reader.Read(particles_);
+	reader.Read(nextIndex_);
+}
+
 float ParticleManager::RandomFloat(float min, float max) {
 	if (min >= max) return min;
-	return min + static_cast<float>(rand()) / (static_cast<float>(RAND_MAX / (max - min)));
+	return Rng(RandomStreamId::Visual).RandomFloat(min, max);
 }
 
 void ParticleManager::DrawDebugWindow() {
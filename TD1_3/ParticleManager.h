@@ -12,6 +12,8 @@
 // 前方宣言
 class Camera2D;
 class DebugWindow;
+class SnapshotWriter;
+class SnapshotReader;
 
 // エミッターの追従モード
 enum class EmitterFollowMode {
@@ -114,6 +116,10 @@ public:
 	ParticleParam* GetParam(ParticleType type);
 	const ParticleParam* GetParam(ParticleType type) const;
 
+	// 飛んでいるパーティクルの保存・復元（リトライ・巻き戻し用。固定長の配列をそのまま写す）
+	void SaveState(SnapshotWriter& writer) const;
+	void LoadState(SnapshotReader& reader);
+
 private:
 	void LoadParams();
 	Particle& GetNextParticle();
@@ -139,6 +145,17 @@ private:
 		bool isActive = false;
 	};
 
+	// 描画1件分の情報（頂点は drawWorldPoints_ の firstPoint から、回転付きは4つ・回転なしは中心の1つ）
+	struct ParticleDrawEntry {
+		int textureHandle;
+		unsigned int color;
+		BlendMode blendMode;
+		int srcX, srcY, srcW, srcH;
+		float drawWidth, drawHeight;
+		size_t firstPoint;
+		bool isRotated;
+	};
+
 	static const int kMaxParticles = 2048;
 	std::array<Particle, kMaxParticles> particles_;
 	int nextIndex_ = 0;
@@ -148,6 +165,11 @@ private:
 
 	float groundLevel_ = 0.0f;  // 地面のY座標
 
+	// 描画の作業領域（全パーティクルの頂点をまとめてスクリーンへ変換する。毎フレーム使い回す）
+	std::vector<ParticleDrawEntry> drawEntries_;
+	std::vector<Vector2> drawWorldPoints_;
+	std::vector<Vector2> drawScreenPoints_;
+
 	int texExplosion_ = -1;
 	int texDebris_ = -1;
 	int texHit_ = -1;
@@ -5,16 +5,23 @@
 void PhysicsManager::ResolveMapCollision(GameObject2D* obj, const MapData& map) {
     if (!obj) return;
 
-    // 1. オブジェクトのAABB（当たり判定の四角形）情報を取得
     Transform2D& transform = obj->GetTransform();
     Collider& collider = obj->GetCollider();
     Rigidbody2D& rb = obj->GetRigidbody();
 
     if (!collider.canCollide) return;
 
+    ResolveBox(transform.translate, rb.velocity, collider, map);
+
+    // 最後にワールド行列を再計算（位置が変わったため）
+    transform.CalculateWorldMatrix();
+}
+
+void PhysicsManager::ResolveBox(Vector2& position, Vector2& velocity, const Collider& collider, const MapData& map) {
+    // 1. オブジェクトのAABB（当たり判定の四角形）情報を取得
     // ワールド座標での左上座標とサイズ
-    float objLeft = transform.translate.x + collider.offset.x - collider.size.x * 0.5f;
-    float objTop = transform.translate.y + collider.offset.y - collider.size.y * 0.5f;
+    float objLeft = position.x + collider.offset.x - collider.size.x * 0.5f;
+    float objTop = position.y + collider.offset.y - collider.size.y * 0.5f;
     float objW = collider.size.x;
     float objH = collider.size.y;
     float objRight = objLeft + objW;
@@ -65,28 +72,25 @@ void PhysicsManager::ResolveMapCollision(GameObject2D* obj, const MapData& map)
 
                 if (std::abs(ox) < std::abs(oy)) {
                     // X軸方向のめり込みの方が浅い -> 横に押し出す
-                    transform.translate.x += (dx1 < dx2) ? dx1 : -dx2;
-                    rb.velocity.x = 0.0f; // 壁にぶつかったので速度リセット
+                    position.x += (dx1 < dx2) ? dx1 : -dx2;
+                    velocity.x = 0.0f; // 壁にぶつかったので速度リセット
 
                     // 座標更新に伴いAABB情報も更新しないと、次のブロック判定でおかしくなる
-                    objLeft = transform.translate.x + collider.offset.x - collider.size.x * 0.5f;
+                    objLeft = position.x + collider.offset.x - collider.size.x * 0.5f;
                     objRight = objLeft + objW;
                 }
                 else {
                     // Y軸方向のめり込みの方が浅い -> 縦に押し出す
-                    transform.translate.y += (dy1 < dy2) ? dy1 : -dy2;
-                    rb.velocity.y = 0.0f; // 床/天井にぶつかったので速度リセット
+                    position.y += (dy1 < dy2) ? dy1 : -dy2;
+                    velocity.y = 0.0f; // 床/天井にぶつかったので速度リセット
 
                     // 座標更新
-                    objTop = transform.translate.y + collider.offset.y - collider.size.y * 0.5f;
+                    objTop = position.y + collider.offset.y - collider.size.y * 0.5f;
                     objBottom = objTop + objH;
                 }
             }
         }
     }
-
-    // 最後にワールド行列を再計算（位置が変わったため）
-    transform.CalculateWorldMatrix();
 }
 
 bool PhysicsManager::CheckAABB(float x1, float y1, float w1, float h1, float x2, float y2, float w2, float h2) {
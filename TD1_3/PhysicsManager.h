@@ -16,8 +16,17 @@ public:
     /// </summary>
     static void ResolveMapCollision(GameObject2D* obj, const MapData& map);
 
-    // （必要に応じて）全オブジェクト一括処理用
-    // static void Update(std::vector<GameObject2D*>& objects, const MapData& map);
+    /// <summary>
+    /// 座標・速度を直接受け取るマップ衝突解決
+    /// （PhysicsWorldの一括処理からも使う）
+    /// </summary>
+    /// <param name="position">オブジェクトの中心座標（補正される）</param>
+    /// <param name="velocity">速度（衝突した軸が0になる）</param>
+    /// <param name="collider">当たり判定情報</param>
+    /// <param name="map">マップデータ</param>
+    static void ResolveBox(Vector2& position, Vector2& velocity, const Collider& collider, const MapData& map);
+
+    // 全オブジェクト一括処理は PhysicsWorld::Step を使用
 
 private:
     // 矩形同士の衝突チェック（ヘルパー関数）
@@ -0,0 +1,379 @@
+﻿#include "PhysicsWorld.h"
+#include "GameObject2D.h"
+#include "MapData.h"
+#include "PhysicsManager.h"
+#include <algorithm>
+#include <execution>
+#include <cmath>
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#include <emmintrin.h>
+#define PHYSICS_WORLD_USE_SSE
+#endif
+
+void PhysicsWorld::AddBody(GameObject2D* obj, bool collideWithMap) {
+    if (!obj) return;
+
+    // 登録済みなら設定のみ更新
+    if (obj->physicsBodyIndex_ >= 0) {
+        collideWithMap_[obj->physicsBodyIndex_] = collideWithMap ? 1 : 0;
+        return;
+    }
+
+    obj->physicsBodyIndex_ = static_cast<int>(bodies_.size());
+    bodies_.push_back(obj);
+    collideWithMap_.push_back(collideWithMap ? 1 : 0);
+    isDeferred_.push_back(0);
+    deferredTime_.push_back(0.0f);
+
+    // 減衰係数は次のGatherで計算させる（負の減速率は存在しないので必ず不一致になる）
+    cachedDecelX_.push_back(-1.0f);
+    cachedDecelY_.push_back(-1.0f);
+    cachedAngularDecel_.push_back(-1.0f);
+    cachedDampX_.push_back(1.0f);
+    cachedDampY_.push_back(1.0f);
+    cachedAngularDamp_.push_back(1.0f);
+}
+
+void PhysicsWorld::RemoveBody(GameObject2D* obj) {
+    if (!obj || obj->physicsBodyIndex_ < 0) return;
+
+    const size_t index = static_cast<size_t>(obj->physicsBodyIndex_);
+    obj->physicsBodyIndex_ = -1;
+
+    // 末尾のボディを空いた番号へ移す
+    if (index + 1 < bodies_.size()) {
+        bodies_.back()->physicsBodyIndex_ = static_cast<int>(index);
+    }
+
+    SwapAndPop(bodies_, index);
+    SwapAndPop(collideWithMap_, index);
+    SwapAndPop(isDeferred_, index);
+    SwapAndPop(deferredTime_, index);
+    SwapAndPop(cachedDecelX_, index);
+    SwapAndPop(cachedDecelY_, index);
+    SwapAndPop(cachedAngularDecel_, index);
+    SwapAndPop(cachedDampX_, index);
+    SwapAndPop(cachedDampY_, index);
+    SwapAndPop(cachedAngularDamp_, index);
+}
+
+void PhysicsWorld::Clear() {
+    for (GameObject2D* obj : bodies_) {
+        obj->physicsBodyIndex_ = -1;
+    }
+    bodies_.clear();
+    collideWithMap_.clear();
+    isDeferred_.clear();
+    deferredTime_.clear();
+    cachedDecelX_.clear();
+    cachedDecelY_.clear();
+    cachedAngularDecel_.clear();
+    cachedDampX_.clear();
+    cachedDampY_.clear();
+    cachedAngularDamp_.clear();
+    slotBody_.clear();
+    uniformSlotCount_ = 0;
+}
+
+void PhysicsWorld::DeferBody(GameObject2D* obj, float deltaTime) {
+    if (!obj || obj->physicsBodyIndex_ < 0) return;
+
+    const size_t index = static_cast<size_t>(obj->physicsBodyIndex_);
+    isDeferred_[index] = 1;
+    deferredTime_[index] += deltaTime;
+}
+
+void PhysicsWorld::Step(float deltaTime, const MapData* map) {
+    if (bodies_.empty()) {
+        slotBody_.clear();
+        return;
+    }
+
+    // 1. 起きているボディの状態を収集（減衰係数キャッシュもここで更新）
+    Gather(deltaTime);
+
+    const size_t count = slotBody_.size();
+    if (count == 0) return;
+
+    // 2, 3. 積分とマップ衝突はボディごとに独立なので範囲単位で処理する（溜めた時間を持つボディは後で個別に）
+    const size_t uniformCount = uniformSlotCount_;
+    auto process = [this, deltaTime, map](const std::pair<size_t, size_t>& range) {
+        IntegrateRange(range.first, range.second, deltaTime);
+        if (map) {
+            ResolveMapRange(range.first, range.second, *map);
+        }
+    };
+
+    if (isParallel_ && uniformCount >= kParallelThreshold) {
+        chunks_.clear();
+        for (size_t begin = 0; begin < uniformCount; begin += kChunkSize) {
+            chunks_.emplace_back(begin, std::min(begin + kChunkSize, uniformCount));
+        }
+        std::for_each(std::execution::par, chunks_.begin(), chunks_.end(), process);
+    }
+    else if (uniformCount > 0) {
+        process({ 0, uniformCount });
+    }
+
+    // 間引かれていたボディは、溜めた時間を kMaxCatchUpStep 以下に分けて進める
+    for (size_t i = uniformCount; i < count; ++i) {
+        CatchUpSlot(i, catchUpTime_[i - uniformCount], deltaTime, map);
+    }
+
+    // 4. 結果の書き戻し
+    Scatter();
+}
+
+void PhysicsWorld::Gather(float deltaTime) {
+    const size_t bodyCount = bodies_.size();
+
+    slotBody_.clear();
+    slotCollideWithMap_.clear();
+    posX_.clear();
+    posY_.clear();
+    velX_.clear();
+    velY_.clear();
+    accX_.clear();
+    accY_.clear();
+    maxSpeed_.clear();
+    rotation_.clear();
+    angularVelocity_.clear();
+    angularAcceleration_.clear();
+    maxAngularSpeed_.clear();
+    dampX_.clear();
+    dampY_.clear();
+    angularDamp_.clear();
+    catchUpBodies_.clear();
+    catchUpTime_.clear();
+
+    // dtが変わったら全ボディの減衰係数を作り直す
+    const bool dtChanged = (deltaTime != cachedDeltaTime_);
+    cachedDeltaTime_ = deltaTime;
+
+    for (size_t i = 0; i < bodyCount; ++i) {
+        GameObject2D* obj = bodies_[i];
+
+        // 間引かれたボディは時間を溜めたまま今回は飛ばす（印はこのStepだけ有効）
+        if (isDeferred_[i]) {
+            isDeferred_[i] = 0;
+            continue;
+        }
+
+        // 非アクティブなオブジェクトは個別更新時と同じく何もしない（溜めた時間も捨てる）
+        if (!obj->info_.isActive) {
+            deferredTime_[i] = 0.0f;
+            continue;
+        }
+
+        // 眠っているボディは、力や速度を与えられた・動かされた時だけ起こす
+        if (obj->isSleeping_) {
+            if (!obj->ShouldWake()) {
+                deferredTime_[i] = 0.0f;
+                continue;
+            }
+            obj->WakeUp();
+        }
+
+        const Rigidbody2D& rb = obj->rigidbody_;
+
+        // 減衰係数（減速率が0以下の軸は減速なし）
+        if (dtChanged || rb.deceleration.x != cachedDecelX_[i]) {
+            cachedDecelX_[i] = rb.deceleration.x;
+            cachedDampX_[i] = (rb.deceleration.x > 0.0f) ? std::pow(rb.deceleration.x, deltaTime) : 1.0f;
+        }
+        if (dtChanged || rb.deceleration.y != cachedDecelY_[i]) {
+            cachedDecelY_[i] = rb.deceleration.y;
+            cachedDampY_[i] = (rb.deceleration.y > 0.0f) ? std::pow(rb.deceleration.y, deltaTime) : 1.0f;
+        }
+        if (dtChanged || rb.angularDeceleration != cachedAngularDecel_[i]) {
+            cachedAngularDecel_[i] = rb.angularDeceleration;
+            cachedAngularDamp_[i] = (rb.angularDeceleration > 0.0f) ? std::pow(rb.angularDeceleration, deltaTime) : 1.0f;
+        }
+
+        // 溜めた時間があるボディは、まとめて計算する分の後ろに並べる
+        if (deferredTime_[i] > 0.0f) {
+            catchUpBodies_.push_back(i);
+            catchUpTime_.push_back(deltaTime + deferredTime_[i]);
+            deferredTime_[i] = 0.0f;
+            continue;
+        }
+
+        PushSlot(i);
+    }
+
+    uniformSlotCount_ = slotBody_.size();
+    for (size_t bodyIndex : catchUpBodies_) {
+        PushSlot(bodyIndex);
+    }
+}
+
+void PhysicsWorld::PushSlot(size_t i) {
+    GameObject2D* obj = bodies_[i];
+    const Rigidbody2D& rb = obj->rigidbody_;
+    const Transform2D& transform = obj->transform_;
+
+    slotBody_.push_back(obj);
+    slotCollideWithMap_.push_back(collideWithMap_[i]);
+    posX_.push_back(transform.translate.x);
+    posY_.push_back(transform.translate.y);
+    rotation_.push_back(transform.rotation);
+    velX_.push_back(rb.velocity.x);
+    velY_.push_back(rb.velocity.y);
+    accX_.push_back(rb.acceleration.x);
+    accY_.push_back(rb.acceleration.y);
+    maxSpeed_.push_back(rb.maxSpeed);
+    angularVelocity_.push_back(rb.angularVelocity);
+    angularAcceleration_.push_back(rb.angularAcceleration);
+    maxAngularSpeed_.push_back(rb.maxAngularSpeed);
+    dampX_.push_back(cachedDampX_[i]);
+    dampY_.push_back(cachedDampY_[i]);
+    angularDamp_.push_back(cachedAngularDamp_[i]);
+}
+
+void PhysicsWorld::IntegrateRange(size_t begin, size_t end, float deltaTime) {
+    // Rigidbody2D::Update + 座標反映と同じ順序で計算する
+    size_t i = begin;
+
+#ifdef PHYSICS_WORLD_USE_SSE
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 tiny = _mm_set1_ps(1e-12f);
+
+    for (; i + 4 <= end; i += 4) {
+        __m128 vx = _mm_loadu_ps(&velX_[i]);
+        __m128 vy = _mm_loadu_ps(&velY_[i]);
+        const __m128 ax = _mm_loadu_ps(&accX_[i]);
+        const __m128 ay = _mm_loadu_ps(&accY_[i]);
+
+        // 1. 速度の更新 (v = v0 + at)
+        vx = _mm_add_ps(vx, _mm_mul_ps(ax, dt));
+        vy = _mm_add_ps(vy, _mm_mul_ps(ay, dt));
+
+        // 2. 最大速度制限（超えたレーンだけ maxSpeed / |v| を掛ける）
+        const __m128 maxSpeed = _mm_loadu_ps(&maxSpeed_[i]);
+        const __m128 lengthSq = _mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy));
+        const __m128 over = _mm_cmpgt_ps(lengthSq, _mm_mul_ps(maxSpeed, maxSpeed));
+        const __m128 clampScale = _mm_div_ps(maxSpeed, _mm_sqrt_ps(_mm_max_ps(lengthSq, tiny)));
+        const __m128 speedScale = _mm_or_ps(_mm_and_ps(over, clampScale), _mm_andnot_ps(over, one));
+        vx = _mm_mul_ps(vx, speedScale);
+        vy = _mm_mul_ps(vy, speedScale);
+
+        // 3. 角速度の更新と制限
+        const __m128 maxAngular = _mm_loadu_ps(&maxAngularSpeed_[i]);
+        const __m128 aa = _mm_loadu_ps(&angularAcceleration_[i]);
+        __m128 av = _mm_loadu_ps(&angularVelocity_[i]);
+        av = _mm_add_ps(av, _mm_mul_ps(aa, dt));
+        av = _mm_min_ps(_mm_max_ps(av, _mm_sub_ps(zero, maxAngular)), maxAngular);
+
+        // 4. 減速（加速度入力がない軸のみ）
+        const __m128 noAccX = _mm_cmpeq_ps(ax, zero);
+        const __m128 noAccY = _mm_cmpeq_ps(ay, zero);
+        const __m128 noAccA = _mm_cmpeq_ps(aa, zero);
+        vx = _mm_mul_ps(vx, _mm_or_ps(_mm_and_ps(noAccX, _mm_loadu_ps(&dampX_[i])), _mm_andnot_ps(noAccX, one)));
+        vy = _mm_mul_ps(vy, _mm_or_ps(_mm_and_ps(noAccY, _mm_loadu_ps(&dampY_[i])), _mm_andnot_ps(noAccY, one)));
+        av = _mm_mul_ps(av, _mm_or_ps(_mm_and_ps(noAccA, _mm_loadu_ps(&angularDamp_[i])), _mm_andnot_ps(noAccA, one)));
+
+        _mm_storeu_ps(&velX_[i], vx);
+        _mm_storeu_ps(&velY_[i], vy);
+        _mm_storeu_ps(&angularVelocity_[i], av);
+
+        // 5. 座標への反映
+        _mm_storeu_ps(&posX_[i], _mm_add_ps(_mm_loadu_ps(&posX_[i]), _mm_mul_ps(vx, dt)));
+        _mm_storeu_ps(&posY_[i], _mm_add_ps(_mm_loadu_ps(&posY_[i]), _mm_mul_ps(vy, dt)));
+        _mm_storeu_ps(&rotation_[i], _mm_add_ps(_mm_loadu_ps(&rotation_[i]), _mm_mul_ps(av, dt)));
+    }
+#endif
+
+    // 端数（またはSIMDなし環境）はスカラーで処理
+    for (; i < end; ++i) {
+        IntegrateSlot(i, deltaTime);
+    }
+}
+
+void PhysicsWorld::IntegrateSlot(size_t i, float deltaTime) {
+    float vx = velX_[i] + accX_[i] * deltaTime;
+    float vy = velY_[i] + accY_[i] * deltaTime;
+
+    const float lengthSq = vx * vx + vy * vy;
+    if (lengthSq > maxSpeed_[i] * maxSpeed_[i]) {
+        const float scale = maxSpeed_[i] / std::sqrt(lengthSq);
+        vx *= scale;
+        vy *= scale;
+    }
+
+    float av = angularVelocity_[i] + angularAcceleration_[i] * deltaTime;
+    av = std::clamp(av, -maxAngularSpeed_[i], maxAngularSpeed_[i]);
+
+    if (accX_[i] == 0.0f) { vx *= dampX_[i]; }
+    if (accY_[i] == 0.0f) { vy *= dampY_[i]; }
+    if (angularAcceleration_[i] == 0.0f) { av *= angularDamp_[i]; }
+
+    velX_[i] = vx;
+    velY_[i] = vy;
+    angularVelocity_[i] = av;
+
+    posX_[i] += vx * deltaTime;
+    posY_[i] += vy * deltaTime;
+    rotation_[i] += av * deltaTime;
+}
+
+void PhysicsWorld::CatchUpSlot(size_t i, float time, float deltaTime, const MapData* map) {
+    // 1回分の時間を揃えて、その時間での減衰係数を作り直す（キャッシュは deltaTime 用なので使わない）
+    const int stepCount = CountCatchUpSteps(time, deltaTime);
+    const float step = time / static_cast<float>(stepCount);
+
+    const Rigidbody2D& rb = slotBody_[i]->rigidbody_;
+    dampX_[i] = (rb.deceleration.x > 0.0f) ? std::pow(rb.deceleration.x, step) : 1.0f;
+    dampY_[i] = (rb.deceleration.y > 0.0f) ? std::pow(rb.deceleration.y, step) : 1.0f;
+    angularDamp_[i] = (rb.angularDeceleration > 0.0f) ? std::pow(rb.angularDeceleration, step) : 1.0f;
+
+    // 1回ごとにマップ衝突を解決する（長い時間を一度に進めると壁を抜けるため）
+    for (int s = 0; s < stepCount; ++s) {
+        IntegrateSlot(i, step);
+        if (map) {
+            ResolveMapRange(i, i + 1, *map);
+        }
+    }
+}
+
+void PhysicsWorld::ResolveMapRange(size_t begin, size_t end, const MapData& map) {
+    for (size_t i = begin; i < end; ++i) {
+        if (!slotCollideWithMap_[i]) continue;
+
+        const Collider& collider = slotBody_[i]->collider_;
+        if (!collider.canCollide) continue;
+
+        Vector2 position = { posX_[i], posY_[i] };
+        Vector2 velocity = { velX_[i], velY_[i] };
+        PhysicsManager::ResolveBox(position, velocity, collider, map);
+
+        posX_[i] = position.x;
+        posY_[i] = position.y;
+        velX_[i] = velocity.x;
+        velY_[i] = velocity.y;
+    }
+}
+
+void PhysicsWorld::Scatter() {
+    const size_t count = slotBody_.size();
+    for (size_t i = 0; i < count; ++i) {
+        GameObject2D* obj = slotBody_[i];
+        Rigidbody2D& rb = obj->rigidbody_;
+
+        rb.velocity = { velX_[i], velY_[i] };
+        rb.angularVelocity = angularVelocity_[i];
+
+        // AddForceは「そのフレームだけの力」なのでリセット
+        rb.acceleration = { 0.0f, 0.0f };
+        rb.angularAcceleration = 0.0f;
+
+        obj->transform_.translate = { posX_[i], posY_[i] };
+        obj->transform_.rotation = rotation_[i];
+        obj->ApplyPhysicsResult();
+
+        // 遅い状態が続いていれば眠らせる
+        obj->UpdateSleepState();
+    }
+}
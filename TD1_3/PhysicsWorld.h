@@ -0,0 +1,145 @@
+﻿#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <cmath>
+#include "Vector2.h"
+
+class GameObject2D; // 前方宣言
+class MapData;
+
+/// <summary>
+/// 登録された全ボディの物理挙動をまとめて計算するクラス
+/// 起きているボディの状態を成分ごとの配列(SoA)に集めてSIMDで一括積分し、
+/// 2パス目でマップとの衝突を解決してからGameObject2Dへ書き戻す
+/// 眠っているボディ（GameObject2D::IsSleeping）は収集の段階で除外する
+/// </summary>
+/// <remarks>
+/// Rigidbody2Dは各オブジェクトの入力窓口としてそのまま残しているため、
+/// velocityを直接書き換える既存コードもそのまま動く
+/// </remarks>
+class PhysicsWorld {
+public:
+    // 間引きで溜まった時間を進める時の1回分の最大時間（これより長い分は分けて進め、タイルのすり抜けを防ぐ）
+    static constexpr float kMaxCatchUpStep = 1.0f / 30.0f;
+
+    PhysicsWorld() = default;
+    ~PhysicsWorld() = default;
+
+    // コピー禁止（ボディ番号をオブジェクト側に持たせているため）
+    PhysicsWorld(const PhysicsWorld&) = delete;
+    PhysicsWorld& operator=(const PhysicsWorld&) = delete;
+
+    /// <summary>
+    /// ボディを登録する（登録済みなら設定だけ更新）
+    /// </summary>
+    /// <param name="obj">対象オブジェクト</param>
+    /// <param name="collideWithMap">マップ(Blockレイヤー)と衝突させるか</param>
+    void AddBody(GameObject2D* obj, bool collideWithMap = false);
+
+    /// <summary>
+    /// ボディの登録を解除する（末尾と入れ替えて削除）
+    /// </summary>
+    void RemoveBody(GameObject2D* obj);
+
+    /// <summary>
+    /// 全ボディの登録を解除する
+    /// </summary>
+    void Clear();
+
+    /// <summary>
+    /// 次のStepではこのボディを計算せず、経過時間を溜めておく（更新頻度を間引く時にStepの前に呼ぶ）
+    /// 溜めた時間は次に計算されるStepで kMaxCatchUpStep 以下に分けて進める
+    /// </summary>
+    /// <param name="obj">対象オブジェクト（未登録なら何もしない）</param>
+    /// <param name="deltaTime">飛ばすステップの経過時間</param>
+    void DeferBody(GameObject2D* obj, float deltaTime);
+
+    /// <summary>
+    /// 溜めた時間を何回に分けて進めるか（1回分が kMaxCatchUpStep と deltaTime の大きい方を超えない回数）
+    /// </summary>
+    static int CountCatchUpSteps(float time, float deltaTime) {
+        const float maxStep = (deltaTime > kMaxCatchUpStep) ? deltaTime : kMaxCatchUpStep;
+        // 溜めた時間の丸め誤差で1回増えないよう、わずかに引いてから切り上げる
+        const int count = static_cast<int>(std::ceil(time / maxStep - 1e-4f));
+        return (count > 1) ? count : 1;
+    }
+
+    /// <summary>
+    /// 1ステップ分の物理計算
+    /// 1. オブジェクトから状態を収集 2. 速度・位置の積分 3. マップ衝突解決 4. 書き戻し
+    /// </summary>
+    /// <param name="deltaTime">経過時間</param>
+    /// <param name="map">衝突対象のマップ（nullptrなら衝突解決しない）</param>
+    void Step(float deltaTime, const MapData* map);
+
+    // 並列実行の設定（ボディ数がしきい値以上のときだけ分割する）
+    void SetParallel(bool enable) { isParallel_ = enable; }
+    bool IsParallel() const { return isParallel_; }
+
+    size_t GetBodyCount() const { return bodies_.size(); }
+
+    // 直近のStepで計算したボディ数（眠っていないもの）
+    size_t GetSimulatedCount() const { return slotBody_.size(); }
+
+private:
+    // 並列化する最小ボディ数と1タスクあたりのボディ数
+    static constexpr size_t kParallelThreshold = 2048;
+    static constexpr size_t kChunkSize = 512;
+
+    // --- 登録情報（ステップをまたいで保持） ---
+    std::vector<GameObject2D*> bodies_;
+    std::vector<uint8_t> collideWithMap_;
+
+    // 間引き（DeferBodyで立てた次のStepだけ有効な印と、溜めた経過時間）
+    std::vector<uint8_t> isDeferred_;
+    std::vector<float> deferredTime_;
+
+    // 減速率ごとの減衰係数キャッシュ（pow(deceleration, dt)）
+    // 減速率かdtが変わったボディだけ再計算する。減速なしの軸は1.0
+    std::vector<float> cachedDecelX_;
+    std::vector<float> cachedDecelY_;
+    std::vector<float> cachedAngularDecel_;
+    std::vector<float> cachedDampX_;
+    std::vector<float> cachedDampY_;
+    std::vector<float> cachedAngularDamp_;
+    float cachedDeltaTime_ = -1.0f;
+
+    // --- ステップ中の作業領域（SoA、起きているボディだけを詰めて並べる） ---
+    // 先頭 uniformSlotCount_ 個は deltaTime でまとめて計算し、残りは溜めた時間を持つボディ
+    size_t uniformSlotCount_ = 0;
+    std::vector<size_t> catchUpBodies_;
+    std::vector<float> catchUpTime_;
+    std::vector<GameObject2D*> slotBody_;
+    std::vector<uint8_t> slotCollideWithMap_;
+    std::vector<float> dampX_, dampY_, angularDamp_;
+    std::vector<float> posX_, posY_;
+    std::vector<float> velX_, velY_;
+    std::vector<float> accX_, accY_;
+    std::vector<float> maxSpeed_;
+    std::vector<float> rotation_;
+    std::vector<float> angularVelocity_;
+    std::vector<float> angularAcceleration_;
+    std::vector<float> maxAngularSpeed_;
+
+    // 並列実行用の分割範囲
+    std::vector<std::pair<size_t, size_t>> chunks_;
+    bool isParallel_ = true;
+
+    // 各パスの処理
+    void Gather(float deltaTime);
+    void PushSlot(size_t bodyIndex);
+    void IntegrateRange(size_t begin, size_t end, float deltaTime);
+    void IntegrateSlot(size_t i, float deltaTime);
+    void CatchUpSlot(size_t i, float time, float deltaTime, const MapData* map);
+    void ResolveMapRange(size_t begin, size_t end, const MapData& map);
+    void Scatter();
+
+    // 配列要素を末尾と入れ替えて削除
+    template <typename T>
+    static void SwapAndPop(std::vector<T>& v, size_t index) {
+        v[index] = v.back();
+        v.pop_back();
+    }
+};
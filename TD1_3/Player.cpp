@@ -10,16 +10,17 @@ Player::Player() {
 
 	// 新しい DrawComponent2D を使用（アニメーション付き）
 	// 80x80のスプライトシートを 5x5分割、5フレーム、0.1秒/フレーム
-	drawComp_ = new DrawComponent2D(Tex().GetTexture(TextureId::PlayerAnimeNormal), 5, 1, 5, 0.1f, true);
+	drawComp_ = DrawComponent2D(Tex().GetTexture(TextureId::PlayerAnimeNormal), 5, 1, 5, 0.1f, true);
 
 	// 初期設定
-	drawComp_->SetTransform(transform_);
-	drawComp_->SetAnchorPoint({ 0.5f, 0.5f });  // 中心を基準点に
+	drawComp_.SetTransform(transform_);
+	drawComp_.SetAnchorPoint({ 0.5f, 0.5f });  // 中心を基準点に
+
+	// 移動とマップ衝突は PhysicsWorld にまとめて任せる（Move では速度だけ決める）
+	UsePhysicsWorld(true);
 }
 
 Player::~Player() {
-	//delete drawComp_;
-
 	Initialize();
 }
 
@@ -27,7 +28,7 @@ void Player::Initialize() {
 	transform_.translate = { 640.0f, 360.0f };
 }
 
-void Player::Move(float deltaTime) {
+void Player::Move() {
 	rigidbody_.velocity = { 0.0f, 0.0f };
 
 	// WASD で移動
@@ -52,9 +53,7 @@ void Player::Move(float deltaTime) {
 		rigidbody_.velocity = Vector2::Normalize(rigidbody_.velocity) * rigidbody_.maxSpeed;
 	}
 
-	// 位置を更新
-	Vector2 moveDelta = rigidbody_.velocity * deltaTime;
-	transform_.translate += moveDelta;
+	// 位置の更新とマップ衝突は、このステップの最後に PhysicsWorld が行う
 
 	// 画面内に制限
 	//position_.x = std::clamp(position_.x, 32.0f, 1280.0f - 32.0f);
@@ -65,7 +64,7 @@ void Player::Update(float deltaTime) {
 	if (!info_.isActive) return;
 
 	// 移動処理
-	Move(deltaTime);
+	Move();
 
 	// ========== エフェクトテスト用のキー入力 ==========
 
@@ -80,89 +79,99 @@ void Player::Update(float deltaTime) {
 		gaugeRatio_ = std::clamp(gaugeRatio_, 0.0f, 1.0f);
 	}
 
-	drawComp_->SetCropRatio(gaugeRatio_);
+	drawComp_.SetCropRatio(gaugeRatio_);
 
 	//	// Q: シェイクエフェクト
 	//if (Input().TriggerKey(DIK_Q)) {
-	//	drawComp_->StartShake(10.0f, 0.3f);
+	//	drawComp_.StartShake(10.0f, 0.3f);
 	//}
 
 	//// E: 回転エフェクト
 	//if (Input().TriggerKey(DIK_R)) {
-	//	if (drawComp_->IsRotationActive()) {
-	//		drawComp_->StopRotation();
+	//	if (drawComp_.IsRotationActive()) {
+	//		drawComp_.StopRotation();
 	//	}
 	//	else {
-	//		drawComp_->StartRotationContinuous(3.0f);
+	//		drawComp_.StartRotationContinuous(3.0f);
 	//	}
 	//}
 
 	//// T: パルス（拡大縮小）
 	//if (Input().TriggerKey(DIK_E)) {
-	//	if (drawComp_->IsScaleEffectActive()) {
-	//		drawComp_->StopScale();
+	//	if (drawComp_.IsScaleEffectActive()) {
+	//		drawComp_.StopScale();
 	//	}
 	//	else {
-	//		drawComp_->StartPulse(0.8f, 1.2f, 3.0f, true);
+	//		drawComp_.StartPulse(0.8f, 1.2f, 3.0f, true);
 	//	}
 	//}
 
 	//// Y: フラッシュ（白）
 	//if (Input().TriggerKey(DIK_Y)) {
-	//	drawComp_->StartFlash(ColorRGBA::White(), 0.2f, 0.8f);
+	//	drawComp_.StartFlash(ColorRGBA::White(), 0.2f, 0.8f);
 	//}
 
 	//// U: ヒットエフェクト（複合）
 	//if (Input().TriggerKey(DIK_U)) {
-	//	drawComp_->StartHitEffect();
+	//	drawComp_.StartHitEffect();
 	//}
 
 	//// I: 色変更（赤）
 	//if (Input().TriggerKey(DIK_I)) {
-	//	drawComp_->StartColorTransition(ColorRGBA::Red(), 0.5f);
+	//	drawComp_.StartColorTransition(ColorRGBA::Red(), 0.5f);
 	//}
 
 	//// O: 色リセット（白）
 	//if (Input().TriggerKey(DIK_O)) {
-	//	drawComp_->StartColorTransition(ColorRGBA::White(), 0.5f);
+	//	drawComp_.StartColorTransition(ColorRGBA::White(), 0.5f);
 	//}
 
 	//// P: フェードアウト
 	//if (Input().TriggerKey(DIK_P)) {
-	//	drawComp_->StartFadeOut(1.0f);
+	//	drawComp_.StartFadeOut(1.0f);
 	//}
 
 	//// L: フェードイン
 	//if (Input().TriggerKey(DIK_L)) {
-	//	drawComp_->StartFadeIn(0.5f);
+	//	drawComp_.StartFadeIn(0.5f);
 	//}
 
 	//// F: 全エフェクトリセット
 	//if (Input().TriggerKey(DIK_F)) {
-	//	drawComp_->StopAllEffects();
+	//	drawComp_.StopAllEffects();
 	//}
 
 	
 
 	// DrawComponent2D を更新（アニメーション・エフェクト）
-	drawComp_->Update(deltaTime);
+	drawComp_.Update(deltaTime);
 }
 
 void Player::Draw(const Camera2D& camera) {
 	if (!info_.isActive) return;
 	// DrawComponent2D の位置を更新
-	drawComp_->SetPosition(transform_.translate);
+	drawComp_.SetPosition(GetInterpolatedTransform().translate);
 	// カメラを使って描画（ゲーム内オブジェクト）
-	drawComp_->Draw(camera);
+	drawComp_.Draw(camera);
 
 	DrawDebugWindow();
 }
 
+void Player::SaveState(SnapshotWriter& writer) const {
+	GameObject2D::SaveState(writer);
+	writer.Write(gaugeRatio_);
+}
+
+void Player::LoadState(SnapshotReader& reader) {
+	GameObject2D::LoadState(reader);
+	reader.Read(gaugeRatio_);
+}
+
 void Player::DrawScreen() {
 	if (!info_.isActive) return;
 
 	// スクリーン座標で描画（UI用）
-	drawComp_->DrawScreen();
+	drawComp_.DrawScreen();
 }
 
 #ifdef _DEBUG
@@ -197,13 +206,13 @@ void Player::DrawDebugWindow() {
 	ImGui::Text("=== DrawComponent Status ===");
 	if (drawComp_) {
 		ImGui::Text("Any Effect Active: %s",
-			drawComp_->IsAnyEffectActive() ? "Yes" : "No");
+			drawComp_.IsAnyEffectActive() ? "Yes" : "No");
 		ImGui::Text("Shake Active: %s",
-			drawComp_->IsShakeActive() ? "Yes" : "No");
+			drawComp_.IsShakeActive() ? "Yes" : "No");
 		ImGui::Text("Rotation Active: %s",
-			drawComp_->IsRotationActive() ? "Yes" : "No");
+			drawComp_.IsRotationActive() ? "Yes" : "No");
 		ImGui::Text("Fade Active: %s",
-			drawComp_->IsFadeActive() ? "Yes" : "No");
+			drawComp_.IsFadeActive() ? "Yes" : "No");
 	}
 
 	ImGui::End();*/
@@ -28,8 +28,12 @@ public:
 	void Draw(const Camera2D& camera)override;
 	void DrawScreen();  // UI用（カメラなし）
 
+	// ========== スナップショット ==========
+	void SaveState(SnapshotWriter& writer) const override;
+	void LoadState(SnapshotReader& reader) override;
+
 	// ========== 移動 ==========
-	void Move(float deltaTime);
+	void Move();
 
 	// ========== ゲッター ==========
 	Vector2 GetPosition() const { return transform_.translate; }
@@ -0,0 +1,330 @@
+﻿#include "ProjectileSystem.h"
+#include "Camera2D.h"
+#include "SimulationClock.h"
+#include "SceneUtilityIncludes.h"
+#include "WorldSnapshot.h"
+#include <Novice.h>
+#include <cmath>
+#include <algorithm>
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#include <emmintrin.h>
+#define PROJECTILE_USE_SSE
+#endif
+
+ProjectileSystem::ProjectileSystem() {
+    SetCapacity(kDefaultCapacity);
+}
+
+void ProjectileSystem::SetCapacity(size_t capacity) {
+    capacity_ = capacity;
+
+    // 撃つたびに配列が伸びないよう、上限まで先に確保する
+    posX_.reserve(capacity);
+    posY_.reserve(capacity);
+    prevX_.reserve(capacity);
+    prevY_.reserve(capacity);
+    velX_.reserve(capacity);
+    velY_.reserve(capacity);
+    dirX_.reserve(capacity);
+    dirY_.reserve(capacity);
+    life_.reserve(capacity);
+    damage_.reserve(capacity);
+    isDead_.reserve(capacity);
+}
+
+void ProjectileSystem::SetSprite(int graphHandle, int srcW, int srcH, float length, float width, unsigned int color) {
+    graphHandle_ = graphHandle;
+    srcW_ = srcW;
+    srcH_ = srcH;
+    halfLength_ = length * 0.5f;
+    halfWidth_ = width * 0.5f;
+    color_ = color;
+}
+
+bool ProjectileSystem::Fire(const Vector2& position, const Vector2& velocity, float lifetime, int damage) {
+    if (posX_.size() >= capacity_) {
+        ++droppedCount_;
+        return false;
+    }
+
+    const float speed = Vector2::Length(velocity);
+    const Vector2 dir = speed > 0.0f ? velocity * (1.0f / speed) : Vector2{ 1.0f, 0.0f };
+
+    posX_.push_back(position.x);
+    posY_.push_back(position.y);
+    prevX_.push_back(position.x);
+    prevY_.push_back(position.y);
+    velX_.push_back(velocity.x);
+    velY_.push_back(velocity.y);
+    dirX_.push_back(dir.x);
+    dirY_.push_back(dir.y);
+    life_.push_back(lifetime);
+    damage_.push_back(damage);
+
+    ++firedCount_;
+    return true;
+}
+
+void ProjectileSystem::Clear() {
+    posX_.clear();
+    posY_.clear();
+    prevX_.clear();
+    prevY_.clear();
+    velX_.clear();
+    velY_.clear();
+    dirX_.clear();
+    dirY_.clear();
+    life_.clear();
+    damage_.clear();
+    isDead_.clear();
+    stats_ = {};
+    firedCount_ = 0;
+    droppedCount_ = 0;
+}
+
+void ProjectileSystem::SaveState(SnapshotWriter& writer) const {
+    writer.WriteArray(posX_);
+    writer.WriteArray(posY_);
+    writer.WriteArray(prevX_);
+    writer.WriteArray(prevY_);
+    writer.WriteArray(velX_);
+    writer.WriteArray(velY_);
+    writer.WriteArray(dirX_);
+    writer.WriteArray(dirY_);
+    writer.WriteArray(life_);
+    writer.WriteArray(damage_);
+}
+
+void ProjectileSystem::LoadState(SnapshotReader& reader) {
+    reader.ReadArray(posX_);
+    reader.ReadArray(posY_);
+    reader.ReadArray(prevX_);
+    reader.ReadArray(prevY_);
+    reader.ReadArray(velX_);
+    reader.ReadArray(velY_);
+    reader.ReadArray(dirX_);
+    reader.ReadArray(dirY_);
+    reader.ReadArray(life_);
+    reader.ReadArray(damage_);
+    isDead_.clear();
+    firedCount_ = 0;
+    droppedCount_ = 0;
+}
+
+bool ProjectileSystem::BeginStep(float deltaTime) {
+    stats_.fired = firedCount_;
+    stats_.dropped = droppedCount_;
+    stats_.hitObject = 0;
+    firedCount_ = 0;
+    droppedCount_ = 0;
+
+    const size_t count = posX_.size();
+    if (count == 0) {
+        stats_.active = 0;
+        return false;
+    }
+
+    // 描画補間と掃引判定のため、移動前の位置を保存（同じ大きさなので確保は起きない）
+    prevX_.assign(posX_.begin(), posX_.end());
+    prevY_.assign(posY_.begin(), posY_.end());
+
+    // 移動と寿命（全弾同じ式なのでまとめて計算）
+    Integrate(deltaTime);
+
+    isDead_.assign(count, 0);
+    return true;
+}
+
+void ProjectileSystem::EndStep() {
+    RemoveDead();
+    stats_.active = static_cast<int>(posX_.size());
+}
+
+void ProjectileSystem::Step(float deltaTime, const float* targetX, const float* targetY, const float* targetRadius,
+    size_t targetCount, std::vector<ProjectileHit>& hits) {
+    hits.clear();
+
+    // 1. 移動と寿命
+    if (!BeginStep(deltaTime)) return;
+
+    const size_t count = posX_.size();
+
+    // セルの一辺は「一番大きい的の半径 + 弾の太さ + 1ステップの移動量の半分」
+    // 線分に触れる的の中心は、線分の中点からこの距離以内にあるので周囲3x3セルで必ず見つかる
+    float maxRadius = 0.0f;
+    for (size_t t = 0; t < targetCount; ++t) {
+        maxRadius = std::max(maxRadius, targetRadius[t]);
+    }
+    float maxMoveSq = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        const float dx = posX_[i] - prevX_[i];
+        const float dy = posY_[i] - prevY_[i];
+        maxMoveSq = std::max(maxMoveSq, dx * dx + dy * dy);
+    }
+    if (targetCount > 0) {
+        targetGrid_.Build(targetX, targetY, targetCount, maxRadius + halfWidth_ + std::sqrt(maxMoveSq) * 0.5f);
+    }
+
+    // 2. 移動した線分で、中点の周囲にいる的だけを調べて一番手前に当たるものを探す
+    for (size_t i = 0; i < count; ++i) {
+        if (life_[i] <= 0.0f) {
+            isDead_[i] = 1;
+            continue;
+        }
+        if (targetCount == 0) continue;
+
+        const Vector2 from = { prevX_[i], prevY_[i] };
+        const Vector2 delta = { posX_[i] - prevX_[i], posY_[i] - prevY_[i] };
+
+        targetCandidates_.clear();
+        targetGrid_.QueryNeighbors(from.x + delta.x * 0.5f, from.y + delta.y * 0.5f, targetCandidates_);
+
+        float nearest = 2.0f;
+        uint32_t nearestTarget = 0;
+        for (const uint32_t target : targetCandidates_) {
+            const float t = SweepCircle(from, delta, targetX[target], targetY[target], targetRadius[target] + halfWidth_);
+            if (t < nearest) {
+                nearest = t;
+                nearestTarget = target;
+            }
+        }
+        if (nearest > 1.0f) continue;
+
+        const Vector2 point = from + delta * nearest;
+        posX_[i] = point.x;
+        posY_[i] = point.y;
+        isDead_[i] = 1;
+        ++stats_.hitObject;
+        hits.push_back({ nearestTarget, damage_[i], point, { dirX_[i], dirY_[i] } });
+    }
+
+    // 3. 消えた弾を詰める
+    EndStep();
+}
+
+float ProjectileSystem::SweepCircle(const Vector2& from, const Vector2& delta, float centerX, float centerY, float radius) {
+    constexpr float kNoHit = 2.0f;
+
+    // |from + delta * t - center| = radius を t について解き、小さい方の解を使う
+    const float fx = from.x - centerX;
+    const float fy = from.y - centerY;
+    const float c = fx * fx + fy * fy - radius * radius;
+    if (c <= 0.0f) return 0.0f; // 始点が既に円の中
+
+    const float a = delta.x * delta.x + delta.y * delta.y;
+    const float b = fx * delta.x + fy * delta.y;
+    if (a <= 0.0f || b >= 0.0f) return kNoHit; // 止まっているか、円から離れていく
+
+    const float discriminant = b * b - a * c;
+    if (discriminant < 0.0f) return kNoHit;
+
+    return (-b - std::sqrt(discriminant)) / a;
+}
+
+void ProjectileSystem::Integrate(float deltaTime) {
+    const size_t count = posX_.size();
+    size_t i = 0;
+
+#ifdef PROJECTILE_USE_SSE
+    const __m128 dt = _mm_set1_ps(deltaTime);
+
+    for (; i + 4 <= count; i += 4) {
+        const __m128 px = _mm_add_ps(_mm_loadu_ps(&posX_[i]), _mm_mul_ps(_mm_loadu_ps(&velX_[i]), dt));
+        const __m128 py = _mm_add_ps(_mm_loadu_ps(&posY_[i]), _mm_mul_ps(_mm_loadu_ps(&velY_[i]), dt));
+        _mm_storeu_ps(&posX_[i], px);
+        _mm_storeu_ps(&posY_[i], py);
+        _mm_storeu_ps(&life_[i], _mm_sub_ps(_mm_loadu_ps(&life_[i]), dt));
+    }
+#endif
+
+    // 残り（SSEが使えない環境では全件）
+    for (; i < count; ++i) {
+        posX_[i] += velX_[i] * deltaTime;
+        posY_[i] += velY_[i] * deltaTime;
+        life_[i] -= deltaTime;
+    }
+}
+
+void ProjectileSystem::RemoveDead() {
+    const size_t count = posX_.size();
+    size_t write = 0;
+
+    // 生きている弾を順番を保ったまま前へ詰める
+    for (size_t read = 0; read < count; ++read) {
+        if (isDead_[read]) continue;
+
+        if (write != read) {
+            posX_[write] = posX_[read];
+            posY_[write] = posY_[read];
+            prevX_[write] = prevX_[read];
+            prevY_[write] = prevY_[read];
+            velX_[write] = velX_[read];
+            velY_[write] = velY_[read];
+            dirX_[write] = dirX_[read];
+            dirY_[write] = dirY_[read];
+            life_[write] = life_[read];
+            damage_[write] = damage_[read];
+        }
+        ++write;
+    }
+
+    posX_.resize(write);
+    posY_.resize(write);
+    prevX_.resize(write);
+    prevY_.resize(write);
+    velX_.resize(write);
+    velY_.resize(write);
+    dirX_.resize(write);
+    dirY_.resize(write);
+    life_.resize(write);
+    damage_.resize(write);
+}
+
+void ProjectileSystem::Draw(const Camera2D& camera) {
+    stats_.drawn = 0;
+
+    const size_t count = posX_.size();
+    if (count == 0) return;
+
+    Vector2 viewMin;
+    Vector2 viewMax;
+    camera.GetVisibleWorldRect(viewMin, viewMax);
+    const float margin = halfLength_ + halfWidth_;
+
+    const Affine2x3& vp = camera.GetVpVpAffine();
+    const float alpha = SimulationClock::GetInstance().GetInterpolationAlpha();
+    const int graphHandle = graphHandle_ >= 0 ? graphHandle_ : Tex().GetTexture(TextureId::White1x1);
+
+    for (size_t i = 0; i < count; ++i) {
+        const float x = prevX_[i] + (posX_[i] - prevX_[i]) * alpha;
+        const float y = prevY_[i] + (posY_[i] - prevY_[i]) * alpha;
+        if (x < viewMin.x - margin || x > viewMax.x + margin ||
+            y < viewMin.y - margin || y > viewMax.y + margin) {
+            continue;
+        }
+
+        // 中心だけ行列で変換し、向きのベクトルは行列の回転・拡大部分だけを掛けて足す（カメラの行列は射影を含まない）
+        const Vector2 center = vp.Transform({ x, y });
+        const float ux = dirX_[i] * halfLength_;
+        const float uy = dirY_[i] * halfLength_;
+        const float vx = -dirY_[i] * halfWidth_;
+        const float vy = dirX_[i] * halfWidth_;
+        const float sux = ux * vp.m00 + uy * vp.m10;
+        const float suy = ux * vp.m01 + uy * vp.m11;
+        const float svx = vx * vp.m00 + vy * vp.m10;
+        const float svy = vx * vp.m01 + vy * vp.m11;
+
+        // 後ろ側が左、進行方向が右になるように四隅を並べる
+        Novice::DrawQuad(
+            static_cast<int>(center.x - sux - svx), static_cast<int>(center.y - suy - svy),
+            static_cast<int>(center.x + sux - svx), static_cast<int>(center.y + suy - svy),
+            static_cast<int>(center.x - sux + svx), static_cast<int>(center.y - suy + svy),
+            static_cast<int>(center.x + sux + svx), static_cast<int>(center.y + suy + svy),
+            0, 0, srcW_, srcH_,
+            graphHandle,
+            color_
+        );
+        ++stats_.drawn;
+    }
+}
@@ -0,0 +1,139 @@
+﻿#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "Vector2.h"
+#include "SpatialHashGrid.h"
+
+class Camera2D;
+class SnapshotWriter;
+class SnapshotReader;
+
+// 1フレーム分の弾の処理状況（DebugWindow表示用）
+struct ProjectileStats {
+    int active = 0;    // 飛んでいる弾の数
+    int fired = 0;     // このフレームに撃った数
+    int dropped = 0;   // 上限を超えて撃てなかった数
+    int hitObject = 0; // 的に当たって消えた数
+    int drawn = 0;     // 描画した数（カメラ外は省く）
+};
+
+// 円の的に当たった弾（的を自前の配列で持つ側が、これを見てダメージを与える）
+struct ProjectileHit {
+    uint32_t target = 0;                // 的の番号（Stepに渡した配列の添字）
+    int damage = 0;
+    Vector2 point = { 0.0f, 0.0f };     // 当たった位置
+    Vector2 direction = { 1.0f, 0.0f }; // 弾の進行方向（ノックバック用）
+};
+
+/// <summary>
+/// 弾をまとめて管理するクラス
+/// GameObject2Dを使わず、位置・速度・寿命などを種類ごとの連続配列（SoA）で持つ
+/// 的（サバイバルの敵など）は位置・半径の配列で受け取り、1ステップの移動を線分として判定するので速い弾でもすり抜けない
+/// 描画は全弾の四隅を同じ手順で計算し、同じテクスチャの四角形として続けて送る
+/// （Noviceにまとめて送るAPIが無いので、描画命令は弾1つにつきDrawQuad 1回）
+/// </summary>
+class ProjectileSystem {
+public:
+    static constexpr size_t kDefaultCapacity = 8192;
+
+    ProjectileSystem();
+    ~ProjectileSystem() = default;
+
+    /// <summary>
+    /// 弾を1つ撃つ（上限に達していたら撃たずにfalse）
+    /// </summary>
+    /// <param name="position">発射位置</param>
+    /// <param name="velocity">速度（px/秒、途中で変わらない）</param>
+    /// <param name="lifetime">消えるまでの秒数</param>
+    /// <param name="damage">当たった相手のHPから引く量</param>
+    bool Fire(const Vector2& position, const Vector2& velocity, float lifetime, int damage);
+
+    /// <summary>
+    /// 1ステップ進める（円の的の配列に当てる）
+    /// 的はSpatialHashGridでセル分けし、各弾は移動した線分の中点の周囲のセルだけを調べる
+    /// 当たった弾は消えて hits に入る（ダメージを与えるのは呼び出し側）
+    /// </summary>
+    /// <param name="targetX">的のX座標</param>
+    /// <param name="targetY">的のY座標</param>
+    /// <param name="targetRadius">的の半径</param>
+    /// <param name="targetCount">的の数</param>
+    /// <param name="hits">当たった弾（上書き。弾の並び順）</param>
+    void Step(float deltaTime, const float* targetX, const float* targetY, const float* targetRadius,
+        size_t targetCount, std::vector<ProjectileHit>& hits);
+
+    /// <summary>
+    /// カメラに映る弾を描画する（固定ステップ間を補間）
+    /// </summary>
+    void Draw(const Camera2D& camera);
+
+    void Clear();
+
+    // 飛んでいる弾の保存・復元（リトライ・巻き戻し用。配列をそのまま写す）
+    void SaveState(SnapshotWriter& writer) const;
+    void LoadState(SnapshotReader& reader);
+
+    // 同時に飛ばせる弾の数（配列はこの数だけ先に確保する）
+    void SetCapacity(size_t capacity);
+    size_t GetCapacity() const { return capacity_; }
+    size_t GetActiveCount() const { return posX_.size(); }
+
+    /// <summary>
+    /// 描画の設定（弾は進行方向に長い四角形で描く）
+    /// </summary>
+    /// <param name="graphHandle">テクスチャ（-1なら白テクスチャ）</param>
+    /// <param name="srcW">テクスチャの幅(px)</param>
+    /// <param name="srcH">テクスチャの高さ(px)</param>
+    /// <param name="length">進行方向の長さ(px)</param>
+    /// <param name="width">太さ(px)</param>
+    /// <param name="color">色</param>
+    void SetSprite(int graphHandle, int srcW, int srcH, float length, float width, unsigned int color);
+
+    const ProjectileStats& GetStats() const { return stats_; }
+
+private:
+    // 位置（前ステップの位置は描画補間と掃引判定に使う）
+    std::vector<float> posX_, posY_;
+    std::vector<float> prevX_, prevY_;
+    std::vector<float> velX_, velY_;
+    std::vector<float> dirX_, dirY_; // 進行方向（描画の向き、撃った時に決まる）
+    std::vector<float> life_;
+    std::vector<int> damage_;
+
+    // このステップで消える弾（1 = 消す）
+    std::vector<uint8_t> isDead_;
+
+    size_t capacity_ = kDefaultCapacity;
+
+    int graphHandle_ = -1;
+    int srcW_ = 1;
+    int srcH_ = 1;
+    float halfLength_ = 8.0f;
+    float halfWidth_ = 2.0f;
+    unsigned int color_ = 0xFFEE88FF;
+
+    ProjectileStats stats_;
+
+    // 前回のStepからの発射数（Stepで統計に移す）
+    int firedCount_ = 0;
+    int droppedCount_ = 0;
+
+    // 円の的のセル分け（毎ステップ作り直す。配列は使い回して確保を避ける）
+    SpatialHashGrid targetGrid_;
+    std::vector<uint32_t> targetCandidates_;
+
+    // Stepの前半（統計の入れ替え・移動前の位置の保存・移動と寿命）。弾が無ければfalse
+    bool BeginStep(float deltaTime);
+
+    // Stepの後半（消えた弾を詰めて統計を更新）
+    void EndStep();
+
+    void Integrate(float deltaTime);
+
+    /// <summary>
+    /// from から delta だけ進む線分が円に最初に触れる割合を返す（触れなければ1より大きい値）
+    /// </summary>
+    static float SweepCircle(const Vector2& from, const Vector2& delta, float centerX, float centerY, float radius);
+
+    void RemoveDead();
+};
@@ -6,9 +6,16 @@
 // 実装クラスをインクルード
 #include "SurvivalObjects.h"
 #include "SurvivalGameManager.h"
+#include "SimulationClock.h"
+#include "Random.h"
+#include "WorldSnapshot.h"
 
 #include "SceneUtilityIncludes.h"
 
+#ifdef _DEBUG
+#include <imgui.h>
+#endif
+
 PrototypeSurvivalScene::PrototypeSurvivalScene(SceneManager& manager)
     : sceneManager_(&manager) {
 
@@ -19,19 +26,20 @@ PrototypeSurvivalScene::PrototypeSurvivalScene(SceneManager& manager)
 
     const int whiteTex = Tex().GetTexture(TextureId::White1x1);
 
-    auto player = std::make_shared<SurvivalPlayer>(input_.get());
+    SurvivalPlayer* player = gameObjectManager_->CreatePlayer(input_.get());
     if (player->GetDrawComponent()) {
         player->GetDrawComponent()->SetGraphHandle(whiteTex);
     }
-    gameObjectManager_->AddObject(player, "Player");
-    gameObjectManager_->SetPlayer(player);
 
-    auto debrisCtrl = std::make_shared<DebrisController>(gameObjectManager_.get(), input_.get(), player);
+    DebrisController* debrisCtrl = gameObjectManager_->CreateDebrisController(input_.get(), player->GetHandle());
     if (debrisCtrl->GetDrawComponent()) {
         debrisCtrl->GetDrawComponent()->SetGraphHandle(whiteTex);
     }
-    gameObjectManager_->AddObject(debrisCtrl, "DebrisController");
-    gameObjectManager_->SetDebrisController(debrisCtrl);
+
+    // ダメージ数字（フォントが読めなければ数字は出さない）
+    if (font_.Load("Resources/font/oxanium.fnt", "./Resources/font/oxanium_0.png")) {
+        gameObjectManager_->GetDamagePopups().SetFont(font_);
+    }
 }
 
 PrototypeSurvivalScene::~PrototypeSurvivalScene() {}
@@ -63,7 +71,8 @@ void PrototypeSurvivalScene::Update(float deltaTime, const char* keys, const cha
 
 void PrototypeSurvivalScene::SpawnEnemy() {
     // 画面外からランダムスポーン
-    float angle = (float)(rand() % 360) * 3.14159f / 180.0f;
+    Random& rng = Rng(RandomStreamId::Gameplay);
+    float angle = (float)rng.RandomInt(0, 359) * 3.14159f / 180.0f;
     float dist = 800.0f;
     Vector2 spawnPos = {
         kWindowWidth / 2.0f + cosf(angle) * dist,
@@ -71,20 +80,51 @@ void PrototypeSurvivalScene::SpawnEnemy() {
     };
 
     // タンク率 20%
-    EnemyType type = (rand() % 5 == 0) ? EnemyType::Tank : EnemyType::Normal;
+    EnemyType type = (rng.RandomInt(0, 4) == 0) ? EnemyType::Tank : EnemyType::Normal;
 
-    auto player = gameObjectManager_->GetPlayer();
-    auto enemy = std::make_shared<SurvivalEnemy>(spawnPos, type, player);
-	int enemyTex = (type == EnemyType::Tank) ? Tex().GetTexture(TextureId::White1x1) : Tex().GetTexture(TextureId::White1x1);
+    const SurvivalPlayer* player = gameObjectManager_->GetPlayer();
+    const ObjectHandle target = player ? player->GetHandle() : ObjectHandle{};
+    SurvivalEnemy* enemy = gameObjectManager_->CreateEnemy(spawnPos, type, target);
+    SetupEnemyDrawing(enemy);
+}
+
+void PrototypeSurvivalScene::SetupEnemyDrawing(SurvivalEnemy* enemy) {
+	int enemyTex = (enemy->GetType() == EnemyType::Tank) ? Tex().GetTexture(TextureId::White1x1) : Tex().GetTexture(TextureId::White1x1);
     if (enemy->GetDrawComponent()) {
         enemy->GetDrawComponent()->SetGraphHandle(enemyTex);
 	}
+}
+
+GameObject2D* PrototypeSurvivalScene::GetPlayer() const {
+    return gameObjectManager_ ? gameObjectManager_->GetPlayer() : nullptr;
+}
+
+bool PrototypeSurvivalScene::SaveSnapshot(SnapshotWriter& writer) const {
+    writer.Write(enemySpawnTimer_);
+    writer.Write(shakeTimer_);
+    camera_->SaveState(writer);
+    gameObjectManager_->SaveState(writer);
+    return true;
+}
+
+bool PrototypeSurvivalScene::RestoreSnapshot(SnapshotReader& reader) {
+    reader.Read(enemySpawnTimer_);
+    reader.Read(shakeTimer_);
+    camera_->LoadState(reader);
+    createdEnemies_.clear();
+    if (!gameObjectManager_->LoadState(reader, &createdEnemies_)) {
+        return false;
+    }
 
-    gameObjectManager_->AddObject(enemy, "Enemy");                                       
+    // 新しく作られた敵だけ描画設定をする（使い続けた敵は設定済み）
+    for (SurvivalEnemy* enemy : createdEnemies_) {
+        SetupEnemyDrawing(enemy);
+    }
+    return true;
 }
 
 void PrototypeSurvivalScene::UpdateCamera(float dt) {
-    auto debris = gameObjectManager_->GetDebrisController();
+    const DebrisController* debris = gameObjectManager_->GetDebrisController();
     if (!debris) return;
 
     // 発散範囲に応じてカメラをズームイン・アウト
@@ -111,6 +151,9 @@ void PrototypeSurvivalScene::UpdateCamera(float dt) {
 }
 
 void PrototypeSurvivalScene::Draw() {
+    // 固定ステップ間の補間位置でカメラ行列を作る
+    camera_->ApplyInterpolation(SimulationClock::GetInstance().GetInterpolationAlpha());
+
     // 背景
     Novice::DrawBox(0, 0, (int)kWindowWidth, (int)kWindowHeight,0.0f, 0x222233FF, kFillModeSolid);
 
@@ -120,4 +163,42 @@ void PrototypeSurvivalScene::Draw() {
     // UIデバッグ
     Novice::ScreenPrintf(10, 10, "Objects: %d", gameObjectManager_.get()->GetObjectsSize()); // リストサイズ取得メソッドがあれば表示推奨
     Novice::ScreenPrintf(10, 30, "WASD: Move, SPACE: Expand/Contract");
+    if (const SurvivalPlayer* player = gameObjectManager_->GetPlayer()) {
+        const SurvivalPickupStats& pickupStats = gameObjectManager_->GetPickups().GetStats();
+        Novice::ScreenPrintf(10, 50, "EXP: %d  Gems: %d (+%d flying)", player->GetExperience(), pickupStats.ground, pickupStats.flying);
+    }
+
+#ifdef _DEBUG
+    // がれきの数を変えて負荷を確かめる
+    ImGui::Begin("Survival Debug");
+    if (DebrisController* debris = gameObjectManager_->GetDebrisController()) {
+        int pieceCount = debris->GetPieceCount();
+        if (ImGui::SliderInt("Debris Pieces", &pieceCount, 16, DebrisController::kMaxPieceCount)) {
+            debris->SetPieceCount(pieceCount);
+        }
+    }
+    if (SurvivalPlayer* player = gameObjectManager_->GetPlayer()) {
+        float magnetRadius = player->GetMagnetRadius();
+        if (ImGui::SliderFloat("Magnet Radius", &magnetRadius, 0.0f, 600.0f)) {
+            player->SetMagnetRadius(magnetRadius);
+        }
+    }
+    SurvivalPickupManager& pickups = gameObjectManager_->GetPickups();
+    int pickupBudget = static_cast<int>(pickups.GetBudget());
+    if (ImGui::SliderInt("Gem Budget", &pickupBudget, 64, 4096)) {
+        pickups.SetBudget(static_cast<size_t>(pickupBudget));
+    }
+    ImGui::Text("Gems merged: %d", pickups.GetStats().merged);
+
+    DamagePopupManager& damagePopups = gameObjectManager_->GetDamagePopups();
+    bool showDamage = damagePopups.IsEnabled();
+    if (ImGui::Checkbox("Damage Numbers", &showDamage)) {
+        damagePopups.SetEnabled(showDamage);
+    }
+    ImGui::Text("Damage popups: %d / %d", static_cast<int>(damagePopups.GetActiveCount()), static_cast<int>(DamagePopupManager::kCapacity));
+
+    const ProjectileStats& shots = gameObjectManager_->GetProjectiles().GetStats();
+    ImGui::Text("Bullets: %d (hit %d)", shots.active, shots.hitObject);
+    ImGui::End();
+#endif
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "IGameScene.h"
 #include "InputManager.h"
 #include "Camera2D.h"
+#include "FontAtlas.h"
 #include "SurvivalGameManager.h" // 新マネージャー
 
 class SceneManager;
@@ -14,6 +15,11 @@ public:
     void Update(float deltaTime, const char* keys, const char* preKeys) override;
     void Draw() override;
 
+    bool SaveSnapshot(SnapshotWriter& writer) const override;
+    bool RestoreSnapshot(SnapshotReader& reader) override;
+
+    GameObject2D* GetPlayer() const override;
+
 private:
     // シーン遷移用
     SceneManager* sceneManager_;
@@ -27,13 +33,20 @@ private:
     // カメラ（演出用）
     std::unique_ptr<Camera2D> camera_;
 
+    // ダメージ数字用のフォント
+    FontAtlas font_;
+
     // レベル管理
     float enemySpawnTimer_ = 0.0f;
 
     // 演出用シェイクタイマー（カメラクラスにも機能あるが、シーン全体制御として持つ）
     float shakeTimer_ = 0.0f;
 
+    // 復元時に新しく作られた敵（描画設定をする分。配列は使い回す）
+    std::vector<SurvivalEnemy*> createdEnemies_;
+
     // プライベートメソッド
     void SpawnEnemy();
+    void SetupEnemyDrawing(SurvivalEnemy* enemy); // 敵のテクスチャ設定（生成時・復元時）
     void UpdateCamera(float dt); // カメラのズーム制御など
 };
\ No newline at end of file
@@ -1,5 +1,8 @@
 ﻿#pragma once
 #include<random>
+#include<array>
+#include<cstdint>
+#include "WorldSnapshot.h"
 
 class Random {
 
@@ -10,6 +13,11 @@ public:
 		mt_ = std::mt19937(rd());
 	}
 
+	// 種を指定して作る（同じ種なら毎回同じ乱数列になる）
+	explicit Random(uint32_t seed) : mt_(seed) {}
+
+	void Seed(uint32_t seed) { mt_.seed(seed); }
+
 	float RandomFloat(float min, float max) {
 		std::uniform_real_distribution<float> dist(min, max);
 		return dist(mt_);
@@ -20,6 +28,93 @@ public:
 		return dist(mt_);
 	}
 
+	// 0 ～ 2^32-1 の整数をそのまま返す
+	uint32_t NextUInt() { return static_cast<uint32_t>(mt_()); }
+
+	// 乱数列を進めずに、今の状態を表す値を返す（記録と再生で状態が一致しているかの確認用）
+	uint32_t Fingerprint() const {
+		std::mt19937 copy = mt_;
+		return static_cast<uint32_t>(copy());
+	}
+
+	// 乱数列の途中の状態をそのまま保存・復元する
+	void SaveState(SnapshotWriter& writer) const { writer.Write(mt_); }
+	bool LoadState(SnapshotReader& reader) { return reader.Read(mt_); }
+
 private:
 	std::mt19937 mt_;
-};
\ No newline at end of file
+};
+
+// 乱数の用途ごとの系統
+// 系統を分けておくと、演出の乱数の使い方が変わってもゲーム進行の乱数列はずれない
+enum class RandomStreamId {
+	Gameplay, // 敵の出現、がれきの配置など、ゲームの結果に関わるもの
+	Visual,   // パーティクル、画面揺れ、タイルのアニメーションのずらしなど見た目だけのもの
+	Count
+};
+
+/// <summary>
+/// 用途ごとの乱数をまとめて持つクラス
+/// 普段は起動ごとに違う種で始まり、入力の記録・再生では1つの種から全系統を決め直して同じ乱数列を再現する
+/// </summary>
+class RandomStreams {
+public:
+	static RandomStreams& GetInstance() {
+		static RandomStreams instance;
+		return instance;
+	}
+
+	// 削除・コピー禁止
+	RandomStreams(const RandomStreams&) = delete;
+	RandomStreams& operator=(const RandomStreams&) = delete;
+
+	Random& Get(RandomStreamId id) { return streams_[static_cast<size_t>(id)]; }
+
+	/// <summary>
+	/// 1つの種から全系統の種を決め直す（系統ごとに別の乱数列になる）
+	/// </summary>
+	void SeedAll(uint32_t seed) {
+		seed_ = seed;
+		for (size_t i = 0; i < streams_.size(); ++i) {
+			std::seed_seq seq{ seed, static_cast<uint32_t>(i) };
+			uint32_t streamSeed = 0;
+			seq.generate(&streamSeed, &streamSeed + 1);
+			streams_[i].Seed(streamSeed);
+		}
+	}
+
+	uint32_t GetSeed() const { return seed_; }
+
+	// 全系統の乱数列の状態を保存・復元する（リトライ後も同じ乱数列で進むように）
+	void SaveState(SnapshotWriter& writer) const {
+		writer.Write(seed_);
+		for (const Random& stream : streams_) {
+			stream.SaveState(writer);
+		}
+	}
+
+	bool LoadState(SnapshotReader& reader) {
+		reader.Read(seed_);
+		for (Random& stream : streams_) {
+			stream.LoadState(reader);
+		}
+		return reader.IsOk();
+	}
+
+	// 新しく使う種を作る（記録を始める時など）
+	static uint32_t MakeSeed() {
+		std::random_device rd;
+		return static_cast<uint32_t>(rd());
+	}
+
+private:
+	RandomStreams() { SeedAll(MakeSeed()); }
+
+	std::array<Random, static_cast<size_t>(RandomStreamId::Count)> streams_;
+	uint32_t seed_ = 0;
+};
+
+// 系統の乱数を取得する
+inline Random& Rng(RandomStreamId id) {
+	return RandomStreams::GetInstance().Get(id);
+}
@@ -12,8 +12,16 @@
 #include "SceneUtilityIncludes.h"
 
 #include "MapData.h"
+#include "SimulationClock.h"
+#include "Random.h"
+#include "JsonUtil.h"
 
 #include <Novice.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <vector>
 
 SceneManager::SceneManager() {
 	shared_.LoadCommonTextures();
@@ -21,7 +29,47 @@ SceneManager::SceneManager() {
 	ChangeScene(SceneType::GamePlay);
 }
 
-void SceneManager::Update(float dt, const char* keys, const char* pre) {
+void SceneManager::Update(float frameDeltaTime, const char* keys) {
+	// ステップの無いフレームのキー・クリックも次のステップで拾えるよう、毎フレーム押下を覚えておく
+	InputManager::GetInstance().LatchFrame(keys);
+
+	// 実経過時間を溜め、固定ステップ分ずつシーンを進める
+	accumulator_ += frameDeltaTime;
+
+	int steps = 0;
+	while (accumulator_ >= fixedDeltaTime_ && steps < kMaxStepsPerFrame) {
+		const char* stepKeys = UpdateInput();
+		Step(fixedDeltaTime_, stepKeys, stepPreKeys_);
+		memcpy(stepPreKeys_, stepKeys, sizeof(stepPreKeys_));
+
+		accumulator_ -= fixedDeltaTime_;
+		++steps;
+	}
+
+	// 上限まで回しても追いつかない分は捨てる（処理落ちとして扱う）
+	if (steps >= kMaxStepsPerFrame) {
+		accumulator_ = 0.0f;
+	}
+
+	// オーバーレイ表示中は下のシーンが止まっているので補間しない（最新の状態で描く）
+	auto& clock = SimulationClock::GetInstance();
+	clock.SetStepsThisFrame(steps);
+	clock.SetInterpolationAlpha(overlayScenes_.empty() ? accumulator_ / fixedDeltaTime_ : 1.0f);
+}
+
+void SceneManager::SetSimulationRate(int hz) {
+	// 対応している周波数以外は60Hzにする
+	if (!IsSupportedSimulationRate(hz)) {
+		hz = 60;
+	}
+
+	simulationRate_ = hz;
+	fixedDeltaTime_ = 1.0f / static_cast<float>(hz);
+	accumulator_ = 0.0f;
+	SimulationClock::GetInstance().SetFixedDeltaTime(fixedDeltaTime_);
+}
+
+void SceneManager::Step(float dt, const char* keys, const char* pre) {
 	// Rキーで現在シーンを再生成（初期化）
 
 #ifdef _DEBUG
@@ -30,8 +78,6 @@ void SceneManager::Update(float dt, const char* keys, const char* pre) {
 	}*/
 #endif
 
-	InputManager::GetInstance().Update();
-
 	// オーバーレイがある場合はそちらを優先
 	if (!overlayScenes_.empty()) {
 		overlayScenes_.back()->Update(dt, keys, pre);
@@ -55,6 +101,173 @@ void SceneManager::Update(float dt, const char* keys, const char* pre) {
 	}
 }
 
+const char* SceneManager::UpdateInput() {
+	InputManager& input = InputManager::GetInstance();
+	input.Update();
+	if (!recording_.IsRecording()) {
+		// フレーム間で覚えておいたキーも入った状態を渡す（InputManager::TriggerKey と食い違わないように）
+		return input.GetKeys();
+	}
+
+	// 記録中は、記録した入力と同じものをシーンに渡す（再生時と食い違わないように）
+	recordFrame_ = input.CaptureFrame();
+	recording_.Append(recordFrame_);
+	return recordFrame_.keys;
+}
+
+// ======================
+// 入力の記録・再生
+// ======================
+
+uint64_t SceneManager::ComputeStateHash() const {
+	// スナップショットに対応していないシーンは空のバイト列として扱う
+	WorldSnapshot snapshot;
+	SaveSnapshot(snapshot);
+	uint64_t hash = snapshot.ComputeHash();
+
+	// プレイヤーの位置・姿勢は値ごとに混ぜる（構造体の詰め物のバイトを含めないため）
+	if (const GameObject2D* player = currentScene_ ? currentScene_->GetPlayer() : nullptr) {
+		const Transform2D& transform = player->GetTransform();
+		hash = WorldSnapshot::HashBytes(&transform.translate.x, sizeof(float), hash);
+		hash = WorldSnapshot::HashBytes(&transform.translate.y, sizeof(float), hash);
+		hash = WorldSnapshot::HashBytes(&transform.scale.x, sizeof(float), hash);
+		hash = WorldSnapshot::HashBytes(&transform.scale.y, sizeof(float), hash);
+		hash = WorldSnapshot::HashBytes(&transform.rotation, sizeof(float), hash);
+	}
+	return hash;
+}
+
+void SceneManager::BeginSession(uint32_t seed, SceneType scene, const InputFrame& initialFrame) {
+	RandomStreams::GetInstance().SeedAll(seed);
+
+	// 開いている画面や保留中の遷移を捨て、シーンを作り直す
+	overlayScenes_.clear();
+	pendingOverlayClear_ = false;
+	pendingTransition_.reset();
+	pendingRetry_ = false;
+	accumulator_ = 0.0f;
+
+	InputManager::GetInstance().ResetToFrame(initialFrame);
+	memcpy(stepPreKeys_, initialFrame.keys, sizeof(stepPreKeys_));
+
+	ChangeScene(scene);
+}
+
+void SceneManager::StartRecording(uint32_t seed) {
+	InputRecordingHeader header;
+	header.seed = seed;
+	header.simulationRate = simulationRate_;
+	header.startScene = currentSceneType_;
+
+	const InputFrame initialFrame = InputManager::GetInstance().CaptureFrame();
+	BeginSession(seed, currentSceneType_, initialFrame);
+	recording_.Begin(header, initialFrame);
+}
+
+bool SceneManager::StopRecording(const std::string& path) {
+	if (!recording_.IsRecording()) {
+		return false;
+	}
+	recording_.Finish(Rng(RandomStreamId::Gameplay).Fingerprint(), ComputeStateHash());
+	return recording_.SaveToFile(path);
+}
+
+bool SceneManager::RunReplay(InputRecording& recording, const std::string& reportPath) {
+	using Clock = std::chrono::steady_clock;
+
+	const InputRecordingHeader& header = recording.GetHeader();
+	SetSimulationRate(header.simulationRate);
+	recording.Rewind();
+	BeginSession(header.seed, header.startScene, recording.GetInitialFrame());
+
+	// 描画しないので補間は使わない（最新の状態のまま）
+	auto& clock = SimulationClock::GetInstance();
+	clock.SetStepsThisFrame(1);
+	clock.SetInterpolationAlpha(1.0f);
+
+	InputManager& input = InputManager::GetInstance();
+	std::vector<double> stepMs;
+	stepMs.reserve(header.frameCount);
+
+	const Clock::time_point runStart = Clock::now();
+	while (const InputFrame* frame = recording.ReadNext()) {
+		const Clock::time_point stepStart = Clock::now();
+
+		input.SetInjectedFrame(frame);
+		input.Update();
+		Step(fixedDeltaTime_, frame->keys, stepPreKeys_);
+		memcpy(stepPreKeys_, frame->keys, sizeof(stepPreKeys_));
+
+		stepMs.push_back(std::chrono::duration<double, std::milli>(Clock::now() - stepStart).count());
+
+		if (shouldQuit_) {
+			break;
+		}
+	}
+	const double totalMs = std::chrono::duration<double, std::milli>(Clock::now() - runStart).count();
+	input.SetInjectedFrame(nullptr);
+
+	const uint32_t fingerprint = Rng(RandomStreamId::Gameplay).Fingerprint();
+	const uint64_t stateHash = ComputeStateHash();
+	const bool completed = stepMs.size() == header.frameCount;
+	const bool isRngMatched = fingerprint == header.fingerprint;
+	const bool isStateMatched = stateHash == header.stateHash;
+
+	json root;
+	root["seed"] = header.seed;
+	root["simulationRate"] = header.simulationRate;
+	root["recordedSteps"] = header.frameCount;
+	root["replayedSteps"] = stepMs.size();
+	root["recordingBytes"] = recording.GetByteSize();
+	root["totalMs"] = totalMs;
+	// 実時間で遊んだ場合の何倍の速さで回ったか
+	const double recordedMs = static_cast<double>(stepMs.size()) * fixedDeltaTime_ * 1000.0;
+	root["speedup"] = totalMs > 0.0 ? recordedMs / totalMs : 0.0;
+	// 乱数の状態と最終状態のハッシュが両方とも記録終了時と一致していれば、同じ流れを再現できている
+	// （乱数を使わない所でずれても、状態のハッシュで分かる）
+	root["rngMatched"] = isRngMatched;
+	root["stateMatched"] = isStateMatched;
+	root["stateHash"] = stateHash;
+	root["recordedStateHash"] = header.stateHash;
+	root["deterministic"] = completed && isRngMatched && isStateMatched;
+#ifdef _DEBUG
+	root["build"] = "Debug";
+#else
+	root["build"] = "Release";
+#endif
+
+	json step;
+	if (!stepMs.empty()) {
+		const double sum = [&stepMs]() {
+			double total = 0.0;
+			for (const double ms : stepMs) total += ms;
+			return total;
+		}();
+
+		// 最近順位法（SurvivalBenchmarkと同じ）
+		std::sort(stepMs.begin(), stepMs.end());
+		const size_t count = stepMs.size();
+		auto rank = [&stepMs, count](double percent) {
+			size_t index = static_cast<size_t>(std::ceil(percent / 100.0 * static_cast<double>(count)));
+			index = std::clamp<size_t>(index, 1, count);
+			return stepMs[index - 1];
+		};
+		step["p50"] = rank(50.0);
+		step["p95"] = rank(95.0);
+		step["p99"] = rank(99.0);
+		step["max"] = stepMs.back();
+		step["mean"] = sum / static_cast<double>(count);
+	}
+	root["stepMs"] = step;
+
+#ifdef _DEBUG
+	Novice::ConsolePrintf("Replay: %zu steps in %.1fms (deterministic=%d)\n",
+		stepMs.size(), totalMs, root["deterministic"].get<bool>() ? 1 : 0);
+#endif
+
+	return JsonUtil::SaveToFile(reportPath, root);
+}
+
 void SceneManager::Draw() {
 	if (currentScene_) {
 		currentScene_->Draw();
@@ -72,7 +285,8 @@ void SceneManager::RequestTransition(SceneType targetScene) {
 void SceneManager::RequestRetry() {
 	// オーバーレイクリアを遅延実行に変更
 	pendingOverlayClear_ = true;
-	RequestTransition(currentSceneType_);
+	pendingTransition_.reset();
+	pendingRetry_ = true;
 }
 
 void SceneManager::RequestPauseToTitle() {
@@ -126,6 +340,17 @@ void SceneManager::PopOverlay() {
 }
 
 void SceneManager::ProcessSceneTransition() {
+	if (pendingRetry_) {
+		pendingRetry_ = false;
+
+		// 開始時の状態へ書き戻す（マップの読み込みやオブジェクトの生成をやり直さない）
+		if (hasRetrySnapshot_ && RestoreSnapshot(retrySnapshot_)) {
+			return;
+		}
+		ChangeScene(currentSceneType_);
+		return;
+	}
+
 	if (!pendingTransition_) {
 		return;
 	}
@@ -134,6 +359,39 @@ void SceneManager::ProcessSceneTransition() {
 	pendingTransition_.reset();
 }
 
+bool SceneManager::SaveSnapshot(WorldSnapshot& snapshot) const {
+	if (!currentScene_) {
+		return false;
+	}
+
+	SnapshotWriter writer(snapshot);
+	writer.Write(currentSceneType_);
+	if (!currentScene_->SaveSnapshot(writer)) {
+		snapshot.Clear();
+		return false;
+	}
+
+	// シーンの復元中に乱数を使うことがあるので、乱数はシーンの後に書いて最後に戻す
+	RandomStreams::GetInstance().SaveState(writer);
+	return true;
+}
+
+bool SceneManager::RestoreSnapshot(const WorldSnapshot& snapshot) {
+	if (!currentScene_ || snapshot.IsEmpty()) {
+		return false;
+	}
+
+	SnapshotReader reader(snapshot);
+	SceneType type = SceneType::Title;
+	if (!reader.Read(type) || type != currentSceneType_) {
+		return false;
+	}
+	if (!currentScene_->RestoreSnapshot(reader)) {
+		return false;
+	}
+	return RandomStreams::GetInstance().LoadState(reader) && reader.IsAtEnd();
+}
+
 void SceneManager::ChangeScene(SceneType type) {
 	currentSceneType_ = type;
 
@@ -177,6 +435,9 @@ void SceneManager::ChangeScene(SceneType type) {
 		}
 		break;
 	}
+
+	// リトライ用に開始直後の状態を取っておく（対応していないシーンでは作り直しになる）
+	hasRetrySnapshot_ = SaveSnapshot(retrySnapshot_);
 }
 
 SceneType SceneManager::StageIndexToSceneType(int stageIndex) const {
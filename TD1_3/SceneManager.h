@@ -2,8 +2,12 @@
 #include "IGameScene.h"
 #include "GameShared.h"
 #include "SceneType.h"
+#include "InputRecording.h"
+#include "WorldSnapshot.h"
 #include <memory>
 #include <optional>
+#include <string>
+#include <cstdint>
 
 // シーン遷移情報を保持する構造体
 struct SceneTransition {
@@ -14,9 +18,53 @@ class SceneManager {
 public:
 	SceneManager();
 
-	void Update(float dt, const char* keys, const char* pre);
+	/// <summary>
+	/// 実経過時間を受け取り、固定ステップでシーンを進める
+	/// </summary>
+	/// <param name="frameDeltaTime">前フレームからの実経過時間（秒）</param>
+	void Update(float frameDeltaTime, const char* keys);
 	void Draw();
 
+	// ======================
+	// 固定ステップ更新
+	// ======================
+	// シミュレーション周波数（30 / 60 / 120 Hz。それ以外は60Hzになる）
+	void SetSimulationRate(int hz);
+	static bool IsSupportedSimulationRate(int hz) { return hz == 30 || hz == 60 || hz == 120; }
+	int GetSimulationRate() const { return simulationRate_; }
+	float GetFixedDeltaTime() const { return fixedDeltaTime_; }
+
+	// ======================
+	// 入力の記録・再生
+	// ======================
+	// 乱数の種を決め直し、現在のシーンを作り直して入力の記録を始める
+	void StartRecording(uint32_t seed);
+	// 記録を終えてファイルに書き出す
+	bool StopRecording(const std::string& path);
+	bool IsRecording() const { return recording_.IsRecording(); }
+
+	/// <summary>
+	/// 記録した入力で、描画も待ちもせずに全ステップをできるだけ速く回す
+	/// ステップ時間の分布と、記録時と乱数・シミュレーション状態が一致したかをJSONに書き出す（性能の回帰比較用）
+	/// </summary>
+	/// <returns>書き出しに成功したか</returns>
+	bool RunReplay(InputRecording& recording, const std::string& reportPath);
+
+	// ======================
+	// スナップショット
+	// ======================
+	/// <summary>
+	/// 現在のシーンのシミュレーション状態と乱数の状態を snapshot に書く（中身は上書き）
+	/// </summary>
+	/// <returns>シーンが保存に対応していれば true</returns>
+	bool SaveSnapshot(WorldSnapshot& snapshot) const;
+
+	/// <summary>
+	/// SaveSnapshot で書いた状態に戻す（同じシーンのインスタンスにだけ戻せる）
+	/// 失敗した場合シーンは途中まで書き換わっているので、作り直すこと
+	/// </summary>
+	bool RestoreSnapshot(const WorldSnapshot& snapshot);
+
 	// ゲーム終了判定
 	bool ShouldQuit() const { return shouldQuit_; }
 
@@ -31,6 +79,7 @@ public:
 	void RequestQuit() { shouldQuit_ = true; }
 
 	// プレイをリトライ(ポーズのボタンから使用)
+	// シーン開始時のスナップショットがあればそこへ戻し、無ければシーンを作り直す
 	void RequestRetry();
 
 	// ポーズからタイトルへの処理
@@ -65,6 +114,11 @@ private:
 	// 遷移リクエスト
 	std::optional<SceneTransition> pendingTransition_;
 	bool pendingOverlayClear_ = false;
+	bool pendingRetry_ = false;
+
+	// シーン開始直後の状態（リトライはシーンを作り直さずにここへ戻す）
+	WorldSnapshot retrySnapshot_;
+	bool hasRetrySnapshot_ = false;
 
 	// 共有リソース
 	GameShared shared_;
@@ -72,6 +126,22 @@ private:
 	// ゲーム終了フラグ
 	bool shouldQuit_ = false;
 
+	// 固定ステップ更新
+	static constexpr int kMaxStepsPerFrame = 8; // 処理落ち時にステップが雪だるま式に増えるのを防ぐ
+	int simulationRate_ = 60;
+	float fixedDeltaTime_ = 1.0f / 60.0f;
+	float accumulator_ = 0.0f;
+
+	// ステップ単位の前回キー状態（1フレームに複数ステップ進んでもトリガーは1回だけ）
+	char stepPreKeys_[256] = {};
+
+	// 入力の記録（記録中でなければ空）
+	InputRecording recording_;
+
+	// 現在のシミュレーション状態のハッシュ（スナップショットのバイト列とプレイヤーのTransform）
+	uint64_t ComputeStateHash() const;
+	InputFrame recordFrame_; // このステップで記録した入力（シーンにはこのキー配列を渡す）
+
 	// ステージ管理用
 	int currentStageIndex_ = -1; // 現在プレイ中のステージ (-1 = なし)
 	int pendingStageIndex_ = -1; // 遷移先ステージ番号 (RequestStage用)
@@ -83,6 +153,13 @@ private:
 	SceneType explanationReturnTo_ = SceneType::Title;
 
 	// 内部処理
+	void Step(float dt, const char* keys, const char* pre);
+
+	// 入力を1ステップ分読み、シーンに渡すキー配列を返す（記録中なら記録もする）
+	const char* UpdateInput();
+
+	// 記録・再生の開始：乱数と入力の状態を揃えて、指定シーンを作り直す
+	void BeginSession(uint32_t seed, SceneType scene, const InputFrame& initialFrame);
 	void ProcessSceneTransition();
 	SceneType StageIndexToSceneType(int stageIndex) const;
 
@@ -0,0 +1,36 @@
+﻿#pragma once
+
+/// <summary>
+/// 固定ステップ更新の時間情報
+/// SceneManagerが毎フレーム書き込み、描画側は補間係数を読んで
+/// 前ステップと現ステップの間の位置に描く
+/// </summary>
+class SimulationClock {
+public:
+	static SimulationClock& GetInstance() {
+		static SimulationClock instance;
+		return instance;
+	}
+
+	// 1ステップの経過時間（秒）
+	float GetFixedDeltaTime() const { return fixedDeltaTime_; }
+	void SetFixedDeltaTime(float dt) { fixedDeltaTime_ = dt; }
+
+	// 描画補間係数（0 = 前ステップ, 1 = 最新ステップ）
+	float GetInterpolationAlpha() const { return interpolationAlpha_; }
+	void SetInterpolationAlpha(float alpha) { interpolationAlpha_ = alpha; }
+
+	// 直近のフレームで進めたステップ数
+	int GetStepsThisFrame() const { return stepsThisFrame_; }
+	void SetStepsThisFrame(int steps) { stepsThisFrame_ = steps; }
+
+private:
+	SimulationClock() = default;
+	~SimulationClock() = default;
+	SimulationClock(const SimulationClock&) = delete;
+	SimulationClock& operator=(const SimulationClock&) = delete;
+
+	float fixedDeltaTime_ = 1.0f / 60.0f;
+	float interpolationAlpha_ = 1.0f;
+	int stepsThisFrame_ = 0;
+};
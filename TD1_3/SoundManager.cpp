@@ -34,6 +34,8 @@ void SoundManager::LoadResources() {
 }
 
 void SoundManager::PlayBgm(BgmId id, bool loop) {
+	if (isMuted_) return;
+
 	// 既に同じ曲が流れているなら何もしない（音量更新だけ念の為行う）
 	if (currentBgmId_ == id && Novice::IsPlayingAudio(currentBgmPlayHandle_)) {
 		Novice::SetAudioVolume(currentBgmPlayHandle_, bgmVolume_);
@@ -60,12 +62,21 @@ void SoundManager::StopBgm() {
 }
 
 void SoundManager::PlaySe(SeId id) {
+	if (isMuted_) return;
+
 	int resourceHandle = seResources_[static_cast<int>(id)];
 	if (resourceHandle != -1) {
 		Novice::PlayAudio(resourceHandle, false, seVolume_);
 	}
 }
 
+void SoundManager::SetMuted(bool muted) {
+	isMuted_ = muted;
+	if (isMuted_) {
+		StopBgm();
+	}
+}
+
 void SoundManager::SetBgmVolume(float volume) {
 	bgmVolume_ = volume;
 
@@ -58,11 +58,16 @@ public:
 	// 現在再生中のBGMにボリュームを再適用
 	void ApplyAudioSettings();
 
+	// 消音（描画しない再生モード用）。消音中は再生要求を無視する
+	void SetMuted(bool muted);
+	bool IsMuted() const { return isMuted_; }
+
 	// 一度だけリソースをロード(mainの初期化時に一回)
 	void LoadResources();
 private:
 	
 	bool isLoaded_ = false;
+	bool isMuted_ = false;
 
 	float bgmVolume_ = 0.0f;
 	float seVolume_ = 0.0f;
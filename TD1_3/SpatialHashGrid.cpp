@@ -0,0 +1,128 @@
+﻿#include "SpatialHashGrid.h"
+#include <cmath>
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#include <emmintrin.h>
+#define SPATIAL_HASH_USE_SSE
+#endif
+
+int SpatialHashGrid::ToCell(float v) const {
+    return static_cast<int>(std::floor(v * invCellSize_));
+}
+
+uint32_t SpatialHashGrid::ToBucket(int cellX, int cellY) const {
+    // 大きな素数を掛けて混ぜる（負のセル座標もそのまま扱える）
+    const uint32_t h = static_cast<uint32_t>(cellX) * 73856093u ^ static_cast<uint32_t>(cellY) * 19349663u;
+    return h & tableMask_;
+}
+
+void SpatialHashGrid::Build(const float* xs, const float* ys, size_t count, float cellSize) {
+    cellSize_ = cellSize > 0.0f ? cellSize : 1.0f;
+    invCellSize_ = 1.0f / cellSize_;
+
+    // バケット数は要素数の2倍以上の2のべき乗（衝突を減らしつつ小さく保つ）
+    uint32_t tableSize = 16;
+    while (tableSize < count * 2) {
+        tableSize <<= 1;
+    }
+    tableMask_ = tableSize - 1;
+
+    // 1. バケットごとの件数を数える
+    bucketStart_.assign(static_cast<size_t>(tableSize) + 1, 0);
+    itemBucket_.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t bucket = ToBucket(ToCell(xs[i]), ToCell(ys[i]));
+        itemBucket_[i] = bucket;
+        ++bucketStart_[bucket + 1];
+    }
+
+    // 2. 累積して開始位置にする
+    for (uint32_t b = 0; b < tableSize; ++b) {
+        bucketStart_[b + 1] += bucketStart_[b];
+    }
+
+    // 3. 後ろから詰める（開始位置を減らしながら置くので作業配列がいらない）
+    items_.resize(count);
+    for (size_t i = count; i > 0; --i) {
+        const uint32_t bucket = itemBucket_[i - 1];
+        items_[--bucketStart_[bucket + 1]] = static_cast<uint32_t>(i - 1);
+    }
+    // ここで bucketStart_[b + 1] はバケットbの先頭になっているので1つずらす
+    for (uint32_t b = 0; b < tableSize; ++b) {
+        bucketStart_[b] = bucketStart_[b + 1];
+    }
+    bucketStart_[tableSize] = static_cast<uint32_t>(count);
+}
+
+void SpatialHashGrid::QueryNeighbors(float x, float y, std::vector<uint32_t>& out) const {
+    if (items_.empty()) return;
+
+    const int cellX = ToCell(x);
+    const int cellY = ToCell(y);
+
+    // 周囲9セルのバケット（同じバケットに当たったセルは1回だけ調べる）
+    uint32_t buckets[9];
+    int bucketCount = 0;
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            const uint32_t bucket = ToBucket(cellX + dx, cellY + dy);
+            bool isDuplicate = false;
+            for (int k = 0; k < bucketCount; ++k) {
+                if (buckets[k] == bucket) {
+                    isDuplicate = true;
+                    break;
+                }
+            }
+            if (!isDuplicate) {
+                buckets[bucketCount++] = bucket;
+            }
+        }
+    }
+
+    for (int k = 0; k < bucketCount; ++k) {
+        const uint32_t begin = bucketStart_[buckets[k]];
+        const uint32_t end = bucketStart_[buckets[k] + 1];
+        out.insert(out.end(), items_.begin() + begin, items_.begin() + end);
+    }
+}
+
+void SpatialHashGrid::FilterWithinRadius(const float* xs, const float* ys,
+    const std::vector<uint32_t>& candidates, float x, float y, float radiusSq,
+    std::vector<uint32_t>& out) {
+    out.clear();
+
+    const size_t count = candidates.size();
+    size_t i = 0;
+
+#ifdef SPATIAL_HASH_USE_SSE
+    const __m128 cx = _mm_set1_ps(x);
+    const __m128 cy = _mm_set1_ps(y);
+    const __m128 r2 = _mm_set1_ps(radiusSq);
+
+    for (; i + 4 <= count; i += 4) {
+        const uint32_t* idx = &candidates[i];
+        const __m128 px = _mm_set_ps(xs[idx[3]], xs[idx[2]], xs[idx[1]], xs[idx[0]]);
+        const __m128 py = _mm_set_ps(ys[idx[3]], ys[idx[2]], ys[idx[1]], ys[idx[0]]);
+        const __m128 dx = _mm_sub_ps(px, cx);
+        const __m128 dy = _mm_sub_ps(py, cy);
+        const __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+
+        int mask = _mm_movemask_ps(_mm_cmplt_ps(d2, r2));
+        for (int lane = 0; mask != 0; ++lane, mask >>= 1) {
+            if (mask & 1) {
+                out.push_back(idx[lane]);
+            }
+        }
+    }
+#endif
+
+    // 残り（SSEが使えない環境では全件）
+    for (; i < count; ++i) {
+        const uint32_t index = candidates[i];
+        const float dx = xs[index] - x;
+        const float dy = ys[index] - y;
+        if (dx * dx + dy * dy < radiusSq) {
+            out.push_back(index);
+        }
+    }
+}
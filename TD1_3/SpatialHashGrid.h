@@ -0,0 +1,63 @@
+﻿#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/// <summary>
+/// 点の集まりを一様なセルに分ける空間ハッシュ（毎フレーム作り直す前提）
+/// セル座標をハッシュ表のバケットに割り当て、バケットごとに要素番号を詰めて並べる
+/// 半径がセルサイズ以下の円同士なら、周囲3x3セルを調べれば全ての候補が見つかる
+/// </summary>
+/// <remarks>
+/// 別々のセルが同じバケットに入ることがあるので、候補には遠い要素も混ざる
+/// 必ず距離判定（FilterWithinRadiusなど）で絞り込むこと
+/// </remarks>
+class SpatialHashGrid {
+public:
+    SpatialHashGrid() = default;
+    ~SpatialHashGrid() = default;
+
+    /// <summary>
+    /// 位置配列からセル分けをやり直す
+    /// </summary>
+    /// <param name="xs">X座標の配列</param>
+    /// <param name="ys">Y座標の配列</param>
+    /// <param name="count">要素数</param>
+    /// <param name="cellSize">セルの一辺（判定したい最大距離以上にする）</param>
+    void Build(const float* xs, const float* ys, size_t count, float cellSize);
+
+    /// <summary>
+    /// (x, y) を含むセルと周囲8セルに入っている要素番号を out の末尾に追加する（重複なし）
+    /// </summary>
+    void QueryNeighbors(float x, float y, std::vector<uint32_t>& out) const;
+
+    /// <summary>
+    /// 候補のうち (x, y) との距離の2乗が radiusSq 未満のものだけ out に書き出す（SIMDで4件ずつ判定）
+    /// </summary>
+    /// <param name="xs">X座標の配列（Buildに渡したもの）</param>
+    /// <param name="ys">Y座標の配列（Buildに渡したもの）</param>
+    /// <param name="candidates">候補の要素番号</param>
+    /// <param name="x">中心X</param>
+    /// <param name="y">中心Y</param>
+    /// <param name="radiusSq">判定距離の2乗</param>
+    /// <param name="out">結果（上書き）</param>
+    static void FilterWithinRadius(const float* xs, const float* ys,
+        const std::vector<uint32_t>& candidates, float x, float y, float radiusSq,
+        std::vector<uint32_t>& out);
+
+    float GetCellSize() const { return cellSize_; }
+    size_t GetCount() const { return items_.size(); }
+
+private:
+    float cellSize_ = 1.0f;
+    float invCellSize_ = 1.0f;
+    uint32_t tableMask_ = 0;
+
+    // バケットごとの要素（bucketStart_[b] から bucketStart_[b + 1] の手前まで）
+    std::vector<uint32_t> bucketStart_;
+    std::vector<uint32_t> items_;
+    std::vector<uint32_t> itemBucket_; // 作業用：要素ごとのバケット番号
+
+    int ToCell(float v) const;
+    uint32_t ToBucket(int cellX, int cellY) const;
+};
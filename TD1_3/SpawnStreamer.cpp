@@ -0,0 +1,219 @@
+﻿#include "SpawnStreamer.h"
+#include "GameObjectManager.h"
+#include "WorldSnapshot.h"
+#include <algorithm>
+#include <cmath>
+
+void SpawnStreamer::Add(const ObjectSpawnInfo& spawn) {
+    SpawnRecord record;
+    record.objectTypeId = spawn.objectTypeId;
+    record.position = spawn.position;
+    record.tag = InternTag(spawn.tag.empty() ? "Untagged" : spawn.tag);
+    record.params = spawn.params;
+    records_.push_back(record);
+}
+
+void SpawnStreamer::Build() {
+    cells_.clear();
+    activeRecords_.clear();
+    gridCols_ = 0;
+    gridRows_ = 0;
+    if (records_.empty()) return;
+
+    // 配置範囲を囲むグリッドを作る（範囲外に動いたものは端のセルに入れる）
+    Vector2 minPos = records_[0].position;
+    Vector2 maxPos = records_[0].position;
+    for (const SpawnRecord& record : records_) {
+        minPos.x = std::min(minPos.x, record.position.x);
+        minPos.y = std::min(minPos.y, record.position.y);
+        maxPos.x = std::max(maxPos.x, record.position.x);
+        maxPos.y = std::max(maxPos.y, record.position.y);
+    }
+    gridOrigin_ = minPos;
+    gridCols_ = static_cast<int>((maxPos.x - minPos.x) / kCellSize) + 1;
+    gridRows_ = static_cast<int>((maxPos.y - minPos.y) / kCellSize) + 1;
+
+    cells_.resize(static_cast<size_t>(gridCols_) * gridRows_);
+    for (size_t i = 0; i < records_.size(); ++i) {
+        SpawnRecord& record = records_[i];
+        record.cell = ToCell(record.position);
+        cells_[record.cell].push_back(static_cast<uint32_t>(i));
+    }
+}
+
+void SpawnStreamer::Clear() {
+    records_.clear();
+    cells_.clear();
+    activeRecords_.clear();
+    gridCols_ = 0;
+    gridRows_ = 0;
+}
+
+void SpawnStreamer::SaveState(SnapshotWriter& writer, const GameObjectManager& manager) const {
+    writer.Write(static_cast<uint32_t>(records_.size()));
+    for (const SpawnRecord& record : records_) {
+        SpawnState state = record.state;
+        Vector2 position = record.position;
+        int hp = record.params.hp;
+
+        // 生成中のものは、範囲外に出て消した時と同じように今の状態を書き戻して保存する
+        if (state == SpawnState::Active) {
+            if (GameObject2D* obj = manager.Resolve(record.handle); obj && !obj->IsDead()) {
+                position = obj->GetPosition();
+                hp = obj->GetStatus().currentHP;
+            }
+            else {
+                state = SpawnState::Consumed;
+            }
+        }
+
+        writer.Write(state);
+        writer.Write(position);
+        writer.Write(hp);
+    }
+}
+
+bool SpawnStreamer::LoadState(SnapshotReader& reader) {
+    uint32_t count = 0;
+    reader.Read(count);
+    if (!reader.IsOk() || count != records_.size()) {
+        return false;
+    }
+
+    activeRecords_.clear();
+    for (uint32_t index = 0; index < count; ++index) {
+        SpawnRecord& record = records_[index];
+        reader.Read(record.state);
+        reader.Read(record.position);
+        reader.Read(record.params.hp);
+
+        if (record.state == SpawnState::Active) {
+            record.state = SpawnState::Dormant;
+        }
+        record.handle = {};
+        MoveToCell(index, ToCell(record.position));
+    }
+    return reader.IsOk();
+}
+
+int SpawnStreamer::ToCol(float x) const {
+    const int col = static_cast<int>(std::floor((x - gridOrigin_.x) / kCellSize));
+    return std::clamp(col, 0, gridCols_ - 1);
+}
+
+int SpawnStreamer::ToRow(float y) const {
+    const int row = static_cast<int>(std::floor((y - gridOrigin_.y) / kCellSize));
+    return std::clamp(row, 0, gridRows_ - 1);
+}
+
+uint32_t SpawnStreamer::ToCell(const Vector2& pos) const {
+    return static_cast<uint32_t>(ToRow(pos.y) * gridCols_ + ToCol(pos.x));
+}
+
+void SpawnStreamer::MoveToCell(uint32_t index, uint32_t cell) {
+    SpawnRecord& record = records_[index];
+    if (record.cell == cell) return;
+
+    // 元のセルからは末尾と入れ替えて外す
+    std::vector<uint32_t>& from = cells_[record.cell];
+    const auto it = std::find(from.begin(), from.end(), index);
+    if (it != from.end()) {
+        *it = from.back();
+        from.pop_back();
+    }
+
+    cells_[cell].push_back(index);
+    record.cell = cell;
+}
+
+void SpawnStreamer::Update(const Vector2& center, GameObjectManager& manager) {
+    if (records_.empty()) return;
+
+    // 1. 生成済みのものを確認（倒されたものは消費済みに、遠いものは書き戻して消す）
+    const float despawnRadius = activationRadius_ + despawnMargin_;
+    const float despawnRadiusSq = despawnRadius * despawnRadius;
+
+    size_t i = 0;
+    while (i < activeRecords_.size()) {
+        const uint32_t index = activeRecords_[i];
+        SpawnRecord& record = records_[index];
+        GameObject2D* obj = manager.Resolve(record.handle);
+
+        bool isFinished = false;
+        if (!obj || obj->IsDead()) {
+            record.state = SpawnState::Consumed;
+            record.handle = {};
+            isFinished = true;
+        }
+        else if (isDespawnEnabled_ && !record.params.persistent) {
+            const Vector2 d = obj->GetPosition() - center;
+            if (d.x * d.x + d.y * d.y > despawnRadiusSq) {
+                Deactivate(record, *obj);
+                MoveToCell(index, ToCell(record.position));
+                isFinished = true;
+            }
+        }
+
+        if (isFinished) {
+            activeRecords_[i] = activeRecords_.back();
+            activeRecords_.pop_back();
+            continue;
+        }
+        ++i;
+    }
+
+    // 2. 中心の周りのセルだけ調べて、範囲に入った未生成のものを作る
+    if (gridCols_ <= 0 || gridRows_ <= 0) return;
+
+    const float radiusSq = activationRadius_ * activationRadius_;
+    const int colMin = ToCol(center.x - activationRadius_);
+    const int colMax = ToCol(center.x + activationRadius_);
+    const int rowMin = ToRow(center.y - activationRadius_);
+    const int rowMax = ToRow(center.y + activationRadius_);
+
+    for (int row = rowMin; row <= rowMax; ++row) {
+        for (int col = colMin; col <= colMax; ++col) {
+            for (const uint32_t index : cells_[static_cast<size_t>(row) * gridCols_ + col]) {
+                const SpawnRecord& record = records_[index];
+                if (record.state != SpawnState::Dormant) continue;
+
+                const Vector2 d = record.position - center;
+                if (d.x * d.x + d.y * d.y <= radiusSq) {
+                    Activate(index);
+                }
+            }
+        }
+    }
+}
+
+void SpawnStreamer::Activate(uint32_t index) {
+    SpawnRecord& record = records_[index];
+
+    GameObject2D* obj = spawnFunc_ ? spawnFunc_(record) : nullptr;
+    if (!obj) {
+        // 作れない種類は二度と試さない
+        record.state = SpawnState::Consumed;
+        return;
+    }
+
+    // 書き戻された状態を反映
+    obj->SetPosition(record.position);
+    obj->SavePreviousTransform();
+    if (record.params.hp >= 0) {
+        obj->GetStatus().currentHP = record.params.hp;
+    }
+
+    record.state = SpawnState::Active;
+    record.handle = obj->GetHandle();
+    activeRecords_.push_back(index);
+}
+
+void SpawnStreamer::Deactivate(SpawnRecord& record, GameObject2D& obj) {
+    // 次に生成するときのために状態を書き戻す
+    record.position = obj.GetPosition();
+    record.params.hp = obj.GetStatus().currentHP;
+
+    obj.Destroy();
+    record.state = SpawnState::Dormant;
+    record.handle = {};
+}
@@ -0,0 +1,124 @@
+﻿#pragma once
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include "Vector2.h"
+#include "MapData.h"
+#include "ObjectHandle.h"
+#include "TagRegistry.h"
+
+class GameObject2D; // 前方宣言
+class GameObjectManager;
+class SnapshotWriter;
+class SnapshotReader;
+
+// 配置データ1件ごとの状態
+enum class SpawnState : uint8_t {
+    Dormant,  // 未生成（範囲に入ったら生成する）
+    Active,   // 生成済み
+    Consumed  // 倒された等で消えた（もう生成しない）
+};
+
+/// <summary>
+/// 範囲生成用に写した配置データ
+/// 範囲外に出て消したときは、位置やHPをここへ書き戻して次の生成に使う
+/// </summary>
+struct SpawnRecord {
+    int objectTypeId = 0;
+    Vector2 position = { 0.0f, 0.0f };
+    TagId tag = kUntaggedTag;
+    SpawnParams params;
+
+    SpawnState state = SpawnState::Dormant;
+    ObjectHandle handle; // Activeの間だけ有効
+    uint32_t cell = 0;   // 所属しているセル番号
+};
+
+/// <summary>
+/// MapDataの配置データを、カメラの周りに入ったものだけ生成するクラス
+/// 配置データを一定サイズのセルに分けて持ち、カメラ周辺のセルだけを調べる
+/// 離れたものは（persistentでなければ）状態を書き戻して消し、再び近づいたら作り直す
+/// </summary>
+class SpawnStreamer {
+public:
+    // 配置データからオブジェクトを作る関数（作れない種類ならnullptrを返す）
+    using SpawnFunc = std::function<GameObject2D*(const SpawnRecord&)>;
+
+    SpawnStreamer() = default;
+    ~SpawnStreamer() = default;
+
+    /// <summary>
+    /// 配置データを追加する（追加し終えたらBuildを呼ぶ）
+    /// </summary>
+    void Add(const ObjectSpawnInfo& spawn);
+
+    /// <summary>
+    /// 追加した配置データからセルの索引を作る
+    /// </summary>
+    void Build();
+
+    /// <summary>
+    /// 全ての配置データを破棄する（生成済みのオブジェクトは消さない）
+    /// </summary>
+    void Clear();
+
+    /// <summary>
+    /// 生成・削除の判定（マネージャーのUpdateより前に呼ぶ）
+    /// </summary>
+    /// <param name="center">判定の中心（カメラ位置）</param>
+    /// <param name="manager">生成先のマネージャー（生存確認に使う）</param>
+    void Update(const Vector2& center, GameObjectManager& manager);
+
+    /// <summary>
+    /// 配置データごとの状態を保存する（生成中のものは今の位置・HPを書き戻した形で保存する）
+    /// </summary>
+    void SaveState(SnapshotWriter& writer, const GameObjectManager& manager) const;
+
+    /// <summary>
+    /// 保存した状態に戻す。生成中だったものは未生成に戻し、次のUpdateで保存時の位置・HPから作り直す
+    /// 呼ぶ前に、このクラスが生成したオブジェクトはマネージャーから削除しておくこと
+    /// </summary>
+    /// <returns>配置データの数が保存時と一致して戻せたか</returns>
+    bool LoadState(SnapshotReader& reader);
+
+    void SetSpawnFunction(SpawnFunc func) { spawnFunc_ = std::move(func); }
+
+    // 生成する半径と、削除するまでの余裕（生成半径 + 余裕 より離れたら消す）
+    void SetActivationRadius(float radius) { activationRadius_ = radius; }
+    void SetDespawnMargin(float margin) { despawnMargin_ = margin; }
+    float GetActivationRadius() const { return activationRadius_; }
+
+    // 範囲外に出たオブジェクトを消すか（falseなら一度生成したものは残し続ける）
+    void SetDespawnEnabled(bool enable) { isDespawnEnabled_ = enable; }
+
+    size_t GetRecordCount() const { return records_.size(); }
+    size_t GetActiveCount() const { return activeRecords_.size(); }
+    const std::vector<SpawnRecord>& GetRecords() const { return records_; }
+
+private:
+    static constexpr float kCellSize = 1024.0f;
+
+    std::vector<SpawnRecord> records_;
+
+    // セルごとの配置データ番号（書き戻しで位置が変わったものは入れ替える）
+    std::vector<std::vector<uint32_t>> cells_;
+    Vector2 gridOrigin_ = { 0.0f, 0.0f };
+    int gridCols_ = 0;
+    int gridRows_ = 0;
+
+    // 生成済みの配置データ番号
+    std::vector<uint32_t> activeRecords_;
+
+    SpawnFunc spawnFunc_;
+    float activationRadius_ = 1600.0f;
+    float despawnMargin_ = 512.0f;
+    bool isDespawnEnabled_ = true;
+
+    int ToCol(float x) const;
+    int ToRow(float y) const;
+    uint32_t ToCell(const Vector2& pos) const;
+    void MoveToCell(uint32_t index, uint32_t cell);
+
+    void Activate(uint32_t index);
+    void Deactivate(SpawnRecord& record, GameObject2D& obj);
+};
@@ -0,0 +1,222 @@
+﻿#include "SurvivalBenchmark.h"
+#include "SurvivalGameManager.h"
+#include "SurvivalObjects.h"
+#include "InputManager.h"
+#include "Camera2D.h"
+#include "WindowSize.h"
+#include "JsonUtil.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <random>
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#endif
+
+SurvivalBenchmark::SurvivalBenchmark(const SurvivalBenchmarkSettings& settings)
+    : settings_(settings) {}
+
+bool SurvivalBenchmark::Run() {
+    std::vector<StageResult> results;
+    results.reserve(settings_.stages.size());
+
+    // 少ない順に回す（ピークメモリはプロセス全体の最大値なので、その段階までの最大になる）
+    for (const SurvivalBenchmarkStage& stage : settings_.stages) {
+        results.push_back(RunStage(stage));
+#ifdef _DEBUG
+        const StageResult& result = results.back();
+        Novice::ConsolePrintf("SurvivalBenchmark: enemies=%d debris=%d frame p50=%.3fms p99=%.3fms\n",
+            stage.enemyCount, stage.debrisCount, result.frameMs.p50, result.frameMs.p99);
+#endif
+    }
+
+    return WriteResults(results);
+}
+
+SurvivalBenchmark::StageResult SurvivalBenchmark::RunStage(const SurvivalBenchmarkStage& stage) {
+    using Clock = std::chrono::steady_clock;
+
+    StageResult result;
+    result.stage = stage;
+
+    // 入力は毎フレーム決まったキー配列に差し替える
+    char keys[256] = { 0 };
+    InputManager input;
+    input.SetScriptedKeys(keys);
+
+    SurvivalGameObjectManager manager;
+    manager.ReserveEnemies(static_cast<size_t>(stage.enemyCount));
+
+    SurvivalPlayer* player = manager.CreatePlayer(&input);
+    const ObjectHandle target = player->GetHandle();
+    manager.CreateDebrisController(&input, target, stage.debrisCount);
+
+    Camera2D camera(Vector2(kWindowWidth / 2, kWindowHeight / 2), Vector2(kWindowWidth, kWindowHeight));
+    camera.SetZoom(1.4f);
+
+    // 敵はプレイヤーの周りの輪に置く（倒された分は毎フレーム補充して数を保つ）
+    std::mt19937 rng(settings_.seed);
+    std::uniform_real_distribution<float> angleDist(0.0f, 6.2831853f);
+    std::uniform_real_distribution<float> radiusDist(250.0f, 1400.0f);
+    std::uniform_int_distribution<int> typeDist(0, 4);
+
+    auto refillEnemies = [&]() {
+        const Vector2 center = manager.GetPlayer() ? manager.GetPlayer()->GetPosition()
+                                                   : Vector2{ kWindowWidth / 2.0f, kWindowHeight / 2.0f };
+        while (static_cast<int>(manager.GetEnemies().size()) < stage.enemyCount) {
+            const float angle = angleDist(rng);
+            const float radius = radiusDist(rng);
+            const Vector2 pos = { center.x + std::cos(angle) * radius, center.y + std::sin(angle) * radius };
+            // タンク率 20%（PrototypeSurvivalSceneと同じ）
+            const EnemyType type = (typeDist(rng) == 0) ? EnemyType::Tank : EnemyType::Normal;
+            manager.CreateEnemy(pos, type, target);
+        }
+    };
+
+    const size_t sampleCount = static_cast<size_t>(settings_.measureFrames);
+    std::vector<double> updateSamples;
+    std::vector<double> collisionSamples;
+    std::vector<double> drawSamples;
+    std::vector<double> frameSamples;
+    updateSamples.reserve(sampleCount);
+    collisionSamples.reserve(sampleCount);
+    drawSamples.reserve(sampleCount);
+    frameSamples.reserve(sampleCount);
+    double drawnTotal = 0.0;
+
+    const int totalFrames = settings_.warmupFrames + settings_.measureFrames;
+    for (int frame = 0; frame < totalFrames; ++frame) {
+        MakeScriptedKeys(frame, keys);
+        input.Update();
+
+        // 補充は計測に含めない
+        refillEnemies();
+
+        const Clock::time_point frameStart = Clock::now();
+
+        manager.Update(settings_.deltaTime);
+        camera.Update(settings_.deltaTime);
+        camera.ApplyInterpolation(1.0f);
+
+        const Clock::time_point drawStart = Clock::now();
+        manager.PrepareDraw(camera);
+        const Clock::time_point frameEnd = Clock::now();
+
+        if (frame < settings_.warmupFrames) continue;
+
+        const SurvivalFrameProfile& profile = manager.GetFrameProfile();
+        updateSamples.push_back(profile.updateMs);
+        collisionSamples.push_back(profile.collisionMs);
+        drawSamples.push_back(std::chrono::duration<double, std::milli>(frameEnd - drawStart).count());
+        frameSamples.push_back(std::chrono::duration<double, std::milli>(frameEnd - frameStart).count());
+        drawnTotal += manager.GetDrawStats().drawn;
+    }
+
+    result.updateMs = Summarize(updateSamples);
+    result.collisionMs = Summarize(collisionSamples);
+    result.drawSubmitMs = Summarize(drawSamples);
+    result.frameMs = Summarize(frameSamples);
+    result.averageDrawn = sampleCount > 0 ? drawnTotal / static_cast<double>(sampleCount) : 0.0;
+    GetPeakMemory(result.peakWorkingSetBytes, result.peakPagefileBytes);
+
+    return result;
+}
+
+void SurvivalBenchmark::MakeScriptedKeys(int frame, char* keys) {
+    std::memset(keys, 0, 256);
+
+    // 1.5秒ごとに 上 → 右 → 下 → 左 と四角を描いて動く
+    static const int kMoveKeys[] = { DIK_W, DIK_D, DIK_S, DIK_A };
+    keys[kMoveKeys[(frame / 90) % 4]] = 1;
+
+    // 1.5秒押して1秒離す（拡大 → 収縮攻撃 を繰り返す）
+    if (frame % 150 < 90) {
+        keys[DIK_SPACE] = 1;
+    }
+}
+
+SurvivalBenchmark::Percentiles SurvivalBenchmark::Summarize(std::vector<double>& samples) {
+    Percentiles result;
+    if (samples.empty()) return result;
+
+    std::sort(samples.begin(), samples.end());
+
+    // 最近順位法（p% 以上のサンプルがその値以下になる最小の値）
+    const size_t count = samples.size();
+    auto rank = [&samples, count](double percent) {
+        size_t index = static_cast<size_t>(std::ceil(percent / 100.0 * static_cast<double>(count)));
+        index = std::clamp<size_t>(index, 1, count);
+        return samples[index - 1];
+    };
+
+    double sum = 0.0;
+    for (const double sample : samples) {
+        sum += sample;
+    }
+
+    result.p50 = rank(50.0);
+    result.p95 = rank(95.0);
+    result.p99 = rank(99.0);
+    result.max = samples.back();
+    result.mean = sum / static_cast<double>(count);
+    return result;
+}
+
+void SurvivalBenchmark::GetPeakMemory(size_t& workingSet, size_t& pagefile) {
+    workingSet = 0;
+    pagefile = 0;
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters = {};
+    counters.cb = sizeof(counters);
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        workingSet = counters.PeakWorkingSetSize;
+        pagefile = counters.PeakPagefileUsage;
+    }
+#endif
+}
+
+bool SurvivalBenchmark::WriteResults(const std::vector<StageResult>& results) const {
+    auto toJson = [](const Percentiles& p) {
+        json j;
+        j["p50"] = p.p50;
+        j["p95"] = p.p95;
+        j["p99"] = p.p99;
+        j["max"] = p.max;
+        j["mean"] = p.mean;
+        return j;
+    };
+
+    json root;
+    root["deltaTime"] = settings_.deltaTime;
+    root["warmupFrames"] = settings_.warmupFrames;
+    root["measureFrames"] = settings_.measureFrames;
+    root["seed"] = settings_.seed;
+#ifdef _DEBUG
+    root["build"] = "Debug";
+#else
+    root["build"] = "Release";
+#endif
+
+    json stages = json::array();
+    for (const StageResult& result : results) {
+        json stage;
+        stage["enemies"] = result.stage.enemyCount;
+        stage["debrisPieces"] = result.stage.debrisCount;
+        stage["updateMs"] = toJson(result.updateMs);
+        stage["collisionMs"] = toJson(result.collisionMs);
+        stage["drawSubmitMs"] = toJson(result.drawSubmitMs);
+        stage["frameMs"] = toJson(result.frameMs);
+        stage["averageDrawn"] = result.averageDrawn;
+        stage["peakWorkingSetBytes"] = result.peakWorkingSetBytes;
+        stage["peakPagefileBytes"] = result.peakPagefileBytes;
+        stages.push_back(stage);
+    }
+    root["stages"] = stages;
+
+    return JsonUtil::SaveToFile(settings_.outputPath, root);
+}
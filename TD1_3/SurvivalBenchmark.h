@@ -0,0 +1,78 @@
+﻿#pragma once
+#include <string>
+#include <vector>
+
+/// <summary>
+/// 負荷段階1つ分の設定
+/// </summary>
+struct SurvivalBenchmarkStage {
+    int enemyCount = 1000;  // 常に保つ敵の数（倒された分はすぐ補充する）
+    int debrisCount = 64;   // がれき片の数
+};
+
+/// <summary>
+/// ベンチマーク全体の設定
+/// </summary>
+struct SurvivalBenchmarkSettings {
+    // 敵の数を段階的に増やす（1k → 20k）。がれき片も合わせて増やす（64 → 4k）
+    std::vector<SurvivalBenchmarkStage> stages = {
+        { 1000, 64 },
+        { 2500, 256 },
+        { 5000, 1024 },
+        { 10000, 2048 },
+        { 20000, 4096 },
+    };
+    int warmupFrames = 120;   // 計測しないフレーム数（敵が寄ってくるまで待つ）
+    int measureFrames = 600;  // 計測するフレーム数
+    float deltaTime = 1.0f / 60.0f;
+    unsigned int seed = 12345; // 敵の配置に使う乱数の種（同じ種なら毎回同じ配置）
+    std::string outputPath = "./survival_benchmark.json";
+};
+
+/// <summary>
+/// サバイバルモードの負荷計測
+/// ウィンドウに描かずに、決まった入力で固定フレーム数だけ SurvivalGameObjectManager を回し、
+/// 更新・衝突判定・描画準備（並べ替えとカリング）の時間の分布とピークメモリをJSONに書き出す
+/// </summary>
+class SurvivalBenchmark {
+public:
+    explicit SurvivalBenchmark(const SurvivalBenchmarkSettings& settings = {});
+
+    /// <summary>
+    /// 全段階を実行して結果を書き出す
+    /// </summary>
+    /// <returns>書き出しに成功したか</returns>
+    bool Run();
+
+private:
+    // 1項目分の計測値（ミリ秒）の集計
+    struct Percentiles {
+        double p50 = 0.0;
+        double p95 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+        double mean = 0.0;
+    };
+
+    struct StageResult {
+        SurvivalBenchmarkStage stage;
+        Percentiles updateMs;
+        Percentiles collisionMs;
+        Percentiles drawSubmitMs;
+        Percentiles frameMs;
+        double averageDrawn = 0.0;     // 1フレームに描画対象になった数の平均
+        size_t peakWorkingSetBytes = 0; // 段階終了時点のプロセスのピーク使用量（これまでの最大）
+        size_t peakPagefileBytes = 0;
+    };
+
+    SurvivalBenchmarkSettings settings_;
+
+    StageResult RunStage(const SurvivalBenchmarkStage& stage);
+    bool WriteResults(const std::vector<StageResult>& results) const;
+
+    // 決まった入力を作る（フレーム番号から毎回同じ入力になる）
+    static void MakeScriptedKeys(int frame, char* keys);
+
+    static Percentiles Summarize(std::vector<double>& samples);
+    static void GetPeakMemory(size_t& workingSet, size_t& pagefile);
+};
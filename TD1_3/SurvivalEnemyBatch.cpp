@@ -0,0 +1,340 @@
+﻿#include "SurvivalEnemyBatch.h"
+#include "SurvivalObjects.h"
+#include "WorldSnapshot.h"
+#include <cmath>
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#include <emmintrin.h>
+#define SURVIVAL_ENEMY_USE_SSE
+#endif
+
+namespace {
+    // 配列から1要素を末尾と入れ替えて取り除く
+    template <typename T>
+    void SwapAndPop(std::vector<T>& values, size_t index) {
+        values[index] = values.back();
+        values.pop_back();
+    }
+
+#ifdef SURVIVAL_ENEMY_USE_SSE
+    // mask が立っているレーンは a、そうでなければ b
+    inline __m128 Select(__m128 mask, __m128 a, __m128 b) {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+#endif
+}
+
+void SurvivalEnemyBatch::Add(SurvivalEnemy* enemy, const Vector2& position, EnemyType type, ObjectHandle target) {
+    const EnemyTypeParams& params = GetEnemyTypeParams(type);
+
+    enemy->batch_ = this;
+    enemy->batchIndex_ = objects_.size();
+
+    objects_.push_back(enemy);
+    target_.push_back(target);
+    posX_.push_back(position.x);
+    posY_.push_back(position.y);
+    knockVelX_.push_back(0.0f);
+    knockVelY_.push_back(0.0f);
+    knockTimer_.push_back(0.0f);
+    invincibleTimer_.push_back(0.0f);
+    radius_.push_back(params.radius);
+    speed_.push_back(params.speed);
+    hp_.push_back(params.hp);
+    type_.push_back(type);
+}
+
+void SurvivalEnemyBatch::SaveState(SnapshotWriter& writer) const {
+    writer.WriteArray(target_);
+    writer.WriteArray(posX_);
+    writer.WriteArray(posY_);
+    writer.WriteArray(knockVelX_);
+    writer.WriteArray(knockVelY_);
+    writer.WriteArray(knockTimer_);
+    writer.WriteArray(invincibleTimer_);
+    writer.WriteArray(radius_);
+    writer.WriteArray(speed_);
+    writer.WriteArray(hp_);
+    writer.WriteArray(type_);
+}
+
+bool SurvivalEnemyBatch::LoadState(SnapshotReader& reader, std::vector<SurvivalEnemy*>& released) {
+    reader.ReadArray(target_);
+    reader.ReadArray(posX_);
+    reader.ReadArray(posY_);
+    reader.ReadArray(knockVelX_);
+    reader.ReadArray(knockVelY_);
+    reader.ReadArray(knockTimer_);
+    reader.ReadArray(invincibleTimer_);
+    reader.ReadArray(radius_);
+    reader.ReadArray(speed_);
+    reader.ReadArray(hp_);
+    reader.ReadArray(type_);
+
+    // 配列どうしの数が揃っていれば、オブジェクトの並びを保存時の数・種類に合わせる
+    const size_t savedCount = posX_.size();
+    const bool isConsistent = target_.size() == savedCount && posY_.size() == savedCount &&
+        knockVelX_.size() == savedCount && knockVelY_.size() == savedCount && knockTimer_.size() == savedCount &&
+        invincibleTimer_.size() == savedCount && radius_.size() == savedCount && speed_.size() == savedCount &&
+        hp_.size() == savedCount && type_.size() == savedCount;
+    if (reader.IsOk() && isConsistent) {
+        for (size_t i = 0; i < objects_.size(); ++i) {
+            SurvivalEnemy* enemy = objects_[i];
+            if (i < savedCount && enemy->type_ == type_[i]) {
+                continue;
+            }
+            enemy->batch_ = nullptr;
+            released.push_back(enemy);
+            objects_[i] = nullptr;
+        }
+        objects_.resize(savedCount, nullptr);
+        return true;
+    }
+
+    // どれか1つでも数が合わなければ、今いる敵を Add した時の初期値に揃え直して失敗を返す
+    const size_t count = objects_.size();
+
+    target_.assign(count, ObjectHandle{});
+    posX_.assign(count, 0.0f);
+    posY_.assign(count, 0.0f);
+    knockVelX_.assign(count, 0.0f);
+    knockVelY_.assign(count, 0.0f);
+    knockTimer_.assign(count, 0.0f);
+    invincibleTimer_.assign(count, 0.0f);
+    radius_.resize(count);
+    speed_.resize(count);
+    hp_.resize(count);
+    type_.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        const EnemyTypeParams& params = GetEnemyTypeParams(objects_[i]->GetType());
+        radius_[i] = params.radius;
+        speed_[i] = params.speed;
+        hp_[i] = params.hp;
+        type_[i] = objects_[i]->GetType();
+    }
+    return false;
+}
+
+void SurvivalEnemyBatch::BindObject(size_t index, SurvivalEnemy* enemy) {
+    enemy->batch_ = this;
+    enemy->batchIndex_ = index;
+    objects_[index] = enemy;
+}
+
+void SurvivalEnemyBatch::SyncObjects() {
+    for (size_t i = 0; i < objects_.size(); ++i) {
+        SurvivalEnemy* enemy = objects_[i];
+        enemy->batchIndex_ = i;
+        enemy->ApplyBatchState({ posX_[i], posY_[i] }, knockTimer_[i] > 0.0f, 0.0f);
+
+        // 戻した位置から補間を始める（戻す前の位置から滑らせない）
+        enemy->SavePreviousTransform();
+    }
+}
+
+void SurvivalEnemyBatch::RemoveAt(size_t index) {
+    objects_[index]->batch_ = nullptr;
+
+    // 末尾の敵を空いた番号へ移す
+    if (index + 1 < objects_.size()) {
+        objects_.back()->batchIndex_ = index;
+    }
+
+    SwapAndPop(objects_, index);
+    SwapAndPop(target_, index);
+    SwapAndPop(posX_, index);
+    SwapAndPop(posY_, index);
+    SwapAndPop(knockVelX_, index);
+    SwapAndPop(knockVelY_, index);
+    SwapAndPop(knockTimer_, index);
+    SwapAndPop(invincibleTimer_, index);
+    SwapAndPop(radius_, index);
+    SwapAndPop(speed_, index);
+    SwapAndPop(hp_, index);
+    SwapAndPop(type_, index);
+}
+
+void SurvivalEnemyBatch::Clear() {
+    for (SurvivalEnemy* enemy : objects_) {
+        enemy->batch_ = nullptr;
+    }
+    objects_.clear();
+    target_.clear();
+    posX_.clear();
+    posY_.clear();
+    knockVelX_.clear();
+    knockVelY_.clear();
+    knockTimer_.clear();
+    invincibleTimer_.clear();
+    radius_.clear();
+    speed_.clear();
+    hp_.clear();
+    type_.clear();
+}
+
+void SurvivalEnemyBatch::Reserve(size_t count) {
+    objects_.reserve(count);
+    target_.reserve(count);
+    posX_.reserve(count);
+    posY_.reserve(count);
+    knockVelX_.reserve(count);
+    knockVelY_.reserve(count);
+    knockTimer_.reserve(count);
+    invincibleTimer_.reserve(count);
+    radius_.reserve(count);
+    speed_.reserve(count);
+    hp_.reserve(count);
+    type_.reserve(count);
+}
+
+bool SurvivalEnemyBatch::ApplyHit(size_t index, int damage, const Vector2& knockbackDir, float knockbackPower) {
+    // 無敵時間中はスキップ（ただし多段ヒット防止用なので極短）
+    if (invincibleTimer_[index] > 0.0f) return false;
+
+    hp_[index] -= damage;
+
+    // ノックバック適用（強い攻撃ほど長く飛ぶ）
+    knockVelX_[index] = knockbackDir.x * knockbackPower;
+    knockVelY_[index] = knockbackDir.y * knockbackPower;
+    knockTimer_[index] = 0.2f + (knockbackPower / 2000.0f);
+    return true;
+}
+
+void SurvivalEnemyBatch::SetPosition(size_t index, const Vector2& position) {
+    posX_[index] = position.x;
+    posY_[index] = position.y;
+}
+
+void SurvivalEnemyBatch::Simulate(float deltaTime, const float* separationX, const float* separationY, const HandleTable& handles) {
+    const size_t count = objects_.size();
+    if (count == 0) return;
+
+    GatherTargets(handles);
+    Integrate(0, count, deltaTime, separationX, separationY);
+
+    // 結果を描画側へ反映
+    for (size_t i = 0; i < count; ++i) {
+        objects_[i]->ApplyBatchState({ posX_[i], posY_[i] }, knockTimer_[i] > 0.0f, deltaTime);
+    }
+}
+
+void SurvivalEnemyBatch::GatherTargets(const HandleTable& handles) {
+    const size_t count = objects_.size();
+    targetX_.resize(count);
+    targetY_.resize(count);
+    hasTarget_.resize(count);
+
+    // 追尾対象はほぼ全員同じなので、直前と同じハンドルなら引き直さない
+    ObjectHandle cachedHandle;
+    Vector2 cachedPos = { 0.0f, 0.0f };
+    float cachedHasTarget = 0.0f;
+    bool isCached = false;
+
+    for (size_t i = 0; i < count; ++i) {
+        if (!isCached || target_[i] != cachedHandle) {
+            cachedHandle = target_[i];
+            const GameObject2D* target = handles.Resolve(cachedHandle);
+            cachedHasTarget = target ? 1.0f : 0.0f;
+            cachedPos = target ? target->GetPosition() : Vector2{ 0.0f, 0.0f };
+            isCached = true;
+        }
+        targetX_[i] = cachedPos.x;
+        targetY_[i] = cachedPos.y;
+        hasTarget_[i] = cachedHasTarget;
+    }
+}
+
+void SurvivalEnemyBatch::Integrate(size_t begin, size_t end, float deltaTime, const float* separationX, const float* separationY) {
+    size_t i = begin;
+
+#ifdef SURVIVAL_ENEMY_USE_SSE
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 threeHalves = _mm_set1_ps(1.5f);
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    const __m128 friction = _mm_set1_ps(kKnockbackFriction);
+    const __m128 separationScale = _mm_set1_ps(kSeparationScale);
+
+    for (; i + 4 <= end; i += 4) {
+        __m128 px = _mm_loadu_ps(&posX_[i]);
+        __m128 py = _mm_loadu_ps(&posY_[i]);
+        __m128 kvx = _mm_loadu_ps(&knockVelX_[i]);
+        __m128 kvy = _mm_loadu_ps(&knockVelY_[i]);
+        __m128 kt = _mm_loadu_ps(&knockTimer_[i]);
+
+        // 無敵時間
+        const __m128 it = _mm_max_ps(_mm_sub_ps(_mm_loadu_ps(&invincibleTimer_[i]), dt), zero);
+        _mm_storeu_ps(&invincibleTimer_[i], it);
+
+        // --- ノックバック中：速度で飛ばして減速 ---
+        const __m128 isKnocked = _mm_cmpgt_ps(kt, zero);
+        const __m128 knockX = _mm_add_ps(px, _mm_mul_ps(kvx, dt));
+        const __m128 knockY = _mm_add_ps(py, _mm_mul_ps(kvy, dt));
+        kvx = Select(isKnocked, _mm_mul_ps(kvx, friction), kvx);
+        kvy = Select(isKnocked, _mm_mul_ps(kvy, friction), kvy);
+        kt = Select(isKnocked, _mm_sub_ps(kt, dt), kt);
+
+        // --- 通常：対象へ向かう（逆平方根で正規化。1回のニュートン法で精度を上げる） ---
+        const __m128 dx = _mm_sub_ps(_mm_loadu_ps(&targetX_[i]), px);
+        const __m128 dy = _mm_sub_ps(_mm_loadu_ps(&targetY_[i]), py);
+        const __m128 lengthSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        __m128 invLength = _mm_rsqrt_ps(lengthSq);
+        invLength = _mm_mul_ps(invLength,
+            _mm_sub_ps(threeHalves, _mm_mul_ps(_mm_mul_ps(half, lengthSq), _mm_mul_ps(invLength, invLength))));
+
+        // 1px以内なら止まる（0除算のレーンもここで落とす）
+        const __m128 isChasing = _mm_and_ps(_mm_cmpgt_ps(lengthSq, one),
+            _mm_cmpgt_ps(_mm_loadu_ps(&hasTarget_[i]), zero));
+        const __m128 step = _mm_mul_ps(_mm_loadu_ps(&speed_[i]), dt);
+        const __m128 chaseScale = _mm_mul_ps(step, invLength);
+        __m128 chaseX = _mm_add_ps(px, _mm_and_ps(isChasing, _mm_mul_ps(dx, chaseScale)));
+        __m128 chaseY = _mm_add_ps(py, _mm_and_ps(isChasing, _mm_mul_ps(dy, chaseScale)));
+
+        // 仲間と重ならないように押し離す
+        if (separationX && separationY) {
+            const __m128 separationStep = _mm_mul_ps(step, separationScale);
+            chaseX = _mm_add_ps(chaseX, _mm_mul_ps(_mm_loadu_ps(&separationX[i]), separationStep));
+            chaseY = _mm_add_ps(chaseY, _mm_mul_ps(_mm_loadu_ps(&separationY[i]), separationStep));
+        }
+
+        px = Select(isKnocked, knockX, chaseX);
+        py = Select(isKnocked, knockY, chaseY);
+
+        _mm_storeu_ps(&posX_[i], px);
+        _mm_storeu_ps(&posY_[i], py);
+        _mm_storeu_ps(&knockVelX_[i], kvx);
+        _mm_storeu_ps(&knockVelY_[i], kvy);
+        _mm_storeu_ps(&knockTimer_[i], kt);
+    }
+#endif
+
+    // 残り（SSEが使えない環境では全件）
+    for (; i < end; ++i) {
+        invincibleTimer_[i] = std::fmax(invincibleTimer_[i] - deltaTime, 0.0f);
+
+        if (knockTimer_[i] > 0.0f) {
+            knockTimer_[i] -= deltaTime;
+            posX_[i] += knockVelX_[i] * deltaTime;
+            posY_[i] += knockVelY_[i] * deltaTime;
+            knockVelX_[i] *= kKnockbackFriction;
+            knockVelY_[i] *= kKnockbackFriction;
+            continue;
+        }
+
+        const float step = speed_[i] * deltaTime;
+        const float dx = targetX_[i] - posX_[i];
+        const float dy = targetY_[i] - posY_[i];
+        const float lengthSq = dx * dx + dy * dy;
+        if (hasTarget_[i] > 0.0f && lengthSq > 1.0f) {
+            const float scale = step / std::sqrt(lengthSq);
+            posX_[i] += dx * scale;
+            posY_[i] += dy * scale;
+        }
+
+        if (separationX && separationY) {
+            posX_[i] += separationX[i] * step * kSeparationScale;
+            posY_[i] += separationY[i] * step * kSeparationScale;
+        }
+    }
+}
@@ -0,0 +1,129 @@
+﻿#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "Vector2.h"
+#include "ObjectHandle.h"
+
+class SurvivalEnemy; // 前方宣言
+class SnapshotWriter;
+class SnapshotReader;
+
+// 敵の種類（kEnemyTypeParams の並び順）
+enum class EnemyType : uint8_t { Normal, Tank, Count };
+
+// 敵の種類ごとの定数
+struct EnemyTypeParams {
+    int hp;
+    float radius;
+    float speed;        // 追尾速度（px/s）
+    unsigned int color; // 通常時の色（ノックバック中は白）
+    int experience;     // 倒したときに落とす宝石の価値
+};
+
+// 種類ごとの定数表（分岐の代わりに種類で引く）
+inline constexpr EnemyTypeParams kEnemyTypeParams[static_cast<size_t>(EnemyType::Count)] = {
+    { 2, 12.0f, 100.0f, 0xFF4444FF, 1 }, // Normal：明るい赤
+    { 15, 24.0f, 40.0f, 0x882222FF, 5 }, // Tank：濃い赤
+};
+
+inline const EnemyTypeParams& GetEnemyTypeParams(EnemyType type) {
+    return kEnemyTypeParams[static_cast<size_t>(type)];
+}
+
+/// <summary>
+/// サバイバルの敵をまとめて動かすクラス
+/// 位置・ノックバック・HP・タイマーを種類ごとの配列（SoA）で持ち、4体ずつSIMDで移動を計算する
+/// SurvivalEnemy は描画と当たり判定の窓口で、状態の実体はこちらにある
+/// 要素の番号は GetObjects() の並びと一致する（削除は末尾と入れ替え）
+/// </summary>
+class SurvivalEnemyBatch {
+public:
+    SurvivalEnemyBatch() = default;
+    ~SurvivalEnemyBatch() = default;
+
+    SurvivalEnemyBatch(const SurvivalEnemyBatch&) = delete;
+    SurvivalEnemyBatch& operator=(const SurvivalEnemyBatch&) = delete;
+
+    /// <summary>
+    /// 敵を追加する（種類の定数表からHP・半径・速度を設定）
+    /// </summary>
+    void Add(SurvivalEnemy* enemy, const Vector2& position, EnemyType type, ObjectHandle target);
+
+    /// <summary>
+    /// 末尾の要素と入れ替えて取り除く（オブジェクトの破棄は呼び出し側で行う）
+    /// </summary>
+    void RemoveAt(size_t index);
+
+    void Clear();
+    void Reserve(size_t count);
+    size_t Size() const { return objects_.size(); }
+
+    /// <summary>
+    /// 全員の状態（位置・ノックバック・HP・タイマー・追尾対象）を保存する
+    /// </summary>
+    void SaveState(SnapshotWriter& writer) const;
+
+    /// <summary>
+    /// 保存した配列をそのまま書き戻す（敵を1体ずつ作り直さない）
+    /// 同じ番号に同じ種類の敵がいればそのオブジェクトを使い続け、合わない・余ったものは外して released に入れる
+    /// 空いた番号（GetObjects() が nullptr）は呼び出し側が BindObject で埋め、最後に SyncObjects を呼ぶこと
+    /// </summary>
+    /// <param name="released">外した敵（プールへ返すのは呼び出し側）</param>
+    /// <returns>配列の数が揃っていて戻せたか（失敗時は今いる敵の初期値に揃え直す）</returns>
+    bool LoadState(SnapshotReader& reader, std::vector<SurvivalEnemy*>& released);
+
+    // LoadState で空いた番号に敵を結び付ける（種類は GetType(index) に合わせて作ること）
+    void BindObject(size_t index, SurvivalEnemy* enemy);
+
+    // 配列の位置・ノックバックを各 SurvivalEnemy へ反映し、描画補間の始点も合わせる（LoadState の後に呼ぶ）
+    void SyncObjects();
+
+    /// <summary>
+    /// 全員を1ステップ動かし、結果を各 SurvivalEnemy へ反映する
+    /// </summary>
+    /// <param name="deltaTime">経過時間</param>
+    /// <param name="separationX">分離ステアリングX（要素ごと。nullptrなら無し）</param>
+    /// <param name="separationY">分離ステアリングY（要素ごと。nullptrなら無し）</param>
+    /// <param name="handles">追尾対象を引くハンドル表</param>
+    void Simulate(float deltaTime, const float* separationX, const float* separationY, const HandleTable& handles);
+
+    // --- 1体ずつの操作（SurvivalEnemy から呼ぶ） ---
+
+    // 被弾を適用する（無敵時間中なら何もせず false）
+    bool ApplyHit(size_t index, int damage, const Vector2& knockbackDir, float knockbackPower);
+    void SetPosition(size_t index, const Vector2& position);
+
+    int GetHp(size_t index) const { return hp_[index]; }
+    EnemyType GetType(size_t index) const { return type_[index]; }
+    bool IsInvincible(size_t index) const { return invincibleTimer_[index] > 0.0f; }
+
+    // --- まとめて読む（分離・衝突判定用） ---
+    const float* GetPositionX() const { return posX_.data(); }
+    const float* GetPositionY() const { return posY_.data(); }
+    const float* GetRadius() const { return radius_.data(); }
+    const std::vector<SurvivalEnemy*>& GetObjects() const { return objects_; }
+
+private:
+    // ノックバック中の速度の減衰（1ステップあたり）と、分離ステアリングの強さ（追尾速度に対する倍率）
+    static constexpr float kKnockbackFriction = 0.9f;
+    static constexpr float kSeparationScale = 1.5f;
+
+    std::vector<SurvivalEnemy*> objects_;
+    std::vector<ObjectHandle> target_;
+
+    std::vector<float> posX_, posY_;
+    std::vector<float> knockVelX_, knockVelY_;
+    std::vector<float> knockTimer_;      // ノックバックの残り時間
+    std::vector<float> invincibleTimer_; // 多段ヒット防止の残り時間
+    std::vector<float> radius_;
+    std::vector<float> speed_;
+    std::vector<int> hp_;
+    std::vector<EnemyType> type_;
+
+    // Simulateの作業領域（追尾対象の位置。対象がいなければ hasTarget_ が0）
+    std::vector<float> targetX_, targetY_, hasTarget_;
+
+    void GatherTargets(const HandleTable& handles);
+    void Integrate(size_t begin, size_t end, float deltaTime, const float* separationX, const float* separationY);
+};
@@ -1,63 +1,250 @@
 ﻿#include "SurvivalGameManager.h"
 #include "SurvivalObjects.h" // 各クラスの定義が必要
 #include "Vector2.h"
+#include "WorldSnapshot.h"
+#include <chrono>
 
 SurvivalGameObjectManager::SurvivalGameObjectManager() {}
 SurvivalGameObjectManager::~SurvivalGameObjectManager() { Clear(); }
 
-void SurvivalGameObjectManager::AddObject(const std::shared_ptr<GameObject2D>& obj, const std::string& tag) {
-    assert(obj && "AddObject: obj is null");
-    assert(!tag.empty() && "AddObject: tag must not be empty");
+void SurvivalGameObjectManager::Register(GameObject2D* obj, TagId tag, bool usePhysics) {
+    assert(obj && "Register: obj is null");
 
     obj->GetInfo().tag = tag;
 
     // プロト用：テクスチャ未設定でも描画できるように white を当てる
     obj->SetTexture(TextureId::White1x1);
 
-    objects_.push_back(obj);
+    obj->SetHandle(&handles_, handles_.Register(obj));
 
-    if (auto enemy = std::dynamic_pointer_cast<SurvivalEnemy>(obj)) {
-        enemies_.push_back(enemy);
+    if (usePhysics) {
+        physicsWorld_.AddBody(obj);
     }
+    drawList_.Add(obj);
+}
+
+SurvivalPlayer* SurvivalGameObjectManager::CreatePlayer(InputManager* input) {
+    if (player_) return player_;
+
+    static const TagId kTag = InternTag("Player");
+    player_ = playerPool_.Create(this, input);
+    Register(player_, kTag);
+    return player_;
+}
+
+DebrisController* SurvivalGameObjectManager::CreateDebrisController(InputManager* input, ObjectHandle anchor, int pieceCount) {
+    if (debrisController_) return debrisController_;
+
+    // がれき片はコンストラクタ内で生成されるので、その後に登録する（更新順は変わらない）
+    static const TagId kTag = InternTag("DebrisController");
+    debrisController_ = debrisControllerPool_.Create(this, input, anchor, pieceCount);
+    Register(debrisController_, kTag);
+    return debrisController_;
+}
+
+SurvivalEnemy* SurvivalGameObjectManager::CreateEnemy(const Vector2& startPos, EnemyType type, ObjectHandle target) {
+    SurvivalEnemy* enemy = CreateEnemyObject(startPos, type);
+    enemyBatch_.Add(enemy, startPos, type, target);
+    return enemy;
+}
+
+SurvivalEnemy* SurvivalGameObjectManager::CreateEnemyObject(const Vector2& startPos, EnemyType type) {
+    static const TagId kTag = InternTag("Enemy");
+    SurvivalEnemy* enemy = enemyPool_.Create(startPos, type);
+    // 移動はバッチが行うので物理には入れない
+    Register(enemy, kTag, false);
+    return enemy;
+}
+
+DebrisPiece* SurvivalGameObjectManager::CreateDebrisPiece() {
+    static const TagId kTag = InternTag("DebrisPiece");
+    DebrisPiece* piece = debrisPiecePool_.Create();
+    // 移動は管理者の輪が行うので物理には入れない
+    Register(piece, kTag, false);
+    debrisPieces_.push_back(piece);
+    return piece;
 }
 
 void SurvivalGameObjectManager::Clear() {
-    objects_.clear();
-    enemies_.clear();
-    player_.reset();
-    debrisController_.reset();
+    // 参照しているものから先に外してからプールへ返す
+    drawList_.Clear();
+    physicsWorld_.Clear();
+    handles_.Clear();
+
+    for (SurvivalEnemy* enemy : enemyBatch_.GetObjects()) enemyPool_.Destroy(enemy);
+    for (DebrisPiece* piece : debrisPieces_) debrisPiecePool_.Destroy(piece);
+    enemyBatch_.Clear();
+    debrisPieces_.clear();
+    pickups_.Clear();
+    damagePopups_.Clear();
+    projectiles_.Clear();
+    projectileHits_.clear();
+
+    if (debrisController_) {
+        debrisControllerPool_.Destroy(debrisController_);
+        debrisController_ = nullptr;
+    }
+    if (player_) {
+        playerPool_.Destroy(player_);
+        player_ = nullptr;
+    }
+}
+
+void SurvivalGameObjectManager::SaveState(SnapshotWriter& writer) const {
+    writer.Write(player_ != nullptr);
+    if (player_) player_->SaveState(writer);
+
+    writer.Write(debrisController_ != nullptr);
+    if (debrisController_) debrisController_->SaveState(writer);
+
+    // 敵の状態の実体はバッチの配列だけ（種類も配列に入っている）
+    enemyBatch_.SaveState(writer);
+
+    pickups_.SaveState(writer);
+    projectiles_.SaveState(writer);
+}
+
+bool SurvivalGameObjectManager::LoadState(SnapshotReader& reader, std::vector<SurvivalEnemy*>* createdEnemies) {
+    bool hasPlayer = false;
+    reader.Read(hasPlayer);
+    if (hasPlayer != (player_ != nullptr)) return false;
+    if (player_) player_->LoadState(reader);
+
+    bool hasDebrisController = false;
+    reader.Read(hasDebrisController);
+    if (hasDebrisController != (debrisController_ != nullptr)) return false;
+    if (debrisController_) debrisController_->LoadState(reader);
+
+    // 敵は配列をそのまま書き戻し、種類が合わなくなった・余った敵だけプールへ返す
+    releasedEnemies_.clear();
+    const bool isEnemyRestored = enemyBatch_.LoadState(reader, releasedEnemies_);
+    for (SurvivalEnemy* enemy : releasedEnemies_) Release(enemy, enemyPool_);
+    if (!isEnemyRestored) return false;
+
+    // 空いた番号にだけ敵を作る（位置などは下の SyncObjects で配列から入る）
+    const std::vector<SurvivalEnemy*>& enemies = enemyBatch_.GetObjects();
+    for (size_t i = 0; i < enemies.size(); ++i) {
+        if (enemies[i]) continue;
+        SurvivalEnemy* enemy = CreateEnemyObject({ 0.0f, 0.0f }, enemyBatch_.GetType(i));
+        enemyBatch_.BindObject(i, enemy);
+        if (createdEnemies) createdEnemies->push_back(enemy);
+    }
+    enemyBatch_.SyncObjects();
+
+    pickups_.LoadState(reader);
+    projectiles_.LoadState(reader);
+
+    // 数字は見た目だけなので保存せず、戻した時は消す
+    damagePopups_.Clear();
+    return reader.IsOk();
 }
 
 void SurvivalGameObjectManager::Update(float deltaTime) {
-    // 1. 全オブジェクト更新
-    auto it = objects_.begin();
-    while (it != objects_.end()) {
-        (*it)->Update(deltaTime);
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point updateStart = Clock::now();
 
-        if (!(*it)->GetInfo().isActive) {
-            it = objects_.erase(it);
-            continue;
-        }
+    // 描画補間用に、このステップ開始時のTransformを保存
+    ForEachObject([](GameObject2D& obj) { obj.SavePreviousTransform(); });
+
+    // 敵同士の押し離し（全員が同じ時点の位置を見るように、更新より先にまとめて計算）
+    UpdateSeparation();
 
-        ++it;
+    // 1. 全オブジェクト更新（がれきは管理者の中で、敵は配列のまま一括で動かす）
+    ForEachIndividualObject([deltaTime](GameObject2D& obj) { obj.Update(deltaTime); });
+    enemyBatch_.Simulate(deltaTime, crowdSeparation_.GetSteerXData(), crowdSeparation_.GetSteerYData(), handles_);
+
+    // 弾は動いた後の敵に当てる（倒した敵は下の削除で宝石を落とす）
+    UpdateProjectiles(deltaTime);
+
+    // 非アクティブになったものを取り除く
+    RemoveInactiveEnemies();
+    RemoveInactive(debrisPieces_, debrisPiecePool_);
+    if (debrisController_ && !debrisController_->GetInfo().isActive) {
+        Release(debrisController_, debrisControllerPool_);
+        debrisController_ = nullptr;
+    }
+    if (player_ && !player_->GetInfo().isActive) {
+        Release(player_, playerPool_);
+        player_ = nullptr;
     }
 
-    // 死んだ敵をenemies_リストからも削除
-    enemies_.remove_if([](const std::shared_ptr<SurvivalEnemy>& e) {
-        if (e->GetInfo().isActive == false) {
-            e->Destroy();
-            return true;
-        }
-        return false;
-        });
+    // 宝石の吸い寄せと回収
+    UpdatePickups(deltaTime);
+
+    // ダメージ数字を動かす（このステップの衝突で出たものは次のステップから動く）
+    damagePopups_.Update(deltaTime);
+
+    // 物理挙動の一括計算
+    physicsWorld_.Step(deltaTime, nullptr);
+
+    const Clock::time_point collisionStart = Clock::now();
 
     // 2. 衝突判定
     CheckCollisions();
+
+    const Clock::time_point updateEnd = Clock::now();
+    frameProfile_.updateMs = std::chrono::duration<double, std::milli>(collisionStart - updateStart).count();
+    frameProfile_.collisionMs = std::chrono::duration<double, std::milli>(updateEnd - collisionStart).count();
 }
 
 void SurvivalGameObjectManager::Draw(const Camera2D& camera) {
-    for (auto& obj : objects_) {
-        obj->Draw(camera);
+    // 宝石は地面に落ちているものなので一番奥にまとめて描く
+    pickups_.Draw(camera);
+    drawList_.Draw(camera);
+
+    // 弾はオブジェクトの手前にまとめて描く
+    projectiles_.Draw(camera);
+
+    // ダメージ数字は全オブジェクトの手前
+    damagePopups_.Draw(camera);
+}
+
+void SurvivalGameObjectManager::UpdateProjectiles(float deltaTime) {
+    projectiles_.Step(deltaTime, enemyBatch_.GetPositionX(), enemyBatch_.GetPositionY(),
+        enemyBatch_.GetRadius(), enemyBatch_.Size(), projectileHits_);
+
+    for (const ProjectileHit& hit : projectileHits_) {
+        SurvivalEnemy* enemy = enemyBatch_.GetObjects()[hit.target];
+        // 同じステップで先に倒れた敵や無敵時間中の敵には、弾は消えるがダメージは入らない
+        if (!enemy->GetInfo().isActive) continue;
+
+        if (enemy->OnHit(hit.damage, hit.direction, kShotKnockbackPower)) {
+            const Vector2 enemyPos = { enemyBatch_.GetPositionX()[hit.target], enemyBatch_.GetPositionY()[hit.target] };
+            damagePopups_.Spawn(enemyPos, hit.damage, false);
+        }
+    }
+}
+
+void SurvivalGameObjectManager::UpdatePickups(float deltaTime) {
+    if (!player_) {
+        pickups_.Update(deltaTime, nullptr, 0.0f, 0.0f);
+        return;
+    }
+
+    const Vector2 playerPos = player_->GetPosition();
+    pickups_.Update(deltaTime, &playerPos, player_->GetMagnetRadius(), player_->GetRadius());
+    player_->AddExperience(pickups_.TakeCollectedValue());
+}
+
+void SurvivalGameObjectManager::UpdateSeparation() {
+    crowdSeparation_.Compute(enemyBatch_.GetPositionX(), enemyBatch_.GetPositionY(),
+        enemyBatch_.GetRadius(), enemyBatch_.Size());
+}
+
+void SurvivalGameObjectManager::RemoveInactiveEnemies() {
+    size_t i = 0;
+    while (i < enemyBatch_.Size()) {
+        SurvivalEnemy* enemy = enemyBatch_.GetObjects()[i];
+        if (enemy->GetInfo().isActive) {
+            ++i;
+            continue;
+        }
+        // 倒された位置に宝石を落とす
+        const Vector2 dropPos = { enemyBatch_.GetPositionX()[i], enemyBatch_.GetPositionY()[i] };
+        pickups_.Drop(dropPos, GetEnemyTypeParams(enemy->GetType()).experience);
+
+        enemyBatch_.RemoveAt(i);
+        Release(enemy, enemyPool_);
     }
 }
 
@@ -72,66 +259,73 @@ void SurvivalGameObjectManager::CheckCollisions() {
     //bool isDefense = debrisController_->IsExpanding();
     bool isCritical = debrisController_->IsCritical();
 
+    constexpr float kDebrisRadius = 6.0f; // がれき片の半径
+
+    // がれき片の位置（慣性適用後の座標）は管理者の輪の配列から直接読んでセル分けする
+    // セルの一辺は「一番大きい敵の半径 + がれき片の半径」。これより近い組は必ず隣り合うセルに入る
+    const DebrisRing& ring = debrisController_->GetRing();
+    const size_t debrisCount = ring.Size();
+    const float* debrisX = ring.GetPositionX();
+    const float* debrisY = ring.GetPositionY();
+
+    // 敵の位置と半径はバッチの配列から直接読む
+    const size_t enemyCount = enemyBatch_.Size();
+    const float* enemyX = enemyBatch_.GetPositionX();
+    const float* enemyY = enemyBatch_.GetPositionY();
+    const float* enemyRadii = enemyBatch_.GetRadius();
+
+    float maxEnemyRadius = 0.0f;
+    for (size_t i = 0; i < enemyCount; ++i) {
+        if (enemyRadii[i] > maxEnemyRadius) maxEnemyRadius = enemyRadii[i];
+    }
+    debrisGrid_.Build(debrisX, debrisY, debrisCount, maxEnemyRadius + kDebrisRadius);
+
     // A. 敵 vs プレイヤー & デブリ
-    for (auto& enemy : enemies_) {
+    for (size_t enemyIndex = 0; enemyIndex < enemyCount; ++enemyIndex) {
+        SurvivalEnemy* enemy = enemyBatch_.GetObjects()[enemyIndex];
         // 死んでる敵は無視（※実装次第）
         // if (!enemy->IsAlive()) continue;
 
-        Vector2 enemyPos = enemy->GetPosition();
-        float enemyRadius = enemy->GetRadius();
+        // 判定中に押し出されても、この敵の判定は判定開始時の位置で行う
+        Vector2 enemyPos = { enemyX[enemyIndex], enemyY[enemyIndex] };
+        float enemyRadius = enemyRadii[enemyIndex];
 
         // 1. 敵 vs プレイヤー（ゲームオーバー判定）
-        float distToPlayer = Vector2::Length(enemyPos - playerPos);
-        if (distToPlayer < playerRadius + enemyRadius) {
+        const Vector2 toPlayer = enemyPos - playerPos;
+        const float playerHitDist = playerRadius + enemyRadius;
+        if (Vector2::LengthSquared(toPlayer) < playerHitDist * playerHitDist) {
             player_->OnDamage();
             // プレイヤーを守るために少し弾く
-            enemy->OnHit(0, Vector2::Normalize(enemyPos - playerPos), 500.0f);
+            enemy->OnHit(0, Vector2::NormalizeFast(toPlayer), 500.0f);
         }
 
-        // 2. 敵 vs デブリ（総当たりは重いので、距離で簡易フィルタリングすべきだが、今回はプロトなので総当たり）
-        // DebrisControllerが持つ pieces_ にアクセスする手段が必要。
-        // ※SurvivalObjects.h の DebrisController に GetPieces() を追加するか、
-        // Managerが pieces を知っている必要がある。
-        // ここでは「SurvivalObjects.h」に追加したと仮定して GetPieces() を呼ぶか、
-        // あるいは objects_ の中から DebrisPiece を探す。
-        // 一番きれいなのは DebrisController が判定メソッドを持つことだが、今回はここでやる。
-
-        // 暫定：DebrisController はフレンドまたはアクセサ経由で pieces_ を公開してください。
-        // ここでは擬似コード的に書きます。
-        // const auto& pieces = debrisController_->GetPieces(); 
-        // というメソッドを作ってください！
-
-        // ↓ 仕方ないので objects_ から dynamic_cast で探す（重いが確実）
-        // 実際は DebrisController::GetPieces() を推奨
-
-        // ★修正案：前のコードで DebrisPiece も AddObject しているので、objects_ に混ざっています。
-        // objects_ループだと効率悪いので、Managerに debrisPieces_ リストも持たせるのがベスト。
-
-        // ここではロジックの意図を示すため、「Managerがデブリ片のリストを持っている」と仮定します。
-        // 実装時は AddObject で DebrisPiece だった場合に debrisPieces_ にもポインタを入れてください。
+        // 2. 敵 vs デブリ（周囲のセルにいるがれき片だけを候補にして、まとめて距離判定）
+        debrisCandidates_.clear();
+        debrisGrid_.QueryNeighbors(enemyPos.x, enemyPos.y, debrisCandidates_);
+        if (debrisCandidates_.empty()) continue;
 
-        for (auto& piece : debrisController_->GetPieces()) {
-            Vector2 debrisPos = piece->GetActualPosition(); // 慣性適用後の座標
-            float debrisRadius = 6.0f; // 半径
+        const float debrisHitDist = enemyRadius + kDebrisRadius;
+        SpatialHashGrid::FilterWithinRadius(debrisX, debrisY, debrisCandidates_,
+            enemyPos.x, enemyPos.y, debrisHitDist * debrisHitDist, debrisHits_);
 
-            if (Vector2::Length(enemyPos - debrisPos) < enemyRadius + debrisRadius) {
-                // ヒット！
+        for (const uint32_t index : debrisHits_) {
+            // ヒット！
+            if (isAttacking) {
+                // 攻撃モード：ダメージ
+                int dmg = isCritical ? 5 : 1;
+                float power = isCritical ? 1200.0f : 400.0f;
+                Vector2 knockDir = Vector2::NormalizeFast(enemyPos - playerPos);
 
-                if (isAttacking) {
-                    // 攻撃モード：ダメージ
-                    int dmg = isCritical ? 5 : 1;
-                    float power = isCritical ? 1200.0f : 400.0f;
-                    Vector2 knockDir = Vector2::Normalize(enemyPos - playerPos);
-
-                    enemy->OnHit(dmg, knockDir, power);
-
-                } else {
-                    // 防御モード：押し出し（ダメージなし、あるいは微小）
-                    Vector2 pushDir = Vector2::Normalize(enemyPos - debrisPos);
-                    enemy->PushBack(pushDir, 5.0f); // グイッと押し出す
+                if (enemy->OnHit(dmg, knockDir, power)) {
+                    damagePopups_.Spawn(enemyPos, dmg, isCritical);
                 }
+
+            } else {
+                // 防御モード：押し出し（ダメージなし、あるいは微小）
+                const Vector2 debrisPos = { debrisX[index], debrisY[index] };
+                Vector2 pushDir = Vector2::NormalizeFast(enemyPos - debrisPos);
+                enemy->PushBack(pushDir, 5.0f); // グイッと押し出す
             }
         }
-        
     }
-}
\ No newline at end of file
+}
@@ -1,59 +1,228 @@
 ﻿#pragma once
-#include <list>
-#include <memory>
 #include <vector>
+#include <cstddef>
 #include "GameObject2D.h"
 #include "Camera2D.h"
+#include "PhysicsWorld.h"
+#include "DrawList.h"
+#include "ObjectHandle.h"
+#include "ObjectPool.h"
+#include "SurvivalObjects.h"
+#include "SpatialHashGrid.h"
+#include "CrowdSeparation.h"
+#include "SurvivalPickups.h"
+#include "DamagePopups.h"
+#include "ProjectileSystem.h"
 
-// 前方宣言
-class SurvivalPlayer;
-class DebrisController;
-class SurvivalEnemy;
+// 1回のUpdateの処理時間（ミリ秒。ベンチマーク・デバッグ表示用）
+struct SurvivalFrameProfile {
+    double updateMs = 0.0;    // 分離計算・全オブジェクト更新（敵・がれきは一括）・削除・宝石・物理
+    double collisionMs = 0.0; // CheckCollisions
+};
 
 /// <summary>
 /// サバイバルゲーム用オブジェクトマネージャー
+/// オブジェクトは種類ごとのプールに確保し、種類ごとの配列で詰めて持つ
+/// （削除は末尾と入れ替え。参照カウントやリストのノードを辿るコストを無くす）
 /// </summary>
 class SurvivalGameObjectManager {
 public:
     SurvivalGameObjectManager();
     ~SurvivalGameObjectManager();
 
+    SurvivalGameObjectManager(const SurvivalGameObjectManager&) = delete;
+    SurvivalGameObjectManager& operator=(const SurvivalGameObjectManager&) = delete;
+
     // 更新（全オブジェクトの更新と削除処理）
     void Update(float deltaTime);
 
-    // 描画（全オブジェクトの描画）
+    // 描画（描画順に並べ替え、カメラに映るものだけ描画）
     void Draw(const Camera2D& camera);
 
-    // オブジェクト登録
-    void AddObject(const std::shared_ptr<GameObject2D>& obj, const std::string& tag);
+    // 描画対象を集めるだけで描画命令は出さない（ウィンドウを使わない計測用。集めた分は次のDrawで上書きされる）
+    void PrepareDraw(const Camera2D& camera) { drawList_.Prepare(camera); }
+
+    // --- 生成（マネージャーが所有する。ポインタは削除されるまで有効） ---
+
+    // プレイヤーを生成する（既にいれば何もせず既存のものを返す）
+    SurvivalPlayer* CreatePlayer(InputManager* input);
+
+    // がれき管理者を生成する（既にいれば何もせず既存のものを返す）
+    DebrisController* CreateDebrisController(InputManager* input, ObjectHandle anchor,
+        int pieceCount = DebrisController::kDefaultPieceCount);
+
+    SurvivalEnemy* CreateEnemy(const Vector2& startPos, EnemyType type, ObjectHandle target);
+    DebrisPiece* CreateDebrisPiece();
 
     // 特定オブジェクトへのアクセサ（判定やカメラ制御で使用）
-    void SetPlayer(std::shared_ptr<SurvivalPlayer> player) { player_ = player; }
-    std::shared_ptr<SurvivalPlayer> GetPlayer() const { return player_; }
+    SurvivalPlayer* GetPlayer() const { return player_; }
+    DebrisController* GetDebrisController() const { return debrisController_; }
 
-    void SetDebrisController(std::shared_ptr<DebrisController> debris) { debrisController_ = debris; }
-    std::shared_ptr<DebrisController> GetDebrisController() const { return debrisController_; }
+    // ハンドルからオブジェクトを取得（破棄済みならnullptr）
+    GameObject2D* Resolve(ObjectHandle handle) const { return handles_.Resolve(handle); }
 
-    // 敵のリストを取得（デブリ側から参照するため）
-    const std::list<std::shared_ptr<SurvivalEnemy>>& GetEnemies() const { return enemies_; }
+    // 敵・がれきの一覧（並び順は削除のたびに変わる）
+    const std::vector<SurvivalEnemy*>& GetEnemies() const { return enemyBatch_.GetObjects(); }
+    const std::vector<DebrisPiece*>& GetDebrisPieces() const { return debrisPieces_; }
+
+    // 倒した敵が落とす宝石
+    SurvivalPickupManager& GetPickups() { return pickups_; }
+    const SurvivalPickupManager& GetPickups() const { return pickups_; }
+
+    // プレイヤーの弾（敵のバッチの配列に当てる）
+    ProjectileSystem& GetProjectiles() { return projectiles_; }
+    const ProjectileSystem& GetProjectiles() const { return projectiles_; }
+
+    // 敵に当たった時のダメージ数字（フォントはシーンから設定する）
+    DamagePopupManager& GetDamagePopups() { return damagePopups_; }
+    const DamagePopupManager& GetDamagePopups() const { return damagePopups_; }
+
+    // 敵のプールを先に確保しておく（大量発生時の初回確保を避ける）
+    void ReserveEnemies(size_t count) {
+        enemyPool_.Reserve(count);
+        enemyBatch_.Reserve(count);
+    }
 
     // 全消去（リセット用）
     void Clear();
 
+    /// <summary>
+    /// プレイヤー・がれき・敵・宝石の状態を保存する
+    /// </summary>
+    void SaveState(SnapshotWriter& writer) const;
+
+    /// <summary>
+    /// 保存した状態に戻す（プレイヤーとがれき管理者は今いるものへ書き戻す）
+    /// 敵は配列をバッチへそのまま書き戻し、同じ番号・同じ種類の敵オブジェクトは使い続ける（足りない分だけ作る）
+    /// 新しく作った敵の描画設定は生成時のものになるので、必要なら createdEnemies を見て呼び出し側で設定する
+    /// </summary>
+    /// <param name="createdEnemies">新しく作った敵（nullptrなら返さない）</param>
+    /// <returns>保存時とプレイヤー・管理者の有無が一致し、最後まで読めたか</returns>
+    bool LoadState(SnapshotReader& reader, std::vector<SurvivalEnemy*>* createdEnemies = nullptr);
+
+    // 直近フレームの描画状況
+    const DrawListStats& GetDrawStats() const { return drawList_.GetStats(); }
+
+    // 直近のUpdateの処理時間
+    const SurvivalFrameProfile& GetFrameProfile() const { return frameProfile_; }
+
     unsigned int GetObjectsSize() {
-        return static_cast<unsigned int>(objects_.size());
+        size_t count = enemyBatch_.Size() + debrisPieces_.size();
+        if (player_) ++count;
+        if (debrisController_) ++count;
+        return static_cast<unsigned int>(count);
     }
 
 private:
-    // 全オブジェクトリスト（所有権を持つ）
-    std::list<std::shared_ptr<GameObject2D>> objects_;
+    // 種類ごとのプール（要素より先に破棄されないよう先に宣言する）
+    ObjectPool<SurvivalPlayer, 1> playerPool_;
+    ObjectPool<DebrisController, 1> debrisControllerPool_;
+    ObjectPool<DebrisPiece, 64> debrisPiecePool_;
+    ObjectPool<SurvivalEnemy, 256> enemyPool_;
+
+    // 種類ごとの生きているオブジェクト
+    SurvivalPlayer* player_ = nullptr;
+    DebrisController* debrisController_ = nullptr;
+    std::vector<DebrisPiece*> debrisPieces_;
+
+    // 敵の状態（位置・HP・ノックバック）はまとめて配列で持ち、一括で動かす
+    SurvivalEnemyBatch enemyBatch_;
+
+    // ハンドル → オブジェクトの表（生成時に登録、削除時に解除）
+    HandleTable handles_;
+
+    // 全オブジェクトの物理挙動を一括計算する（マップなし）
+    PhysicsWorld physicsWorld_;
+
+    // 描画順に並べた一覧（前フレームの並びを使い回して差分だけ直す）
+    DrawList drawList_;
+
+    SurvivalFrameProfile frameProfile_;
 
-    // 参照用キャッシュ（objects_の中身を指す弱い参照）
-    // 毎回キャストして探すと重いため、分けて保持する
-    std::shared_ptr<SurvivalPlayer> player_;
-    std::shared_ptr<DebrisController> debrisController_;
-    std::list<std::shared_ptr<SurvivalEnemy>> enemies_;
+    // 衝突判定用（毎フレーム作り直す。配列は使い回して確保を避ける）
+    SpatialHashGrid debrisGrid_;
+    std::vector<uint32_t> debrisCandidates_;
+    std::vector<uint32_t> debrisHits_;
+
+    // 敵同士の押し離し（更新前の位置から計算し、結果をバッチの移動計算で使う）
+    CrowdSeparation crowdSeparation_;
+
+    // 経験値の宝石（倒した敵の位置に落とし、プレイヤーの磁石で回収する）
+    SurvivalPickupManager pickups_;
+
+    // 敵に当たった時のダメージ数字
+    DamagePopupManager damagePopups_;
+
+    // プレイヤーの弾と、このステップに当たった弾（配列は使い回す）
+    ProjectileSystem projectiles_;
+    std::vector<ProjectileHit> projectileHits_;
+
+    // 復元時にバッチから外れた敵（プールへ返すまでの作業用。配列は使い回す）
+    std::vector<SurvivalEnemy*> releasedEnemies_;
+
+    // 弾が敵に当たった時のノックバックの強さ
+    static constexpr float kShotKnockbackPower = 150.0f;
+
+    // 生成直後の共通登録（ハンドル・物理・描画）。usePhysics が false なら PhysicsWorld に入れない
+    void Register(GameObject2D* obj, TagId tag, bool usePhysics = true);
+
+    // 登録を解除してプールへ返す
+    template <typename T, size_t BlockSize>
+    void Release(T* obj, ObjectPool<T, BlockSize>& pool) {
+        physicsWorld_.RemoveBody(obj);
+        drawList_.Remove(obj);
+        handles_.Unregister(obj->GetHandle());
+        pool.Destroy(obj);
+    }
+
+    // 非アクティブになったものを末尾と入れ替えて取り除く
+    template <typename T, size_t BlockSize>
+    void RemoveInactive(std::vector<T*>& list, ObjectPool<T, BlockSize>& pool) {
+        size_t i = 0;
+        while (i < list.size()) {
+            T* obj = list[i];
+            if (obj->GetInfo().isActive) {
+                ++i;
+                continue;
+            }
+            list[i] = list.back();
+            list.pop_back();
+            Release(obj, pool);
+        }
+    }
+
+    // 全オブジェクトに func(GameObject2D&) を呼ぶ（順：プレイヤー → がれき → 管理者 → 敵）
+    template <typename Func>
+    void ForEachObject(Func&& func) {
+        if (player_) func(static_cast<GameObject2D&>(*player_));
+        for (DebrisPiece* piece : debrisPieces_) func(static_cast<GameObject2D&>(*piece));
+        if (debrisController_) func(static_cast<GameObject2D&>(*debrisController_));
+        for (SurvivalEnemy* enemy : enemyBatch_.GetObjects()) func(static_cast<GameObject2D&>(*enemy));
+    }
+
+    // 個別にUpdateするもの（プレイヤーと管理者）に func(GameObject2D&) を呼ぶ
+    // がれきは管理者が、敵はバッチがまとめて動かす
+    template <typename Func>
+    void ForEachIndividualObject(Func&& func) {
+        if (player_) func(static_cast<GameObject2D&>(*player_));
+        if (debrisController_) func(static_cast<GameObject2D&>(*debrisController_));
+    }
+
+    // 非アクティブになった（倒された）敵の位置に宝石を落とし、バッチから外してプールへ返す
+    void RemoveInactiveEnemies();
+
+    // 敵のオブジェクトをプールから作って登録する（バッチへの追加は呼び出し側）
+    SurvivalEnemy* CreateEnemyObject(const Vector2& startPos, EnemyType type);
+
+    // 弾を動かし、敵に当たった分のダメージを与える（敵の位置はバッチの配列をそのまま渡す）
+    void UpdateProjectiles(float deltaTime);
+
+    // 宝石の吸い寄せと回収（回収した分はプレイヤーの経験値になる）
+    void UpdatePickups(float deltaTime);
 
     // 衝突判定ロジック（内部で呼ぶ）
     void CheckCollisions();
-};
\ No newline at end of file
+
+    // 敵の分離ステアリングを計算する（バッチの移動より前に呼ぶ）
+    void UpdateSeparation();
+};
@@ -1,5 +1,6 @@
 ﻿#include "SurvivalObjects.h"
 #include "SurvivalGameManager.h" 
+#include "SceneUtilityIncludes.h"
 #include "Novice.h"
 #include "WindowSize.h"
 #include <cmath>
@@ -18,14 +19,15 @@ float NormalizeAngleObj(float angle) {
 // ==========================================
 // SurvivalPlayer (Core)
 // ==========================================
-SurvivalPlayer::SurvivalPlayer(InputManager* input) : input_(input) {
+SurvivalPlayer::SurvivalPlayer(SurvivalGameObjectManager* manager, InputManager* input)
+    : manager_(manager), input_(input) {
     // 描画コンポーネント設定
     //drawComp_ = AddComponent<DrawComponent2D>();
     // 画像未設定でも動くように白い矩形(white1x1)や塗りつぶしを想定
 
-    drawComp_->SetDrawSize(radius_ * 2.0f, radius_ * 2.0f);
-    drawComp_->SetAnchorPoint({ 0.5f, 0.5f });
-    drawComp_->SetBaseColor(0xAAAAFFFF); // 青白く光るコア
+    drawComp_.SetDrawSize(radius_ * 2.0f, radius_ * 2.0f);
+    drawComp_.SetAnchorPoint({ 0.5f, 0.5f });
+    drawComp_.SetBaseColor(0xAAAAFFFF); // 青白く光るコア
 
     // 初期位置
     transform_.translate = { kWindowWidth / 2.0f, kWindowHeight / 2.0f };
@@ -46,9 +48,10 @@ void SurvivalPlayer::Update(float dt) {
     }
 
     // 移動処理
-    if (Vector2::Length(moveDir) > 0.0f) {
+    if (Vector2::LengthSquared(moveDir) > 0.0f) {
         moveDir = Vector2::Normalize(moveDir);
         transform_.translate += moveDir * speed_ * dt;
+        aimDirection_ = moveDir;
     }
 
     // 画面外に出ないようにクランプ
@@ -59,189 +62,181 @@ void SurvivalPlayer::Update(float dt) {
     if (invincibilityTimer_ > 0.0f) {
         invincibilityTimer_ -= dt;
         if ((int)(invincibilityTimer_ * 20) % 2 == 0) {
-            drawComp_->SetBaseColor(0x8888FFFF);
+            drawComp_.SetBaseColor(0x8888FFFF);
         }
         else {
-            drawComp_->SetBaseColor(0xAAAAFFFF);
+            drawComp_.SetBaseColor(0xAAAAFFFF);
         }
     }
     else {
-        drawComp_->SetBaseColor(0xAAAAFFFF);
+        drawComp_.SetBaseColor(0xAAAAFFFF);
     }
 
+    // 射撃
+    Shoot(dt);
+
     // 親クラス更新（コンポーネント更新）
     GameObject2D::Update(dt);
 }
 
+void SurvivalPlayer::Shoot(float dt) {
+    shotCooldown_ = std::max(shotCooldown_ - dt, 0.0f);
+    if (!manager_) return;
+
+    // J / 左クリック / パッドのX で連射
+    const bool isShooting =
+        input_->PressKey(DIK_J) ||
+        input_->PressMouse(MouseButton::Left) ||
+        input_->GetPad()->Press(Pad::Button::X);
+    if (!isShooting || shotCooldown_ > 0.0f) return;
+
+    if (manager_->GetProjectiles().Fire(transform_.translate, aimDirection_ * kShotSpeed, kShotLifetime, kShotDamage)) {
+        Sound().PlaySe(SeId::PlayerShot);
+    }
+    shotCooldown_ = kShotInterval;
+}
+
 void SurvivalPlayer::OnDamage() {
     if (invincibilityTimer_ > 0.0f) return;
     hp_--;
     invincibilityTimer_ = 1.0f;
 
     // 被弾演出：激しくシェイク＆赤フラッシュ
-    drawComp_->StartShake(5.0f, 0.5f);
-    drawComp_->StartFlash({ 1.0f, 0.0f, 0.0f, 1.0f }, 0.2f);
+    drawComp_.StartShake(5.0f, 0.5f);
+    drawComp_.StartFlash({ 1.0f, 0.0f, 0.0f, 1.0f }, 0.2f);
+}
+
+void SurvivalPlayer::SaveState(SnapshotWriter& writer) const {
+    GameObject2D::SaveState(writer);
+    writer.Write(speed_);
+    writer.Write(radius_);
+    writer.Write(hp_);
+    writer.Write(invincibilityTimer_);
+    writer.Write(magnetRadius_);
+    writer.Write(experience_);
+    writer.Write(aimDirection_);
+    writer.Write(shotCooldown_);
+}
+
+void SurvivalPlayer::LoadState(SnapshotReader& reader) {
+    GameObject2D::LoadState(reader);
+    reader.Read(speed_);
+    reader.Read(radius_);
+    reader.Read(hp_);
+    reader.Read(invincibilityTimer_);
+    reader.Read(magnetRadius_);
+    reader.Read(experience_);
+    reader.Read(aimDirection_);
+    reader.Read(shotCooldown_);
 }
 
 // ==========================================
 // SurvivalEnemy
 // ==========================================
-SurvivalEnemy::SurvivalEnemy(Vector2 startPos, EnemyType type, std::shared_ptr<SurvivalPlayer> target)
-    : type_(type), target_(target) {
+SurvivalEnemy::SurvivalEnemy(Vector2 startPos, EnemyType type)
+    : type_(type) {
 
     transform_.translate = startPos;
 
-    // タイプ別のパラメータ設定
-    if (type_ == EnemyType::Tank) {
-        hp_ = 15;
-        radius_ = 24.0f;
-       // drawComp_ = AddComponent<DrawComponent2D>();
-        drawComp_->SetBaseColor(0x882222FF); // 濃い赤
-    }
-    else {
-        hp_ = 2;
-        radius_ = 12.0f;
-       // drawComp_ = AddComponent<DrawComponent2D>();
-        drawComp_->SetBaseColor(0xFF4444FF); // 明るい赤
-    }
-
-    drawComp_->SetDrawSize(radius_ * 2, radius_ * 2);
-    drawComp_->SetAnchorPoint({ 0.5f, 0.5f });
+    // タイプ別のパラメータは定数表から引く（HP・速度はバッチ側が持つ）
+    const EnemyTypeParams& params = GetEnemyTypeParams(type_);
+    drawComp_.SetBaseColor(params.color);
+    drawComp_.SetDrawSize(params.radius * 2, params.radius * 2);
+    drawComp_.SetAnchorPoint({ 0.5f, 0.5f });
 }
 
 void SurvivalEnemy::Update(float dt) {
-    if (isDead_) return;
+    GameObject2D::Update(dt);
+}
 
-    if (hitInvincibility_ > 0.0f) hitInvincibility_ -= dt;
+void SurvivalEnemy::ApplyBatchState(const Vector2& position, bool isKnockedBack, float dt) {
+    transform_.translate = position;
 
-    if (knockbackDuration_ > 0.0f) {
-        // --- ノックバック中 ---
-        knockbackDuration_ -= dt;
-        transform_.translate += knockbackVel_ * dt;
-        knockbackVel_ *= 0.9f; // 摩擦で減速
-        drawComp_->SetBaseColor(0xFFFFFFFF); // 白飛び演出
-    }
-    else {
-        // --- 通常AI（追尾） ---
-        drawComp_->SetBaseColor((type_ == EnemyType::Tank) ? 0x882222FF : 0xFF4444FF);
-
-        if (target_) {
-            Vector2 toPlayer = target_->GetPosition() - transform_.translate;
-            if (Vector2::Length(toPlayer) > 1.0f) {
-                Vector2 dir = Vector2::Normalize(toPlayer);
-                float speed = (type_ == EnemyType::Tank) ? 40.0f : 100.0f;
-                transform_.translate += dir * speed * dt;
-            }
-        }
+    // ノックバック中は白飛び演出（切り替わったときだけ色を変える）
+    if (isKnockedBack != isKnockedBack_) {
+        isKnockedBack_ = isKnockedBack;
+        drawComp_.SetBaseColor(isKnockedBack ? 0xFFFFFFFF : GetEnemyTypeParams(type_).color);
     }
 
-    GameObject2D::Update(dt);
+    // 描画用のTransformと行列はDrawで補間位置から作られる
+    drawComp_.Update(dt);
 }
 
-void SurvivalEnemy::OnHit(int damage, Vector2 knockbackDir, float knockbackPower) {
-    // 無敵時間中はスキップ（ただし多段ヒット防止用なので極短）
-    if (hitInvincibility_ > 0.0f) return;
-
-    hp_ -= damage;
-
-    // ノックバック適用
-    knockbackVel_ = knockbackDir * knockbackPower;
-    knockbackDuration_ = 0.2f + (knockbackPower / 2000.0f); // 強い攻撃ほど長く飛ぶ
+bool SurvivalEnemy::OnHit(int damage, Vector2 knockbackDir, float knockbackPower) {
+    if (!batch_ || !batch_->ApplyHit(batchIndex_, damage, knockbackDir, knockbackPower)) return false;
 
     // ヒット演出：つぶれるアニメーション
-    drawComp_->StartSquash({ 1.3f, 0.7f }, 0.1f);
+    drawComp_.StartSquash({ 1.3f, 0.7f }, 0.1f);
 
-    if (hp_ <= 0) {
+    if (batch_->GetHp(batchIndex_) <= 0) {
         isDead_ = true;
         GetInfo().isActive = false;
         // 死亡エフェクトがあればここで再生（ParticleManagerなどに依頼）
     }
+    return true;
 }
 
 void SurvivalEnemy::PushBack(Vector2 dir, float dist) {
     // 物理的に押し出される処理（ダメージなし）
     transform_.translate += dir * dist;
+    if (batch_) {
+        batch_->SetPosition(batchIndex_, transform_.translate);
+    }
 }
 
 // ==========================================
 // DebrisPiece (慣性を持つがれき)
 // ==========================================
-DebrisPiece::DebrisPiece(int index, int totalCount, std::shared_ptr<SurvivalPlayer> anchor)
-    : index_(index), totalCount_(totalCount), anchor_(anchor) {
-
-   // drawComp_ = AddComponent<DrawComponent2D>();
-    drawComp_->SetDrawSize(12.0f, 12.0f); // デフォルトサイズ
-    drawComp_->SetAnchorPoint({ 0.5f, 0.5f });
-
-    // 個体差の生成（ノイズ）
-    angleOffset_ = (float)index / (float)totalCount * 2.0f * PI;
-    distNoise_ = (float)(rand() % 40 - 20);
-    selfRotSpeed_ = (float)(rand() % 100 - 50) / 10.0f;
-}
-
-void DebrisPiece::SetStateInfo(float currentRadius, float rotationAngle, float expandSpeedScale) {
-	expandSpeedScale; // 未使用
-    // Controllerから毎フレーム呼ばれる「目標状態」の設定
-
-    // 目標とする位置（TargetPos）を計算
-    // 発散中ならspeedScale（速度ムラ）を適用して形を崩す
-    float r = currentRadius + distNoise_;
-
-    // 本来あるべき角度
-    float a = angleOffset_ + rotationAngle;
-
-    // アンカー（プレイヤー）中心からのオフセット
-    Vector2 offset = { cosf(a) * r, sinf(a) * r };
-
-    // 目標座標更新
-    targetPos_ = anchor_->GetPosition() + offset;
-
-    // 自転更新
-    currentSelfRot_ += selfRotSpeed_ * 0.016f; // dt簡易
-    drawComp_->SetRotation(a + currentSelfRot_);
-
-    // 色の更新
-    // ※実際はStateを見て変えたいが、ここでは簡易的に緑固定
-    // コントローラー側で一括設定しても良い
+DebrisPiece::DebrisPiece() {
+    drawComp_.SetDrawSize(12.0f, 12.0f); // デフォルトサイズ
+    drawComp_.SetAnchorPoint({ 0.5f, 0.5f });
 }
 
 void DebrisPiece::Update(float dt) {
-    // === 慣性変形のキモ ===
-    // targetPos_（本来あるべき円周上の点）に対して、
-    // transform_.translate（実際のがれき）を遅れて追従させる。
-
-    // 追従係数 (Lerp Factor)
-    // 1.0f なら遅れなし。小さいほどネバネバする。
-    // 発散・収縮中はキビキビ動いてほしいので係数を変えるなどの工夫も可
-    float lerpFactor = 10.0f * dt;
-
-    // 簡易Lerp
-    Vector2 diff = targetPos_ - transform_.translate;
-    transform_.translate += diff * lerpFactor;
-
-    // あまりに離れすぎたら強制ワープ（テレポート対策）
-    if (Vector2::Length(diff) > 500.0f) {
-        transform_.translate = targetPos_;
-    }
-
     GameObject2D::Update(dt);
 }
 
+void DebrisPiece::ApplyRingState(const Vector2& position, float dt) {
+    transform_.translate = position;
+    drawComp_.Update(dt);
+}
+
 // ==========================================
 // DebrisController (司令塔)
 // ==========================================
-DebrisController::DebrisController(SurvivalGameObjectManager* manager, InputManager* input, std::shared_ptr<SurvivalPlayer> anchor)
+DebrisController::DebrisController(SurvivalGameObjectManager* manager, InputManager* input, ObjectHandle anchor, int pieceCount)
     : manager_(manager), input_(input), anchor_(anchor) {
 
     currentRadius_ = minRadius_;
 
-    // 64個のがれきを生成してマネージャーに登録
-    int count = 64;
-    for (int i = 0; i < count; i++) {
-        auto piece = std::make_shared<DebrisPiece>(i, count, anchor);
+    // 指定数（通常64個）のがれきを生成してマネージャーに登録
+    SetPieceCount(pieceCount);
+}
+
+void DebrisController::SetPieceCount(int count) {
+    count = std::clamp(count, 0, kMaxPieceCount);
+
+    // 新しいがれきはアンカーの位置から広がる
+    const SurvivalPlayer* anchor = ResolveHandle<SurvivalPlayer>(anchor_);
+    const Vector2 startPos = anchor ? anchor->GetPosition() : transform_.translate;
+
+    pieces_.reserve(count);
+    ring_.Reserve(count);
+    while (static_cast<int>(pieces_.size()) < count) {
+        // 描画のためにマネージャーのプールに作ってもらう
+        DebrisPiece* piece = manager_->CreateDebrisPiece();
+        piece->SetPosition(startPos);
         pieces_.push_back(piece);
-        manager_->AddObject(piece, "DebrisPiece"); // 描画・更新のためにマネージャーへ渡す
+        ring_.Add(startPos);
+    }
+    while (static_cast<int>(pieces_.size()) > count) {
+        // 実際の削除はマネージャーの更新で行われる
+        pieces_.back()->GetInfo().isActive = false;
+        pieces_.pop_back();
+        ring_.RemoveLast();
     }
+
+    ring_.Redistribute(rotationAngle_);
 }
 
 void DebrisController::Update(float dt) {
@@ -253,7 +248,8 @@ void DebrisController::Update(float dt) {
 
     if (state_ == State::Contracting) currentRotationSpeed_ = 15.0f; // 攻撃中は超高速
 
-    rotationAngle_ += currentRotationSpeed_ * dt;
+    const float rotationDelta = currentRotationSpeed_ * dt;
+    rotationAngle_ += rotationDelta;
 
     // 入力
     bool isSpace = input_->PressKey(DIK_SPACE) || input_->GetPad()->Press(Pad::Button::A);
@@ -303,18 +299,59 @@ void DebrisController::Update(float dt) {
         break;
     }
 
-    // 子機（Pieces）に指令を出す
-    // 色の計算
-    unsigned int color = 0x00FF00FF; // Safe
-    if (state_ == State::Expanding) color = 0xFFFF00FF;
-    if (state_ == State::WaitMax) color = isCritical_ ? 0xFFFFFFFF : 0xFFFF00FF;
-    if (state_ == State::Contracting) color = 0xFF0000FF; // Attack
-
-    for (auto& p : pieces_) {
-        // 各ピースに目標位置を計算させる
-        // Expanding中は少しバラつきを持たせるためのScaleを渡すなどの拡張もここ
-        p->SetStateInfo(currentRadius_, rotationAngle_, 1.0f);
-      //  p->GetComponent<DrawComponent2D>()->SetBaseColor(color);
+    // 子機（Pieces）をまとめて動かす
+    // 前フレームの目標へ追従させてから、輪を回して次の目標を作る（アンカーが消えていたら目標は据え置き）
+    const SurvivalPlayer* anchor = ResolveHandle<SurvivalPlayer>(anchor_);
+    const Vector2 anchorPos = anchor ? anchor->GetPosition() : Vector2{ 0.0f, 0.0f };
+    ring_.Update(dt, anchor ? &anchorPos : nullptr, currentRadius_, rotationAngle_, rotationDelta);
+
+    for (size_t i = 0; i < pieces_.size(); ++i) {
+        pieces_[i]->ApplyRingState(ring_.GetPosition(i), dt);
+    }
+
+    // 色の計算（状態ごとに色分けする場合はここでまとめて設定する）
+    // Safe: 0x00FF00FF / Expanding: 0xFFFF00FF / WaitMax: 0xFFFFFFFF（チャージ完了） / Contracting: 0xFF0000FF
+}
+
+void DebrisController::SaveState(SnapshotWriter& writer) const {
+    GameObject2D::SaveState(writer);
+    writer.Write(currentRadius_);
+    writer.Write(rotationAngle_);
+    writer.Write(currentRotationSpeed_);
+    writer.Write(state_);
+    writer.Write(cooldownTimer_);
+    writer.Write(isCritical_);
+
+    writer.Write(static_cast<uint32_t>(pieces_.size()));
+    ring_.SaveState(writer);
+    for (const DebrisPiece* piece : pieces_) {
+        piece->SaveState(writer);
+    }
+}
+
+void DebrisController::LoadState(SnapshotReader& reader) {
+    GameObject2D::LoadState(reader);
+    reader.Read(currentRadius_);
+    reader.Read(rotationAngle_);
+    reader.Read(currentRotationSpeed_);
+    reader.Read(state_);
+    reader.Read(cooldownTimer_);
+    reader.Read(isCritical_);
+
+    uint32_t pieceCount = static_cast<uint32_t>(pieces_.size());
+    if (!reader.Read(pieceCount) || pieceCount > static_cast<uint32_t>(kMaxPieceCount)) {
+        return;
+    }
+    if (pieceCount != pieces_.size()) {
+        SetPieceCount(static_cast<int>(pieceCount));
+    }
+
+    // 並べ直した分は保存時の配列でそのまま上書きする
+    if (!ring_.LoadState(reader)) {
+        return;
+    }
+    for (DebrisPiece* piece : pieces_) {
+        piece->LoadState(reader);
     }
 }
 
@@ -2,6 +2,8 @@
 #include "GameObject2D.h"
 #include "DrawComponent2D.h"
 #include "InputManager.h"
+#include "SurvivalEnemyBatch.h"
+#include "DebrisRing.h"
 
 // 共通定数や前方宣言
 class SurvivalGameObjectManager;
@@ -11,7 +13,7 @@ class SurvivalGameObjectManager;
 // ==========================================
 class SurvivalPlayer : public GameObject2D {
 public:
-    SurvivalPlayer(InputManager* input);
+    SurvivalPlayer(SurvivalGameObjectManager* manager, InputManager* input);
     void Update(float dt) override;
 
     // 固有メソッド
@@ -19,78 +21,95 @@ public:
     int GetHP() const { return hp_; }
     float GetRadius() const { return radius_; }
 
+    // 宝石を吸い寄せ始める距離と、集めた経験値
+    float GetMagnetRadius() const { return magnetRadius_; }
+    void SetMagnetRadius(float radius) { magnetRadius_ = radius; }
+    void AddExperience(int value) { experience_ += value; }
+    int GetExperience() const { return experience_; }
+
+    void SaveState(SnapshotWriter& writer) const override;
+    void LoadState(SnapshotReader& reader) override;
+
     // 描画コンポーネントへのアクセサ
-    DrawComponent2D* GetDrawComp() const { return drawComp_; }
+    DrawComponent2D* GetDrawComp() { return &drawComp_; }
 
 private:
+    SurvivalGameObjectManager* manager_;
     InputManager* input_;
 
     float speed_ = 300.0f;
     float radius_ = 16.0f;
     int hp_ = 5;
     float invincibilityTimer_ = 0.0f;
+
+    float magnetRadius_ = 120.0f;
+    int experience_ = 0;
+
+    // 射撃（最後に動いた向きへ撃つ。弾はマネージャーの ProjectileSystem がまとめて動かす）
+    Vector2 aimDirection_ = { 1.0f, 0.0f };
+    float shotCooldown_ = 0.0f;
+
+    static constexpr float kShotInterval = 0.1f;  // 連射間隔（秒）
+    static constexpr float kShotSpeed = 900.0f;   // 弾速（px/秒）
+    static constexpr float kShotLifetime = 1.2f;
+    static constexpr int kShotDamage = 1;
+
+    void Shoot(float dt);
 };
 
 // ==========================================
 // 敵 (Enemy)
 // ==========================================
-enum class EnemyType { Normal, Tank };
-
+// 移動・HP・ノックバックの実体は SurvivalEnemyBatch が配列でまとめて持つ
+// このクラスは描画と、当たり判定からの窓口（OnHit / PushBack）を受け持つ
 class SurvivalEnemy : public GameObject2D {
 public:
-    SurvivalEnemy(Vector2 startPos, EnemyType type, std::shared_ptr<SurvivalPlayer> target);
+    SurvivalEnemy(Vector2 startPos, EnemyType type);
+
+    // 移動はバッチがまとめて行うので、ここでは描画コンポーネントの更新のみ
     void Update(float dt) override;
 
     // 固有メソッド
-    void OnHit(int damage, Vector2 knockbackDir, float knockbackPower);
+    // 無敵時間中で当たらなかったら false
+    bool OnHit(int damage, Vector2 knockbackDir, float knockbackPower);
     void PushBack(Vector2 dir, float dist); // 押し出し処理
 
     EnemyType GetType() const { return type_; }
-    float GetRadius() const { return radius_; }
-    bool IsInvincible() const { return hitInvincibility_ > 0.0f; }
+    float GetRadius() const { return GetEnemyTypeParams(type_).radius; }
+    bool IsInvincible() const { return batch_ && batch_->IsInvincible(batchIndex_); }
+
+    // バッチの計算結果を反映する（SurvivalEnemyBatch::Simulateから呼ばれる）
+    void ApplyBatchState(const Vector2& position, bool isKnockedBack, float dt);
 
 private:
-    std::shared_ptr<SurvivalPlayer> target_; // 追尾対象
+    friend class SurvivalEnemyBatch;
 
     EnemyType type_;
-    int hp_;
-    float radius_;
 
-    // ノックバック制御
-    Vector2 knockbackVel_ = { 0,0 };
-    float knockbackDuration_ = 0.0f;
-    float hitInvincibility_ = 0.0f;
+    // 状態の実体（バッチから外れるとnullptr）
+    SurvivalEnemyBatch* batch_ = nullptr;
+    size_t batchIndex_ = 0;
+
+    bool isKnockedBack_ = false; // 色の切り替え用
 };
 
 // ==========================================
 // がれき1粒 (DebrisPiece)
 // ==========================================
+// 位置（円周上の目標と、それに遅れて追従する慣性）は DebrisController の DebrisRing がまとめて計算する
+// このクラスは描画と当たり判定用の位置を受け持つ
 class DebrisPiece : public GameObject2D {
 public:
-    DebrisPiece(int index, int totalCount, std::shared_ptr<SurvivalPlayer> anchor);
+    DebrisPiece();
+
+    // 移動は輪がまとめて行うので、ここでは描画コンポーネントの更新のみ
     void Update(float dt) override;
 
-    // コントローラーから制御されるパラメータ
-    void SetStateInfo(float currentRadius, float rotationAngle, float expandSpeedScale);
+    // 輪の計算結果を反映する（DebrisController::Updateから呼ばれる）
+    void ApplyRingState(const Vector2& position, float dt);
 
-    // 固有メソッド
-    // 「本来あるべき位置」と「現在位置」のズレを利用して慣性を表現
+    // 慣性適用後の実際の位置
     Vector2 GetActualPosition() const { return transform_.translate; }
-
-private:
-    std::shared_ptr<SurvivalPlayer> anchor_; // 中心点（プレイヤー）
-
-    int index_;
-    int totalCount_;
-
-    // 個体差パラメータ
-    float angleOffset_;
-    float distNoise_;
-    float selfRotSpeed_;
-    float currentSelfRot_ = 0.0f;
-
-    // 慣性制御用
-    Vector2 targetPos_ = { 0,0 }; // 本来あるべき場所
 };
 
 // ==========================================
@@ -99,7 +118,15 @@ private:
 // これ自体は描画を持たず、DebrisPieceを生成して操る
 class DebrisController : public GameObject2D {
 public:
-    DebrisController(SurvivalGameObjectManager* manager, InputManager* input, std::shared_ptr<SurvivalPlayer> anchor);
+    DebrisController(SurvivalGameObjectManager* manager, InputManager* input, ObjectHandle anchor, int pieceCount = kDefaultPieceCount);
+
+    static constexpr int kDefaultPieceCount = 64;
+    static constexpr int kMaxPieceCount = 4096;
+
+    // がれきの数を変える（増やした分はマネージャーに作ってもらい、減らした分は次の更新で削除される）
+    // 変えた後は全体を円周上に等間隔に並べ直す
+    void SetPieceCount(int count);
+    int GetPieceCount() const { return static_cast<int>(pieces_.size()); }
     void Update(float dt) override;
 
     // 状態アクセサ
@@ -110,12 +137,19 @@ public:
     bool IsCritical() const { return isCritical_; }
 
     // すべてのDebrisPieceへのconst参照を返す
-    const std::vector<std::shared_ptr<DebrisPiece>>& GetPieces() const { return pieces_; }
+    const std::vector<DebrisPiece*>& GetPieces() const { return pieces_; }
+
+    // 各がれきの位置（GetPieces() と同じ並び）
+    const DebrisRing& GetRing() const { return ring_; }
+
+    // 輪の状態と全がれきを保存・復元する（数が違えば SetPieceCount で合わせてから書き戻す）
+    void SaveState(SnapshotWriter& writer) const override;
+    void LoadState(SnapshotReader& reader) override;
 
 private:
     SurvivalGameObjectManager* manager_;
     InputManager* input_;
-    std::shared_ptr<SurvivalPlayer> anchor_;
+    ObjectHandle anchor_;
 
     // パラメータ
     float minRadius_ = 60.0f;
@@ -132,6 +166,9 @@ private:
     float cooldownTimer_ = 0.0f;
     bool isCritical_ = false;
 
-    // Pieceへの参照（一括操作用）
-    std::vector<std::shared_ptr<DebrisPiece>> pieces_;
+    // Pieceへの参照（一括操作用。実体はマネージャーのプールが持つ）
+    std::vector<DebrisPiece*> pieces_;
+
+    // がれきの位置の計算（pieces_ と同じ並び）
+    DebrisRing ring_;
 };
\ No newline at end of file
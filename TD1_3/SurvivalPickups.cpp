@@ -0,0 +1,349 @@
+﻿#include "SurvivalPickups.h"
+#include "Camera2D.h"
+#include "SimulationClock.h"
+#include "SceneUtilityIncludes.h"
+#include "WorldSnapshot.h"
+#include <Novice.h>
+#include <cmath>
+
+namespace {
+    // 価値ごとの見た目（大きさと色）
+    struct GemLook {
+        float halfSize;
+        unsigned int color;
+    };
+
+    GemLook GetGemLook(int value) {
+        if (value >= 25) return { 9.0f, 0xFF66CCFF }; // まとめられた大きな宝石
+        if (value >= 5) return { 7.0f, 0x44FF88FF };
+        return { 5.0f, 0x44AAFFFF };
+    }
+}
+
+SurvivalPickupManager::SurvivalPickupManager() {
+    groundX_.reserve(kDefaultBudget);
+    groundY_.reserve(kDefaultBudget);
+    groundValue_.reserve(kDefaultBudget);
+    groundAlive_.reserve(kDefaultBudget);
+}
+
+void SurvivalPickupManager::Drop(const Vector2& position, int value) {
+    groundX_.push_back(position.x);
+    groundY_.push_back(position.y);
+    groundValue_.push_back(value);
+    groundAlive_.push_back(1);
+    isGridDirty_ = true;
+}
+
+void SurvivalPickupManager::Clear() {
+    groundX_.clear();
+    groundY_.clear();
+    groundValue_.clear();
+    groundAlive_.clear();
+    groundDeadCount_ = 0;
+
+    flyX_.clear();
+    flyY_.clear();
+    flyPrevX_.clear();
+    flyPrevY_.clear();
+    flySpeed_.clear();
+    flyValue_.clear();
+
+    isGridDirty_ = true;
+    collectedValue_ = 0;
+    stats_ = {};
+}
+
+void SurvivalPickupManager::SaveState(SnapshotWriter& writer) const {
+    writer.WriteArray(groundX_);
+    writer.WriteArray(groundY_);
+    writer.WriteArray(groundValue_);
+    writer.WriteArray(groundAlive_);
+    writer.Write(groundDeadCount_);
+
+    writer.WriteArray(flyX_);
+    writer.WriteArray(flyY_);
+    writer.WriteArray(flyPrevX_);
+    writer.WriteArray(flyPrevY_);
+    writer.WriteArray(flySpeed_);
+    writer.WriteArray(flyValue_);
+
+    writer.Write(budget_);
+    writer.Write(collectedValue_);
+}
+
+bool SurvivalPickupManager::LoadState(SnapshotReader& reader) {
+    reader.ReadArray(groundX_);
+    reader.ReadArray(groundY_);
+    reader.ReadArray(groundValue_);
+    reader.ReadArray(groundAlive_);
+    reader.Read(groundDeadCount_);
+
+    reader.ReadArray(flyX_);
+    reader.ReadArray(flyY_);
+    reader.ReadArray(flyPrevX_);
+    reader.ReadArray(flyPrevY_);
+    reader.ReadArray(flySpeed_);
+    reader.ReadArray(flyValue_);
+
+    reader.Read(budget_);
+    reader.Read(collectedValue_);
+
+    isGridDirty_ = true;
+    stats_ = {};
+
+    const size_t groundCount = groundX_.size();
+    const size_t flyCount = flyX_.size();
+    const bool isConsistent = groundY_.size() == groundCount && groundValue_.size() == groundCount &&
+        groundAlive_.size() == groundCount && groundDeadCount_ <= groundCount &&
+        flyY_.size() == flyCount && flyPrevX_.size() == flyCount && flyPrevY_.size() == flyCount &&
+        flySpeed_.size() == flyCount && flyValue_.size() == flyCount && budget_ > 0;
+    if (!reader.IsOk() || !isConsistent) {
+        Clear();
+        budget_ = kDefaultBudget;
+        return false;
+    }
+    return true;
+}
+
+int SurvivalPickupManager::TakeCollectedValue() {
+    const int value = collectedValue_;
+    collectedValue_ = 0;
+    return value;
+}
+
+void SurvivalPickupManager::Update(float deltaTime, const Vector2* playerPos, float magnetRadius, float collectRadius) {
+    stats_.collected = 0;
+    stats_.merged = 0;
+    stats_.rebuiltGrid = false;
+
+    // 描画補間用に、吸い寄せ中の宝石の位置を保存
+    flyPrevX_.assign(flyX_.begin(), flyX_.end());
+    flyPrevY_.assign(flyY_.begin(), flyY_.end());
+
+    // 1. 上限を超えていたら近くのものをまとめる
+    EnforceBudget();
+
+    // 2. 磁石の範囲が変わったか、宝石が増減していたらセル分けし直す
+    if (gridCellSize_ != magnetRadius) {
+        isGridDirty_ = true;
+    }
+    if (isGridDirty_) {
+        CompactGround();
+        grid_.Build(groundX_.data(), groundY_.data(), groundX_.size(), magnetRadius);
+        gridCellSize_ = magnetRadius;
+        isGridDirty_ = false;
+        stats_.rebuiltGrid = true;
+    }
+
+    if (playerPos) {
+        // 3. 範囲に入ったものを地面から吸い寄せ中へ移す
+        AttractNearby(*playerPos, magnetRadius);
+
+        // 4. 吸い寄せ中のものを動かし、届いたら回収
+        UpdateFlying(deltaTime, *playerPos, collectRadius);
+    }
+
+    stats_.ground = static_cast<int>(GetGroundCount());
+    stats_.flying = static_cast<int>(flyX_.size());
+}
+
+void SurvivalPickupManager::CompactGround() {
+    if (groundDeadCount_ == 0) return;
+
+    // 生きているものを順番を保ったまま前へ詰める（古いものほど前）
+    size_t write = 0;
+    for (size_t read = 0; read < groundX_.size(); ++read) {
+        if (!groundAlive_[read]) continue;
+        groundX_[write] = groundX_[read];
+        groundY_[write] = groundY_[read];
+        groundValue_[write] = groundValue_[read];
+        groundAlive_[write] = 1;
+        ++write;
+    }
+    groundX_.resize(write);
+    groundY_.resize(write);
+    groundValue_.resize(write);
+    groundAlive_.resize(write);
+    groundDeadCount_ = 0;
+}
+
+void SurvivalPickupManager::EnforceBudget() {
+    if (GetGroundCount() <= budget_) return;
+
+    const size_t before = GetGroundCount();
+
+    // 一度で上限ぎりぎりにすると毎フレームまとめ直すことになるので、3/4まで減らす
+    const size_t target = budget_ - budget_ / 4;
+    float radius = kMergeRadius;
+    for (int pass = 0; pass < kMaxMergePasses && GetGroundCount() > target; ++pass) {
+        MergePass(radius, target);
+        radius *= 2.0f;
+    }
+
+    // 散らばりすぎてまとめきれなかった分は古いものから畳む
+    if (GetGroundCount() > budget_) {
+        FoldExcess();
+    }
+
+    stats_.merged = static_cast<int>(before - GetGroundCount());
+    isGridDirty_ = true;
+}
+
+void SurvivalPickupManager::MergePass(float radius, size_t target) {
+    CompactGround();
+
+    // まとめる距離をセルの一辺にして近傍を探す
+    const size_t count = groundX_.size();
+    grid_.Build(groundX_.data(), groundY_.data(), count, radius);
+    gridCellSize_ = 0.0f; // 磁石用のセル分けではなくなった
+
+    size_t alive = count;
+    const float radiusSq = radius * radius;
+    for (size_t i = 0; i < count && alive > target; ++i) {
+        if (!groundAlive_[i]) continue;
+
+        candidates_.clear();
+        grid_.QueryNeighbors(groundX_[i], groundY_[i], candidates_);
+        SpatialHashGrid::FilterWithinRadius(groundX_.data(), groundY_.data(), candidates_,
+            groundX_[i], groundY_[i], radiusSq, hits_);
+
+        // 近くの宝石の価値を i に足して消す
+        for (const uint32_t j : hits_) {
+            if (j == i || !groundAlive_[j]) continue;
+            groundValue_[i] += groundValue_[j];
+            groundAlive_[j] = 0;
+            ++groundDeadCount_;
+            --alive;
+        }
+    }
+}
+
+void SurvivalPickupManager::FoldExcess() {
+    CompactGround();
+
+    // 古いものから溢れた分を消し、その価値は残るうちで一番古い宝石へまとめて渡す
+    const size_t count = groundX_.size();
+    const size_t excess = count - budget_;
+    int foldedValue = 0;
+    for (size_t k = 0; k < excess; ++k) {
+        foldedValue += groundValue_[k];
+        groundAlive_[k] = 0;
+    }
+    groundValue_[excess] += foldedValue;
+    groundDeadCount_ += excess;
+    CompactGround();
+}
+
+void SurvivalPickupManager::AttractNearby(const Vector2& playerPos, float magnetRadius) {
+    candidates_.clear();
+    grid_.QueryNeighbors(playerPos.x, playerPos.y, candidates_);
+    if (candidates_.empty()) return;
+
+    SpatialHashGrid::FilterWithinRadius(groundX_.data(), groundY_.data(), candidates_,
+        playerPos.x, playerPos.y, magnetRadius * magnetRadius, hits_);
+
+    for (const uint32_t i : hits_) {
+        if (!groundAlive_[i]) continue;
+
+        // 地面の配列は印だけ付ける（セル分けを作り直さずに済むように）
+        groundAlive_[i] = 0;
+        ++groundDeadCount_;
+
+        flyX_.push_back(groundX_[i]);
+        flyY_.push_back(groundY_[i]);
+        flyPrevX_.push_back(groundX_[i]);
+        flyPrevY_.push_back(groundY_[i]);
+        flySpeed_.push_back(kFlyStartSpeed);
+        flyValue_.push_back(groundValue_[i]);
+    }
+}
+
+void SurvivalPickupManager::UpdateFlying(float deltaTime, const Vector2& playerPos, float collectRadius) {
+    size_t i = 0;
+    while (i < flyX_.size()) {
+        flySpeed_[i] += kFlyAcceleration * deltaTime;
+
+        const float dx = playerPos.x - flyX_[i];
+        const float dy = playerPos.y - flyY_[i];
+        const float dist = std::sqrt(dx * dx + dy * dy);
+        const float step = flySpeed_[i] * deltaTime;
+
+        if (dist > collectRadius && dist > step) {
+            flyX_[i] += dx / dist * step;
+            flyY_[i] += dy / dist * step;
+            ++i;
+            continue;
+        }
+
+        // 回収（末尾と入れ替えて取り除く）
+        collectedValue_ += flyValue_[i];
+        ++stats_.collected;
+
+        flyX_[i] = flyX_.back();
+        flyY_[i] = flyY_.back();
+        flyPrevX_[i] = flyPrevX_.back();
+        flyPrevY_[i] = flyPrevY_.back();
+        flySpeed_[i] = flySpeed_.back();
+        flyValue_[i] = flyValue_.back();
+        flyX_.pop_back();
+        flyY_.pop_back();
+        flyPrevX_.pop_back();
+        flyPrevY_.pop_back();
+        flySpeed_.pop_back();
+        flyValue_.pop_back();
+    }
+}
+
+void SurvivalPickupManager::Draw(const Camera2D& camera) const {
+    Vector2 viewMin;
+    Vector2 viewMax;
+    camera.GetVisibleWorldRect(viewMin, viewMax);
+
+    const Affine2x3& vp = camera.GetVpVpAffine();
+    const float alpha = SimulationClock::GetInstance().GetInterpolationAlpha();
+    const int graphHandle = Tex().GetTexture(TextureId::White1x1);
+
+    // ひし形の四隅（中心からのワールド上のずれ）を行列の回転・拡大部分だけで画面へ移す
+    const float axisXx = vp.m00;
+    const float axisXy = vp.m01;
+    const float axisYx = vp.m10;
+    const float axisYy = vp.m11;
+
+    auto drawGem = [&](float x, float y, int value) {
+        const GemLook look = GetGemLook(value);
+        if (x < viewMin.x - look.halfSize || x > viewMax.x + look.halfSize ||
+            y < viewMin.y - look.halfSize || y > viewMax.y + look.halfSize) {
+            return;
+        }
+
+        const Vector2 center = vp.Transform({ x, y });
+        const float hx = axisXx * look.halfSize;
+        const float hy = axisXy * look.halfSize;
+        const float vx = axisYx * look.halfSize;
+        const float vy = axisYy * look.halfSize;
+
+        // 左上 = 左、右上 = 上、左下 = 下、右下 = 右 の頂点
+        Novice::DrawQuad(
+            static_cast<int>(center.x - hx), static_cast<int>(center.y - hy),
+            static_cast<int>(center.x + vx), static_cast<int>(center.y + vy),
+            static_cast<int>(center.x - vx), static_cast<int>(center.y - vy),
+            static_cast<int>(center.x + hx), static_cast<int>(center.y + hy),
+            0, 0, 1, 1,
+            graphHandle,
+            look.color
+        );
+    };
+
+    for (size_t i = 0; i < groundX_.size(); ++i) {
+        if (groundAlive_[i]) {
+            drawGem(groundX_[i], groundY_[i], groundValue_[i]);
+        }
+    }
+
+    for (size_t i = 0; i < flyX_.size(); ++i) {
+        const float x = flyPrevX_[i] + (flyX_[i] - flyPrevX_[i]) * alpha;
+        const float y = flyPrevY_[i] + (flyY_[i] - flyPrevY_[i]) * alpha;
+        drawGem(x, y, flyValue_[i]);
+    }
+}
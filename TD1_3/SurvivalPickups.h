@@ -0,0 +1,114 @@
+﻿#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "Vector2.h"
+#include "SpatialHashGrid.h"
+
+class Camera2D; // 前方宣言
+class SnapshotWriter;
+class SnapshotReader;
+
+// 1フレーム分の拾い物の状況（デバッグ表示用）
+struct SurvivalPickupStats {
+    int ground = 0;    // 地面に落ちている数
+    int flying = 0;    // プレイヤーへ吸い寄せ中の数
+    int collected = 0; // このフレームに回収した数
+    int merged = 0;    // このフレームにまとめて消えた数
+    bool rebuiltGrid = false; // このフレームにセル分けをやり直したか
+};
+
+/// <summary>
+/// サバイバルの経験値の宝石（拾い物）をまとめて管理するクラス
+/// 地面の宝石は動かないので、増減があった時だけ空間ハッシュを作り直し、
+/// 毎フレームはプレイヤーの周りのセルだけを調べて磁石の範囲に入ったものを吸い寄せる
+/// 地面の数が上限を超えたら近くの宝石を1つにまとめ（価値は合計）、数と1フレームの処理量を一定以下に保つ
+/// </summary>
+class SurvivalPickupManager {
+public:
+    static constexpr size_t kDefaultBudget = 1024;
+
+    SurvivalPickupManager();
+    ~SurvivalPickupManager() = default;
+
+    /// <summary>
+    /// 宝石を1つ落とす（上限を超えた分は次のUpdateでまとめる）
+    /// </summary>
+    void Drop(const Vector2& position, int value);
+
+    /// <summary>
+    /// 1ステップ進める
+    /// </summary>
+    /// <param name="deltaTime">経過時間</param>
+    /// <param name="playerPos">プレイヤーの位置（nullptrなら吸い寄せない）</param>
+    /// <param name="magnetRadius">吸い寄せ始める距離</param>
+    /// <param name="collectRadius">回収する距離</param>
+    void Update(float deltaTime, const Vector2* playerPos, float magnetRadius, float collectRadius);
+
+    /// <summary>
+    /// カメラに映る宝石を描画する（価値が高いほど大きく、色が変わる）
+    /// </summary>
+    void Draw(const Camera2D& camera) const;
+
+    void Clear();
+
+    /// <summary>
+    /// 地面と吸い寄せ中の宝石を保存・復元する（セル分けは次のUpdateで作り直す）
+    /// </summary>
+    void SaveState(SnapshotWriter& writer) const;
+    bool LoadState(SnapshotReader& reader);
+
+    /// <summary>
+    /// 前回呼んでから回収した価値の合計を受け取る（受け取った分は0に戻る）
+    /// </summary>
+    int TakeCollectedValue();
+
+    // 地面に置いておける数の目安（超えたら近いものからまとめる）
+    void SetBudget(size_t budget) { budget_ = budget > 0 ? budget : 1; }
+    size_t GetBudget() const { return budget_; }
+
+    size_t GetGroundCount() const { return groundX_.size() - groundDeadCount_; }
+    size_t GetFlyingCount() const { return flyX_.size(); }
+    const SurvivalPickupStats& GetStats() const { return stats_; }
+
+private:
+    // まとめる時の最初の距離と、広げる回数（届かなければ倍にしてやり直す）
+    static constexpr float kMergeRadius = 40.0f;
+    static constexpr int kMaxMergePasses = 4;
+
+    // 吸い寄せの初速・加速度（px/s, px/s^2）
+    static constexpr float kFlyStartSpeed = 150.0f;
+    static constexpr float kFlyAcceleration = 1500.0f;
+
+    // 地面の宝石（回収されたものは印だけ付け、作り直すときに詰める）
+    std::vector<float> groundX_, groundY_;
+    std::vector<int> groundValue_;
+    std::vector<uint8_t> groundAlive_;
+    size_t groundDeadCount_ = 0;
+
+    // 吸い寄せ中の宝石（描画補間用に前ステップの位置も持つ）
+    std::vector<float> flyX_, flyY_;
+    std::vector<float> flyPrevX_, flyPrevY_;
+    std::vector<float> flySpeed_;
+    std::vector<int> flyValue_;
+
+    // 地面の宝石のセル分け（一辺 = 磁石の範囲。周囲3x3セルで範囲内が全て見つかる）
+    SpatialHashGrid grid_;
+    float gridCellSize_ = 0.0f;
+    bool isGridDirty_ = true;
+
+    // 近傍検索の作業領域
+    std::vector<uint32_t> candidates_;
+    std::vector<uint32_t> hits_;
+
+    size_t budget_ = kDefaultBudget;
+    int collectedValue_ = 0;
+    SurvivalPickupStats stats_;
+
+    void CompactGround();
+    void EnforceBudget();
+    void MergePass(float radius, size_t target);
+    void FoldExcess();
+    void AttractNearby(const Vector2& playerPos, float magnetRadius);
+    void UpdateFlying(float deltaTime, const Vector2& playerPos, float collectRadius);
+};
@@ -0,0 +1,78 @@
+﻿#pragma once
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cassert>
+
+// 文字列タグを登録順に振った16bitの番号
+using TagId = uint16_t;
+
+// 未設定のタグ（"Untagged"）
+constexpr TagId kUntaggedTag = 0;
+
+/// <summary>
+/// タグ文字列と番号の対応表（全体で1つ）
+/// 同じ文字列には常に同じ番号を返すので、以降は番号の比較だけで済む
+/// </summary>
+class TagRegistry {
+public:
+	static TagRegistry& GetInstance() {
+		static TagRegistry instance;
+		return instance;
+	}
+
+	// 削除・コピー禁止
+	TagRegistry(const TagRegistry&) = delete;
+	TagRegistry& operator=(const TagRegistry&) = delete;
+
+	/// <summary>
+	/// タグを登録して番号を返す（登録済みならその番号）
+	/// </summary>
+	TagId Intern(const std::string& name) {
+		auto it = ids_.find(name);
+		if (it != ids_.end()) {
+			return it->second;
+		}
+
+		assert(names_.size() < UINT16_MAX && "TagRegistry: too many tags");
+		const TagId id = static_cast<TagId>(names_.size());
+		names_.push_back(name);
+		ids_.emplace(name, id);
+		return id;
+	}
+
+	/// <summary>
+	/// 登録済みのタグを探す（未登録ならfalse）
+	/// </summary>
+	bool TryFind(const std::string& name, TagId& outId) const {
+		auto it = ids_.find(name);
+		if (it == ids_.end()) {
+			return false;
+		}
+		outId = it->second;
+		return true;
+	}
+
+	// 番号からタグ文字列を取得（デバッグ表示・保存用）
+	const std::string& GetName(TagId id) const {
+		assert(id < names_.size());
+		return names_[id];
+	}
+
+	size_t GetTagCount() const { return names_.size(); }
+
+private:
+	TagRegistry() {
+		Intern("Untagged");
+	}
+	~TagRegistry() = default;
+
+	std::vector<std::string> names_;
+	std::unordered_map<std::string, TagId> ids_;
+};
+
+// タグを番号に変換する省略形
+inline TagId InternTag(const std::string& name) {
+	return TagRegistry::GetInstance().Intern(name);
+}
@@ -3,6 +3,9 @@
 #include "TileRegistry.h"
 #include <memory>
 #include "TextureManager.h"
+#include "MapData.h"
+#include "Random.h"
+#include <algorithm>
 
 class TileInstance {
 public:
@@ -23,7 +26,7 @@ public:
 
             // アニメーションの開始時間をバラつかせて「自然さ」を出す
             if (def.animConfig.isAnimated) {
-                float randomOffset = static_cast<float>(rand()) / RAND_MAX;
+                float randomOffset = Rng(RandomStreamId::Visual).RandomFloat(0.0f, 1.0f);
                 drawComp_->Update(randomOffset);
             }
         }
@@ -59,6 +62,27 @@ public:
 
 	Vector2 GetWorldPos() const { return worldPos_; }
 
+    /// <summary>
+    /// 不透明なブロックに完全に隠れているか
+    /// アンカーやY軸反転に依らず収まるよう、描画サイズを中心から対称に広げて判定する
+    /// </summary>
+    bool IsOccluded(const MapData& mapData) const {
+        // エフェクト中は位置・サイズが揺れるので常に描画する
+        if (!drawComp_ || drawComp_->IsAnyEffectActive()) return false;
+        if (!mapData.IsOccluded(static_cast<int>(worldPos_.x / mapData.GetTileSize()),
+            static_cast<int>(worldPos_.y / mapData.GetTileSize()))) {
+            return false;
+        }
+
+        const Vector2 size = drawComp_->GetFinalDrawSize();
+        const Vector2 anchor = drawComp_->GetAnchorPoint();
+        const float halfW = size.x * std::max(anchor.x, 1.0f - anchor.x);
+        const float halfH = size.y * std::max(anchor.y, 1.0f - anchor.y);
+        return mapData.IsRectOccluded(
+            { worldPos_.x - halfW, worldPos_.y - halfH },
+            { worldPos_.x + halfW, worldPos_.y + halfH });
+    }
+
 private:
     int id_;
     Vector2 worldPos_;
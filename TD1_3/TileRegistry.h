@@ -45,6 +45,8 @@ struct TileDefinition {
 
 	RenderMode renderMode; // 描画モード(MapChipかComponentか)
 	TileAnimConfig animConfig; // アニメーション設定
+
+	bool isOpaque = false; // セル全体を不透明に覆うか(下のレイヤーの描画を省略できる)
 };
 
 class TileRegistry {
@@ -76,6 +78,7 @@ public:
 		//	TileAnimConfig animConfig{
 		//		true(アニメーションあるかどうか), 8(スプライトシートの横), 1(縦), 8(総フレーム数),
 		//		0.15f(アニメーション速度),true(ループするかどうか),{0.5f, 0.8f}(アンカーポイントの位置)};
+		//	bool isOpaque;			// 不透明か(Blockレイヤーのみ有効、オートタイルは内側パーツのみ)
 		//};
 
 		// ID:0 空気 (テクスチャなし)
@@ -97,7 +100,8 @@ public:
 			true,
 			TileLayer::Block,
 			{0.0f, 0.0f},
-			RenderMode::Simple,{}
+			RenderMode::Simple,{},
+			true // 内側パーツは不透明
 			});
 
 		// ID:2 鉄ブロック
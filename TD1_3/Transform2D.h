@@ -1,8 +1,9 @@
 ﻿#pragma once
 #include "Matrix3x3.h"
 #include "Affine2D.h"
+#include <cstdint>
 
-// #include "GameObject.h" // 循環参照を避けるためGameObject* parent_は前方宣言で
+// 親子関係はTransform2D自身では持たず、GameObject2Dがオーナーを親として CalculateWorldMatrix(parent) を呼ぶ
 
 struct Transform2D {
 	// ローカル座標
@@ -13,8 +14,106 @@ struct Transform2D {
 	// ワールド座標 (計算結果)
 	Matrix3x3 worldMatrix;
 
-	// World行列を再計算する関数
+	// 行列キャッシュ（ローカルSRTか親が変わった時だけ再計算する）
+	Matrix3x3 localMatrix;
+	Vector2 cachedTranslate = { 0.0f, 0.0f };
+	Vector2 cachedScale = { 1.0f, 1.0f };
+	float cachedRotation = 0.0f;
+	bool isLocalCached = false;
+	bool hasParent = false;     // 直近のworldMatrixが親の行列を掛けたものか
+	uint32_t version = 0;       // worldMatrixが変わるたびに増える（子が親の変化を知るため）
+	uint32_t parentVersion = 0; // 直近の計算に使った親のversion
+
+	// 直前の固定ステップ開始時の値（描画補間用）
+	Vector2 previousTranslate = { 0.0f, 0.0f };
+	Vector2 previousScale = { 1.0f, 1.0f };
+	float previousRotation = 0.0f;
+	bool hasPrevious = false; // 一度もSavePreviousしていなければ補間しない
+
+	// 前回の計算からSRTが変わったか
+	bool IsLocalDirty() const {
+		return !isLocalCached ||
+			translate.x != cachedTranslate.x || translate.y != cachedTranslate.y ||
+			scale.x != cachedScale.x || scale.y != cachedScale.y ||
+			rotation != cachedRotation;
+	}
+
+	// キャッシュを捨てて次回必ず再計算させる（親を付け替えた時など）
+	void InvalidateCache() {
+		isLocalCached = false;
+	}
+
+	// SRTが変わっていればローカル行列を作り直す（作り直したらtrue）
+	bool UpdateLocalMatrix() {
+		if (!IsLocalDirty()) {
+			return false;
+		}
+
+		localMatrix = AffineMatrix2D::MakeAffine(scale, rotation, translate);
+		cachedTranslate = translate;
+		cachedScale = scale;
+		cachedRotation = rotation;
+		isLocalCached = true;
+		return true;
+	}
+
+	// World行列を再計算する関数（SRTが変わっていなければ何もしない）
 	void CalculateWorldMatrix() {
-		worldMatrix = AffineMatrix2D::MakeAffine(scale, rotation, translate);
+		if (!UpdateLocalMatrix() && !hasParent) {
+			return;
+		}
+
+		worldMatrix = localMatrix;
+		hasParent = false;
+		++version;
+	}
+
+	/// <summary>
+	/// 親のワールド行列を掛けてWorld行列を再計算する
+	/// 自分のSRTも親の行列も変わっていなければ何もしない
+	/// </summary>
+	void CalculateWorldMatrix(const Transform2D& parent) {
+		const bool isLocalChanged = UpdateLocalMatrix();
+		if (!isLocalChanged && hasParent && parentVersion == parent.version) {
+			return;
+		}
+
+		worldMatrix = Matrix3x3::Multiply(localMatrix, parent.worldMatrix);
+		hasParent = true;
+		parentVersion = parent.version;
+		++version;
+	}
+
+	// ワールド座標での位置（CalculateWorldMatrix後に有効）
+	Vector2 GetWorldPosition() const {
+		return { worldMatrix.m[2][0], worldMatrix.m[2][1] };
+	}
+
+	/// <summary>
+	/// 固定ステップの開始時に現在の値を保存する
+	/// ワープさせた直後に呼べば補間による軌跡も消える
+	/// </summary>
+	void SavePrevious() {
+		previousTranslate = translate;
+		previousScale = scale;
+		previousRotation = rotation;
+		hasPrevious = true;
+	}
+
+	/// <summary>
+	/// 前ステップと現ステップの間を補間したTransformを返す（描画用）
+	/// </summary>
+	/// <param name="alpha">補間係数（0 = 前ステップ, 1 = 現ステップ）</param>
+	Transform2D Interpolated(float alpha) const {
+		Transform2D result = *this;
+		if (!hasPrevious) {
+			return result;
+		}
+
+		result.translate = previousTranslate + (translate - previousTranslate) * alpha;
+		result.scale = previousScale + (scale - previousScale) * alpha;
+		result.rotation = previousRotation + (rotation - previousRotation) * alpha;
+		result.CalculateWorldMatrix();
+		return result;
 	}
 };
\ No newline at end of file
@@ -1,48 +1,101 @@
 ﻿#pragma once
+#include <cmath>
 
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1) || defined(__SSE__)
+#include <xmmintrin.h>
+#define VECTOR2_USE_SSE
+#endif
+
+// 全てヘッダー内のインライン関数（翻訳単位をまたいでも呼び出し先が展開されるように）
 class Vector2 {
 public:
 	float x, y;
 
 	// 加算代入
-	Vector2& operator+=(const Vector2& v) {
+	constexpr Vector2& operator+=(const Vector2& v) {
 		x += v.x;
 		y += v.y;
 		return *this;
 	}
 
 	// 減算代入
-	Vector2& operator-=(const Vector2& v) {
+	constexpr Vector2& operator-=(const Vector2& v) {
 		x -= v.x;
 		y -= v.y;
 		return *this;
 	}
 
 	// スカラー倍代入
-	Vector2& operator*=(float s) {
+	constexpr Vector2& operator*=(float s) {
 		x *= s;
 		y *= s;
 		return *this;
 	}
 
-	Vector2& operator/=(float s) {
+	constexpr Vector2& operator/=(float s) {
 		x /= s;
 		y /= s;
 		return *this;
 	}
 
-	static Vector2 Add(const Vector2& v1, const Vector2& v2);
-	static Vector2 Subtract(const Vector2& v1, const Vector2& v2);
-	static Vector2 Multiply(float scalar, const Vector2& v1);
-	static float Dot(const Vector2& v1, const Vector2& v2);
-	static float Length(const Vector2& v);
-	static Vector2 Normalize(const Vector2& v);
-	static float Cross(const Vector2& v1, const Vector2& v2);
+	static constexpr Vector2 Add(const Vector2& v1, const Vector2& v2) { return { v1.x + v2.x, v1.y + v2.y }; }
+	static constexpr Vector2 Subtract(const Vector2& v1, const Vector2& v2) { return { v1.x - v2.x, v1.y - v2.y }; }
+	static constexpr Vector2 Multiply(float scalar, const Vector2& v1) { return { v1.x * scalar, v1.y * scalar }; }
+
+	// 内積・外積
+	static constexpr float Dot(const Vector2& v1, const Vector2& v2) { return v1.x * v2.x + v1.y * v2.y; }
+	static constexpr float Cross(const Vector2& v1, const Vector2& v2) { return v1.x * v2.y - v1.y * v2.x; }
+
+	// 長さの2乗（比較だけなら平方根を取らずにこちらを使う）
+	static constexpr float LengthSquared(const Vector2& v) { return v.x * v.x + v.y * v.y; }
+
+	static float Length(const Vector2& v) { return std::sqrt(LengthSquared(v)); }
+
+	// ノーマライズ(正規化)。長さ0なら(0, 0)
+	static Vector2 Normalize(const Vector2& v) {
+		float length = 0.0f;
+		return LengthAndNormalize(v, length);
+	}
+
+	/// <summary>
+	/// 長さと正規化した向きを1回の平方根で求める（Length と Normalize を続けて呼ぶ代わり）
+	/// </summary>
+	/// <param name="v">元のベクトル</param>
+	/// <param name="outLength">長さ</param>
+	/// <returns>正規化した向き（長さ0なら(0, 0)）</returns>
+	static Vector2 LengthAndNormalize(const Vector2& v, float& outLength) {
+		outLength = Length(v);
+		if (outLength == 0.0f) {
+			return { 0.0f, 0.0f };
+		}
+		const float invLength = 1.0f / outLength;
+		return { v.x * invLength, v.y * invLength };
+	}
+
+	/// <summary>
+	/// 逆平方根の近似で正規化する（ニュートン法1回で相対誤差は約1e-6。向きだけ欲しい毎フレームの処理用）
+	/// </summary>
+	/// <returns>正規化した向き（長さ0なら(0, 0)）</returns>
+	static Vector2 NormalizeFast(const Vector2& v) {
+		const float lengthSq = LengthSquared(v);
+		if (lengthSq == 0.0f) {
+			return { 0.0f, 0.0f };
+		}
+#ifdef VECTOR2_USE_SSE
+		const __m128 squared = _mm_set_ss(lengthSq);
+		const __m128 estimate = _mm_rsqrt_ss(squared);
+		const float approx = _mm_cvtss_f32(estimate);
+		const float invLength = approx * (1.5f - 0.5f * lengthSq * approx * approx);
+#else
+		const float invLength = 1.0f / std::sqrt(lengthSq);
+#endif
+		return { v.x * invLength, v.y * invLength };
+	}
 
 };
 
-Vector2 operator+(const Vector2& v1, const Vector2& v2);
-Vector2 operator-(const Vector2& v1, const Vector2& v2);
-Vector2 operator*(float s, const Vector2& v);
-Vector2 operator*(const Vector2& v, float s);
-Vector2 operator/(const Vector2& v, float s);
\ No newline at end of file
+constexpr Vector2 operator+(const Vector2& v1, const Vector2& v2) { return Vector2::Add(v1, v2); }
+constexpr Vector2 operator-(const Vector2& v1, const Vector2& v2) { return Vector2::Subtract(v1, v2); }
+constexpr Vector2 operator*(float s, const Vector2& v) { return Vector2::Multiply(s, v); }
+constexpr Vector2 operator*(const Vector2& v, float s) { return Vector2::Multiply(s, v); }
+constexpr Vector2 operator/(const Vector2& v, float s) { return Vector2::Multiply(1.0f / s, v); }
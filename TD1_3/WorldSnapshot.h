@@ -0,0 +1,128 @@
+﻿#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+/// <summary>
+/// シミュレーション状態を詰めた1本のバイト列
+/// 各システムが SaveState / LoadState で自分の状態を決まった順に書き・読みする
+/// 使い回せば2回目以降は確保が起きないので、保存・復元ともほぼコピーだけの処理になる
+/// </summary>
+class WorldSnapshot {
+public:
+    void Clear() { data_.clear(); }
+    bool IsEmpty() const { return data_.empty(); }
+    size_t GetSize() const { return data_.size(); }
+
+    /// <summary>
+    /// バイト列のハッシュ（FNV-1a 64bit。再生結果が記録時と同じ状態になったかの比較用）
+    /// </summary>
+    uint64_t ComputeHash() const { return HashBytes(data_.data(), data_.size()); }
+
+    // seed に続けて size バイトを混ぜたハッシュ（複数の値を順に混ぜる時は前の結果を seed に渡す）
+    static uint64_t HashBytes(const void* src, size_t size, uint64_t seed = kHashOffsetBasis) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(src);
+        uint64_t hash = seed;
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= kHashPrime;
+        }
+        return hash;
+    }
+
+private:
+    friend class SnapshotWriter;
+    friend class SnapshotReader;
+
+    static constexpr uint64_t kHashOffsetBasis = 14695981039346656037ull;
+    static constexpr uint64_t kHashPrime = 1099511628211ull;
+
+    std::vector<uint8_t> data_;
+};
+
+/// <summary>
+/// WorldSnapshot への書き込み（作ると中身を空にする。確保済みの領域は使い回す）
+/// 書けるのはmemcpyで写せる型だけ（ポインタやstd::functionを持つものは項目ごとに書く）
+/// </summary>
+class SnapshotWriter {
+public:
+    explicit SnapshotWriter(WorldSnapshot& snapshot) : data_(snapshot.data_) {
+        data_.clear();
+    }
+
+    void WriteBytes(const void* src, size_t size) {
+        if (size == 0) return;
+        const size_t offset = data_.size();
+        data_.resize(offset + size);
+        std::memcpy(data_.data() + offset, src, size);
+    }
+
+    template <typename T>
+    void Write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "SnapshotWriter: T must be trivially copyable");
+        WriteBytes(&value, sizeof(T));
+    }
+
+    // 要素数 + 中身をまとめて書く
+    template <typename T>
+    void WriteArray(const std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable_v<T>, "SnapshotWriter: T must be trivially copyable");
+        Write<uint32_t>(static_cast<uint32_t>(values.size()));
+        WriteBytes(values.data(), values.size() * sizeof(T));
+    }
+
+private:
+    std::vector<uint8_t>& data_;
+};
+
+/// <summary>
+/// WorldSnapshot からの読み出し（書いた時と同じ順・同じ型で読む）
+/// 足りなくなったら以降は何も読まず、IsOk() が false になる
+/// </summary>
+class SnapshotReader {
+public:
+    explicit SnapshotReader(const WorldSnapshot& snapshot) : data_(snapshot.data_) {}
+
+    bool ReadBytes(void* dst, size_t size) {
+        if (!isOk_ || pos_ + size > data_.size()) {
+            isOk_ = false;
+            return false;
+        }
+        if (size > 0) {
+            std::memcpy(dst, data_.data() + pos_, size);
+        }
+        pos_ += size;
+        return true;
+    }
+
+    template <typename T>
+    bool Read(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "SnapshotReader: T must be trivially copyable");
+        return ReadBytes(&value, sizeof(T));
+    }
+
+    template <typename T>
+    bool ReadArray(std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable_v<T>, "SnapshotReader: T must be trivially copyable");
+        uint32_t count = 0;
+        if (!Read(count)) return false;
+        if (pos_ + static_cast<size_t>(count) * sizeof(T) > data_.size()) {
+            isOk_ = false;
+            return false;
+        }
+        values.resize(count);
+        return ReadBytes(values.data(), static_cast<size_t>(count) * sizeof(T));
+    }
+
+    bool IsOk() const { return isOk_; }
+
+    // 全部読み切ったか（書いた量と読んだ量が一致しているかの確認用）
+    bool IsAtEnd() const { return pos_ == data_.size(); }
+
+private:
+    const std::vector<uint8_t>& data_;
+    size_t pos_ = 0;
+    bool isOk_ = true;
+};
@@ -10,18 +10,77 @@
 #include "TextureManager.h"
 
 #include "Camera2D.h"
+#include "SurvivalBenchmark.h"
+#include "GameObjectManager.h"
+#include "InputRecording.h"
+#include "Random.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
 
 const char kWindowTitle[] = "==============ゲームタイトル==============";
 
+// コマンドラインの "name値" から値の部分（次の空白まで）を取り出す。無ければ空文字
+static std::string GetCommandLineOption(const char* cmdLine, const char* name) {
+	if (!cmdLine) return {};
+	const char* found = std::strstr(cmdLine, name);
+	if (!found) return {};
+	const char* begin = found + std::strlen(name);
+	const char* end = begin;
+	while (*end != '\0' && *end != ' ') {
+		++end;
+	}
+	return std::string(begin, end);
+}
+
 // Windowsアプリでのエントリーポイント(main関数)
-int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
+int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR lpCmdLine, int) {
 
 	// ライブラリの初期化
 	Novice::Initialize(kWindowTitle, (int)kWindowWidth, (int)kWindowHeight);
 
-	const float kDeltaTime = 1.0f / 60.0f;
+	// 負荷計測モード（--survival-bench [--bench-frames=N]）：描画せずに計測して結果を書き出し、終了する
+	if (lpCmdLine && std::strstr(lpCmdLine, "--survival-bench")) {
+		SurvivalBenchmarkSettings benchSettings;
+		const char kFramesOption[] = "--bench-frames=";
+		if (const char* frames = std::strstr(lpCmdLine, kFramesOption)) {
+			const int measureFrames = std::atoi(frames + sizeof(kFramesOption) - 1);
+			if (measureFrames > 0) {
+				benchSettings.measureFrames = measureFrames;
+			}
+		}
+		SurvivalBenchmark(benchSettings).Run();
+		Novice::Finalize();
+		return 0;
+	}
+
+	// 物理の確認モード（--physics-check）：間引いたボディが毎ステップ計算したボディに追い付くかを調べて終了する
+	if (lpCmdLine && std::strstr(lpCmdLine, "--physics-check")) {
+		const bool isOk = GameObjectManager::CheckThrottledCatchUp();
+		Novice::Finalize();
+		return isOk ? 0 : 1;
+	}
+
+	// 1フレームで進める実時間の上限（ブレークポイントやウィンドウ移動で止まった後の暴走防止）
+	const float kMaxFrameTime = 0.25f;
 	SceneManager sceneManager;
 
+	// シミュレーション周波数（--sim-rate=30|60|120。省略時は60Hz。重い環境では下げても操作感は変わらない）
+	int simulationRate = 60;
+	const std::string rateOption = GetCommandLineOption(lpCmdLine, "--sim-rate=");
+	if (!rateOption.empty()) {
+		const int requestedRate = std::atoi(rateOption.c_str());
+		if (SceneManager::IsSupportedSimulationRate(requestedRate)) {
+			simulationRate = requestedRate;
+		}
+		else {
+			Novice::ConsolePrintf("[main] --sim-rate=%s is not supported (30 / 60 / 120). Using 60 Hz\n", rateOption.c_str());
+		}
+	}
+	sceneManager.SetSimulationRate(simulationRate);
+
 	//Novice::SetWindowMode(kFullscreen);
 
 	SoundManager::GetInstance().LoadResources();
@@ -29,9 +88,38 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
 	ParticleManager::GetInstance().Load();
 	TextureManager::GetInstance().LoadResources();
 
+	// 入力の再生モード（--replay=<file> [--replay-report=<file>]）：記録した入力で描画せずに全速で回し、結果を書き出して終了する
+	const std::string replayPath = GetCommandLineOption(lpCmdLine, "--replay=");
+	if (!replayPath.empty()) {
+		SoundManager::GetInstance().SetMuted(true);
+		InputRecording recording;
+		if (recording.LoadFromFile(replayPath)) {
+			std::string reportPath = GetCommandLineOption(lpCmdLine, "--replay-report=");
+			if (reportPath.empty()) {
+				reportPath = "./replay_report.json";
+			}
+			sceneManager.RunReplay(recording, reportPath);
+		}
+		Novice::Finalize();
+		return 0;
+	}
+
+	// 入力の記録モード（--record=<file> [--seed=N]）：起動時のシーンから記録し、終了時に書き出す
+	const std::string recordPath = GetCommandLineOption(lpCmdLine, "--record=");
+	if (!recordPath.empty()) {
+		const std::string seedOption = GetCommandLineOption(lpCmdLine, "--seed=");
+		const uint32_t seed = seedOption.empty()
+			? RandomStreams::MakeSeed()
+			: static_cast<uint32_t>(std::strtoul(seedOption.c_str(), nullptr, 10));
+		sceneManager.StartRecording(seed);
+	}
+
 	// キー入力結果を受け取る箱
 	char keys[256] = { 0 };
-	char preKeys[256] = { 0 };
+
+	// 実経過時間の計測
+	using Clock = std::chrono::steady_clock;
+	Clock::time_point previousTime = Clock::now();
 
 	// ウィンドウの×ボタンが押されるまでループ
 	while (Novice::ProcessMessage() == 0) {
@@ -39,14 +127,21 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
 		Novice::BeginFrame();
 
 		// キー入力を受け取る
-		memcpy(preKeys, keys, 256);
 		Novice::GetHitKeyStateAll(keys);
 
+		// 前フレームからの経過時間
+		const Clock::time_point currentTime = Clock::now();
+		float frameTime = std::chrono::duration<float>(currentTime - previousTime).count();
+		previousTime = currentTime;
+		if (frameTime > kMaxFrameTime) {
+			frameTime = kMaxFrameTime;
+		}
+
 		///
 		/// ↓更新処理ここから
 		///
 
-		sceneManager.Update(kDeltaTime, keys, preKeys);
+		sceneManager.Update(frameTime, keys);
 
 		///
 		/// ↑更新処理ここまで
@@ -75,6 +170,10 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
 		}
 	}
 
+	if (sceneManager.IsRecording()) {
+		sceneManager.StopRecording(recordPath);
+	}
+
 	// ライブラリの終了
 	Novice::Finalize();
 	return 0;